@@ -0,0 +1,170 @@
+// ambient_light.c
+#include "ambient_light.h"
+#include "main.h"
+
+#if AMBIENT_LIGHT_FITTED
+
+extern ADC_HandleTypeDef hadc1;
+
+// ----------------- 설정 -----------------
+#define AMBIENT_BUF_LEN          8u      // DMA 순환 버퍼 (10 Hz → 0.8초 창, 중앙값)
+#define AMBIENT_PERIOD_MS        100u
+#define AMBIENT_RAW_MIN          4u      // 이 아래/위로 붙어 있으면 단선/단락으로 판단
+#define AMBIENT_RAW_MAX          4090u
+#define AMBIENT_BAD_LIMIT        30u     // 3초 연속 이상하면 invalid
+#define AMBIENT_GOOD_LIMIT       10u     // 1초 연속 정상이면 다시 valid
+#define AMBIENT_IIR_SHIFT        3u      // log 영역 1차 IIR, alpha = 1/8
+#define AMBIENT_IIR_SHIFT_FAST   1u      // valid 되기 전 (시작/복구 직후 빨리 수렴), alpha = 1/2
+#define AMBIENT_HYST_Q8          64u     // 1/4 옥타브 이상 움직여야 출력 갱신
+#define AMBIENT_HYST_DWELL       3u      // 그 상태로 300 ms 연속이어야 (잡음 한 번에 넘지 않게)
+
+// ----------------- 상태 -----------------
+static volatile uint16_t s_adc_buf[AMBIENT_BUF_LEN];
+
+static int32_t  s_filt_q8    = -1;     // 필터 상태 (-1 = 아직 없음)
+static uint16_t s_out_q8     = 0u;
+static uint8_t  s_valid      = 0u;
+static uint8_t  s_bad_count  = 0u;
+static uint8_t  s_good_count = 0u;
+static uint8_t  s_hyst_count = 0u;
+static uint32_t s_last_ms    = 0u;
+
+// log2(x) Q8 근사 (정수부 = 최상위 비트, 소수부 = 가수 선형 보간, 오차 < 0.09)
+static uint16_t ambient_log2_q8(uint32_t x)
+{
+    if (x == 0u) {
+        return 0u;
+    }
+
+    uint32_t msb  = 31u - __CLZ(x);
+    uint32_t frac = (msb >= 8u) ? (x >> (msb - 8u)) : (x << (8u - msb));
+
+    return (uint16_t)((msb << 8) + (frac & 0xFFu));
+}
+
+// 순환 버퍼의 중앙값 (가운데 두 값 평균)
+//  - 평균을 쓰면 가로등/마주 오는 전조등 같은 짧은 펄스(창의 절반 미만)가 그대로 섞여
+//    펄스마다 출력이 오르내림 → 중앙값이면 400 ms 미만 펄스는 무시됨
+static uint32_t ambient_median_raw(void)
+{
+    uint16_t v[AMBIENT_BUF_LEN];
+
+    // 삽입 정렬 (8개라 충분), DMA가 도중에 한 칸 바꿔도 결과만 한 샘플 늦을 뿐
+    for (uint8_t i = 0u; i < AMBIENT_BUF_LEN; ++i) {
+        uint16_t x = s_adc_buf[i];
+        uint8_t  j = i;
+        while ((j > 0u) && (v[j - 1u] > x)) {
+            v[j] = v[j - 1u];
+            j--;
+        }
+        v[j] = x;
+    }
+
+    return ((uint32_t)v[(AMBIENT_BUF_LEN / 2u) - 1u] + v[AMBIENT_BUF_LEN / 2u]) / 2u;
+}
+
+void AmbientLight_Init(void)
+{
+    s_filt_q8    = -1;
+    s_valid      = 0u;
+    s_bad_count  = 0u;
+    s_good_count = 0u;
+    s_hyst_count = 0u;
+
+    // TIM3 update(100 ms)마다 1회 변환, DMA가 버퍼를 돌며 채움
+    HAL_ADC_Start_DMA(&hadc1, (uint32_t *)s_adc_buf, AMBIENT_BUF_LEN);
+}
+
+bool AmbientLight_Process(uint32_t now_ms)
+{
+    if ((now_ms - s_last_ms) < AMBIENT_PERIOD_MS) {
+        return false;
+    }
+    s_last_ms = now_ms;
+
+    uint32_t raw = ambient_median_raw();
+
+    uint8_t prev_valid = s_valid;
+    uint16_t prev_out  = s_out_q8;
+
+    // 1) 타당성: 레일에 붙은 값은 센서 없음/단선
+    if (raw <= AMBIENT_RAW_MIN || raw >= AMBIENT_RAW_MAX) {
+        s_good_count = 0u;
+        if (s_bad_count < AMBIENT_BAD_LIMIT) {
+            s_bad_count++;
+        } else {
+            s_valid   = 0u;
+            s_filt_q8 = -1;
+        }
+        return (s_valid != prev_valid);
+    }
+
+    s_bad_count = 0u;
+    if (s_good_count < AMBIENT_GOOD_LIMIT) {
+        s_good_count++;
+    }
+
+    // 2) log 영역 IIR (빛은 곱셈적으로 변하므로 log에서 평균)
+    //    시작 직후엔 버퍼에 이전 값(0)이 섞여 있으므로 valid 전까지는 빠르게 따라감
+    int32_t x = (int32_t)ambient_log2_q8(raw);
+    if (s_filt_q8 < 0) {
+        s_filt_q8 = x;
+    } else {
+        s_filt_q8 += (x - s_filt_q8) >> (s_valid ? AMBIENT_IIR_SHIFT : AMBIENT_IIR_SHIFT_FAST);
+    }
+
+    // 3) 히스테리시스: 출력과 충분히, 충분히 오래 멀어졌을 때만 따라감
+    int32_t d = s_filt_q8 - (int32_t)s_out_q8;
+    if (!s_valid) {
+        s_out_q8     = (uint16_t)s_filt_q8;
+        s_hyst_count = 0u;
+    } else if (d > (int32_t)AMBIENT_HYST_Q8 || d < -(int32_t)AMBIENT_HYST_Q8) {
+        if (++s_hyst_count >= AMBIENT_HYST_DWELL) {
+            s_out_q8     = (uint16_t)s_filt_q8;
+            s_hyst_count = 0u;
+        }
+    } else {
+        s_hyst_count = 0u;
+    }
+
+    if (s_good_count >= AMBIENT_GOOD_LIMIT) {
+        s_valid = 1u;
+    }
+
+    return (s_valid != prev_valid) || (s_valid && s_out_q8 != prev_out);
+}
+
+bool AmbientLight_IsValid(void)
+{
+    return (s_valid != 0u);
+}
+
+uint16_t AmbientLight_GetLog2Q8(void)
+{
+    return s_out_q8;
+}
+
+#else  // !AMBIENT_LIGHT_FITTED
+
+// 센서 없는 빌드: 항상 invalid → 일출/일몰 모델만 사용
+void AmbientLight_Init(void)
+{
+}
+
+bool AmbientLight_Process(uint32_t now_ms)
+{
+    (void)now_ms;
+    return false;
+}
+
+bool AmbientLight_IsValid(void)
+{
+    return false;
+}
+
+uint16_t AmbientLight_GetLog2Q8(void)
+{
+    return 0u;
+}
+
+#endif // AMBIENT_LIGHT_FITTED
@@ -0,0 +1,43 @@
+/*
+ * ambient_light.h
+ *
+ *  주변광 센서 (ADC1_IN1 / PA1, TIM3 TRGO 10 Hz 트리거 + DMA 순환 버퍼)
+ *  - 배선: 밝을수록 ADC 값이 커지는 분압 (LDR 또는 포토트랜지스터를 VDD 쪽에)
+ *  - 0.8초 창 중앙값 → log2 영역 IIR 필터 + 히스테리시스 → 터널/주차장 진입 시 1초 안팎으로 반응,
+ *    가로등 밑을 지나가는 정도로는 출렁이지 않음
+ *  - 센서가 없거나(AMBIENT_LIGHT_FITTED 0) 값이 레일에 붙어 있으면 invalid
+ *    → app_display는 일출/일몰 모델로 돌아간다.
+ */
+
+#ifndef INC_AMBIENT_LIGHT_H_
+#define INC_AMBIENT_LIGHT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 센서 장착 여부. 빌드 옵션으로 덮어쓸 수 있음 (기본: 미장착)
+#ifndef AMBIENT_LIGHT_FITTED
+#define AMBIENT_LIGHT_FITTED   0
+#endif
+
+// log2(ADC raw) Q8 기준값 (raw 4095 ≈ 12.0 → 3072)
+#define AMBIENT_LOG2_ONE       256u
+
+void AmbientLight_Init(void);
+
+// 메인 루프에서 계속 호출 (내부에서 100 ms 간격으로만 처리)
+// 출력 밝기(히스테리시스 후)나 유효 여부가 바뀌었으면 true
+bool AmbientLight_Process(uint32_t now_ms);
+
+bool     AmbientLight_IsValid(void);
+uint16_t AmbientLight_GetLog2Q8(void);   // 히스테리시스 적용된 log2(raw) Q8
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_AMBIENT_LIGHT_H_ */
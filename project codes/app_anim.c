@@ -0,0 +1,442 @@
+// app_anim.c
+#include "app_anim.h"
+#include <string.h>
+
+#include <buzzer.h>
+#include <max7219.h>
+#include "disp_bright.h"
+
+// ----------------- 연출 큐 -----------------
+// 한 번에 하나만 화면에 나오고, 나머지는 순서대로 대기한다.
+// (예: 뱅크 라벨 0.6초 → 모드 타이틀 스크롤)
+typedef struct
+{
+    app_anim_kind_t    kind;
+    char               text[APP_ANIM_TEXT_MAX + 1u];
+    uint8_t            start;       // 표시 범위 (COUNTDOWN은 숫자 자리)
+    uint8_t            end;
+    uint8_t            dir;         // MAX7219_ScrollDir
+    uint8_t            bounce;      // FADE: 목표 도달 후 되돌아오기
+    uint8_t            phase;       // BLINK: on/off, FADE: 0=가는 중 1=돌아오는 중
+    uint8_t            started;
+    uint32_t           step_ms;
+    uint32_t           hold_ms;     // SCROLL: 딱 들어왔을 때 정지, TEXT: 표시 시간
+    int16_t            pos;         // SCROLL offset / COUNTDOWN 숫자 / FADE 밝기 / BLINK 남은 토글
+    int16_t            target;      // SCROLL 마지막 offset / FADE 목표 밝기
+    int16_t            origin;      // FADE 시작 밝기
+    int8_t             delta;       // +1 / -1
+    uint32_t           next_ms;     // 다음 단계 시각
+    app_anim_done_cb_t on_done;
+} app_anim_t;
+
+static app_anim_t s_anim_queue[APP_ANIM_QUEUE_LEN];
+static uint8_t    s_anim_head  = 0u;
+static uint8_t    s_anim_count = 0u;
+
+
+static app_anim_t *anim_current(void)
+{
+    return (s_anim_count > 0u) ? &s_anim_queue[s_anim_head] : NULL;
+}
+
+static app_anim_t *anim_push(app_anim_kind_t kind)
+{
+    if (s_anim_count >= APP_ANIM_QUEUE_LEN) {
+        return NULL;   // 큐가 차면 새 연출은 버림 (화면 갱신이 우선)
+    }
+
+    uint8_t idx = (uint8_t)((s_anim_head + s_anim_count) % APP_ANIM_QUEUE_LEN);
+    app_anim_t *a = &s_anim_queue[idx];
+
+    memset(a, 0, sizeof(*a));
+    a->kind  = kind;
+    a->delta = 1;
+    s_anim_count++;
+    return a;
+}
+
+static void anim_pop(void)
+{
+    if (s_anim_count == 0u) {
+        return;
+    }
+    s_anim_queue[s_anim_head].kind = APP_ANIM_NONE;
+    s_anim_head = (uint8_t)((s_anim_head + 1u) % APP_ANIM_QUEUE_LEN);
+    s_anim_count--;
+}
+
+static void anim_copy_text(app_anim_t *a, const char *text)
+{
+    if (text == NULL) {
+        a->text[0] = '\0';
+        return;
+    }
+    strncpy(a->text, text, APP_ANIM_TEXT_MAX);
+    a->text[APP_ANIM_TEXT_MAX] = '\0';
+}
+
+static void anim_set_range(app_anim_t *a, uint8_t start, uint8_t end)
+{
+    if (start > end) {
+        uint8_t tmp = start;
+        start = end;
+        end = tmp;
+    }
+    if (end >= NUMBER_OF_DIGITS) {
+        end = NUMBER_OF_DIGITS - 1;
+    }
+    a->start = start;
+    a->end   = end;
+}
+
+// 스크롤에서 hold_ms 만큼 멈추는 offset (텍스트가 창에 딱 들어온 위치)
+static int16_t scroll_hold_offset(const app_anim_t *a)
+{
+    return (a->dir == MAX7219_SCROLL_LEFT) ? 0 : (int16_t)strlen(a->text);
+}
+
+static uint32_t scroll_frame_ms(const app_anim_t *a)
+{
+    uint32_t ms = a->step_ms;
+    if (a->hold_ms > 0u && a->pos == scroll_hold_offset(a)) {
+        ms += a->hold_ms;
+    }
+    return ms;
+}
+
+
+// 큐 맨 앞 연출을 실제로 시작 (첫 프레임 상태 + 첫 비프 등)
+static void anim_begin(app_anim_t *a, uint32_t now_ms)
+{
+    a->started = 1u;
+
+    switch (a->kind) {
+    case APP_ANIM_SCROLL:
+    {
+        int16_t width = (int16_t)(a->end - a->start + 1u);
+        int16_t len   = (int16_t)strlen(a->text);
+
+        if (a->dir == MAX7219_SCROLL_LEFT) {
+            a->pos    = (int16_t)-width;
+            a->target = len;
+            a->delta  = 1;
+        } else {
+            a->pos    = len;
+            a->target = (int16_t)-width;
+            a->delta  = -1;
+        }
+        a->next_ms = now_ms + scroll_frame_ms(a);
+        break;
+    }
+
+    case APP_ANIM_TEXT:
+        a->next_ms = now_ms + a->hold_ms;
+        break;
+
+    case APP_ANIM_BLINK:
+        a->phase   = 1u;
+        a->next_ms = now_ms + a->step_ms;
+        break;
+
+    case APP_ANIM_COUNTDOWN:
+        // 낮은 비프음
+        Buzzer_PlaySequence(BEEP_SEQ_USER2);
+        a->next_ms = now_ms + a->step_ms;
+        break;
+
+    case APP_ANIM_FADE:
+        a->pos     = a->origin;
+        a->delta   = (a->target >= a->origin) ? 1 : -1;
+        DispBright_SetImmediate(DISP_BRIGHT_FROM_INTENSITY((uint16_t)a->pos));
+        a->next_ms = now_ms + a->step_ms;
+        break;
+
+    default:
+        a->next_ms = now_ms;
+        break;
+    }
+}
+
+// 한 단계 진행. 끝났으면 false
+static bool anim_advance(app_anim_t *a, uint32_t now_ms)
+{
+    switch (a->kind) {
+    case APP_ANIM_SCROLL:
+        if (a->pos == a->target) {
+            return false;
+        }
+        a->pos     = (int16_t)(a->pos + a->delta);
+        a->next_ms = now_ms + scroll_frame_ms(a);
+        return true;
+
+    case APP_ANIM_BLINK:
+        if (a->pos == 0) {
+            return false;
+        }
+        a->pos--;
+        a->phase   = (uint8_t)!a->phase;
+        a->next_ms = now_ms + a->step_ms;
+        return true;
+
+    case APP_ANIM_COUNTDOWN:
+        if (a->pos == 0) {
+            return false;   // GO! 표시 끝
+        }
+        a->pos--;
+        if (a->pos > 0) {
+            Buzzer_PlaySequence(BEEP_SEQ_USER2);
+        } else {
+            // GO! + 높은 비프음
+            Buzzer_PlaySequence(BEEP_SEQ_USER8);
+        }
+        a->next_ms = now_ms + a->step_ms;
+        return true;
+
+    case APP_ANIM_FADE:
+        if (a->pos == a->target) {
+            if (!a->bounce || a->phase != 0u) {
+                return false;
+            }
+            // 되돌아오기: 꼭짓점 밝기를 한 단계 더 유지한 뒤 반대로
+            a->phase  = 1u;
+            a->target = a->origin;
+            a->delta  = (int8_t)-a->delta;
+        } else {
+            a->pos = (int16_t)(a->pos + a->delta);
+        }
+        DispBright_SetImmediate(DISP_BRIGHT_FROM_INTENSITY((uint16_t)a->pos));
+        a->next_ms = now_ms + a->step_ms;
+        return true;
+
+    case APP_ANIM_TEXT:
+    default:
+        return false;
+    }
+}
+
+
+// ----------------- 외부 API -----------------
+
+void APP_Anim_Init(void)
+{
+    memset(s_anim_queue, 0, sizeof(s_anim_queue));
+    s_anim_head  = 0u;
+    s_anim_count = 0u;
+}
+
+bool APP_Anim_StartScroll(const char *text,
+                          uint8_t start,
+                          uint8_t end,
+                          MAX7219_ScrollDir dir,
+                          uint32_t step_ms,
+                          uint32_t hold_ms)
+{
+    if (text == NULL || text[0] == '\0') {
+        return false;
+    }
+
+    app_anim_t *a = anim_push(APP_ANIM_SCROLL);
+    if (a == NULL) {
+        return false;
+    }
+
+    anim_copy_text(a, text);
+    anim_set_range(a, start, end);
+    a->dir     = (uint8_t)dir;
+    a->step_ms = step_ms;
+    a->hold_ms = hold_ms;
+    return true;
+}
+
+bool APP_Anim_StartText(const char *text,
+                        uint8_t start,
+                        uint8_t end,
+                        uint32_t hold_ms)
+{
+    app_anim_t *a = anim_push(APP_ANIM_TEXT);
+    if (a == NULL) {
+        return false;
+    }
+
+    anim_copy_text(a, text);
+    anim_set_range(a, start, end);
+    a->hold_ms = hold_ms;
+    return true;
+}
+
+bool APP_Anim_StartBlink(const char *text,
+                         uint8_t start,
+                         uint8_t end,
+                         uint32_t half_period_ms,
+                         uint8_t count)
+{
+    if (count == 0u) {
+        return false;
+    }
+
+    app_anim_t *a = anim_push(APP_ANIM_BLINK);
+    if (a == NULL) {
+        return false;
+    }
+
+    anim_copy_text(a, text);
+    anim_set_range(a, start, end);
+    a->step_ms = half_period_ms;
+    a->pos     = (int16_t)(count * 2u - 1u);   // on/off 토글 횟수
+    return true;
+}
+
+bool APP_Anim_StartCountdown(uint8_t from,
+                             uint8_t pos,
+                             uint32_t step_ms,
+                             app_anim_done_cb_t on_done)
+{
+    if (from == 0u) {
+        return false;
+    }
+    if (from > 9u) {
+        from = 9u;          // 한 자리만 사용
+    }
+    if (pos < 1u) {
+        pos = 1u;           // "GO!"가 pos-1 ~ pos+1 에 들어가야 함
+    } else if (pos > NUMBER_OF_DIGITS - 2) {
+        pos = NUMBER_OF_DIGITS - 2;
+    }
+
+    app_anim_t *a = anim_push(APP_ANIM_COUNTDOWN);
+    if (a == NULL) {
+        return false;
+    }
+
+    a->start   = pos;
+    a->end     = pos;
+    a->pos     = (int16_t)from;
+    a->step_ms = step_ms;
+    a->on_done = on_done;
+    return true;
+}
+
+bool APP_Anim_StartFade(const char *text,
+                        uint8_t from,
+                        uint8_t to,
+                        uint32_t step_ms,
+                        bool bounce,
+                        app_anim_done_cb_t on_done)
+{
+    app_anim_t *a = anim_push(APP_ANIM_FADE);
+    if (a == NULL) {
+        return false;
+    }
+
+    anim_copy_text(a, text);
+    anim_set_range(a, 0u, NUMBER_OF_DIGITS - 1);
+    a->origin  = (int16_t)(from & 0x0Fu);
+    a->target  = (int16_t)(to & 0x0Fu);
+    a->bounce  = bounce ? 1u : 0u;
+    a->step_ms = step_ms;
+    a->on_done = on_done;
+    return true;
+}
+
+void APP_Anim_Cancel(void)
+{
+    APP_Anim_Init();
+}
+
+void APP_Anim_CancelKind(app_anim_kind_t kind)
+{
+    // 순서를 유지한 채 해당 종류만 빼고 다시 채움
+    app_anim_t keep[APP_ANIM_QUEUE_LEN];
+    uint8_t    n = 0u;
+
+    for (uint8_t i = 0u; i < s_anim_count; ++i) {
+        const app_anim_t *a = &s_anim_queue[(s_anim_head + i) % APP_ANIM_QUEUE_LEN];
+        if (a->kind != kind) {
+            keep[n++] = *a;
+        }
+    }
+
+    APP_Anim_Init();
+    for (uint8_t i = 0u; i < n; ++i) {
+        s_anim_queue[i] = keep[i];
+    }
+    s_anim_count = n;
+}
+
+bool APP_Anim_IsActive(void)
+{
+    return (s_anim_count > 0u);
+}
+
+bool APP_Anim_Poll(uint32_t now_ms)
+{
+    bool changed = false;
+
+    while (s_anim_count > 0u) {
+        app_anim_t *a = anim_current();
+
+        if (!a->started) {
+            anim_begin(a, now_ms);
+            changed = true;
+        }
+
+        if ((int32_t)(now_ms - a->next_ms) < 0) {
+            break;   // 아직 다음 단계 시각 전
+        }
+
+        if (anim_advance(a, now_ms)) {
+            changed = true;
+            break;
+        }
+
+        // 끝난 연출 정리 → 콜백 → 다음 연출 바로 시작
+        app_anim_done_cb_t cb = a->on_done;
+        anim_pop();
+        changed = true;
+
+        if (cb != NULL) {
+            cb();
+        }
+    }
+
+    return changed;
+}
+
+void APP_Anim_Render(void)
+{
+    const app_anim_t *a = anim_current();
+    if (a == NULL || !a->started) {
+        return;
+    }
+
+    switch (a->kind) {
+    case APP_ANIM_SCROLL:
+        max7219_WriteScrollFrame(a->text, a->start, a->end,
+                                 (MAX7219_ScrollDir)a->dir, a->pos);
+        break;
+
+    case APP_ANIM_TEXT:
+    case APP_ANIM_FADE:
+        max7219_WriteStringInRange(a->text, a->start, a->end, false);
+        break;
+
+    case APP_ANIM_BLINK:
+        if (a->phase) {
+            max7219_WriteStringInRange(a->text, a->start, a->end, false);
+        }
+        break;
+
+    case APP_ANIM_COUNTDOWN:
+        if (a->pos > 0) {
+            max7219_WriteCharAt(a->start, (char)('0' + a->pos), false);
+        } else {
+            max7219_WriteCharAt(a->start - 1u, 'G', false);
+            max7219_WriteCharAt(a->start,      'O', false);
+            max7219_WriteCharAt(a->start + 1u, '!', false);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * app_anim.h
+ *
+ *  논블로킹 화면 연출 (스크롤 / 라벨 / 카운트다운 / 밝기 페이드 / 블링크)
+ *  - HAL_Delay 없이 APP_Anim_Poll()을 메인 루프(프레임 스케줄러)에서 계속 불러주면
+ *    시간에 맞춰 한 단계씩 진행된다.
+ *  - 실제 그리기는 APP_Anim_Render()가 max7219 프레임 안에서 담당.
+ */
+
+#ifndef INC_APP_ANIM_H_
+#define INC_APP_ANIM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "max7219.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define APP_ANIM_QUEUE_LEN   4u    // 동시에 예약 가능한 연출 개수 (라벨 → 스크롤 등)
+#define APP_ANIM_TEXT_MAX    16u   // 연출 텍스트 최대 길이
+
+typedef enum {
+    APP_ANIM_NONE = 0,
+    APP_ANIM_SCROLL,      // 텍스트 흘리기 (max7219_ScrollText의 논블로킹 버전)
+    APP_ANIM_TEXT,        // 고정 텍스트 잠깐 표시 (뱅크 라벨 등)
+    APP_ANIM_BLINK,       // 고정 텍스트 on/off 깜빡임
+    APP_ANIM_COUNTDOWN,   // N..1 → GO! + 단계별 비프
+    APP_ANIM_FADE         // 고정 텍스트 + 밝기 스윕
+} app_anim_kind_t;
+
+// 연출이 끝났을 때(취소 제외) 1회 호출
+typedef void (*app_anim_done_cb_t)(void);
+
+void APP_Anim_Init(void);
+
+bool APP_Anim_StartScroll(const char *text,
+                          uint8_t start,
+                          uint8_t end,
+                          MAX7219_ScrollDir dir,
+                          uint32_t step_ms,
+                          uint32_t hold_ms);
+
+bool APP_Anim_StartText(const char *text,
+                        uint8_t start,
+                        uint8_t end,
+                        uint32_t hold_ms);
+
+bool APP_Anim_StartBlink(const char *text,
+                         uint8_t start,
+                         uint8_t end,
+                         uint32_t half_period_ms,
+                         uint8_t count);
+
+// from..1 을 pos 자리에 보여준 뒤 "GO!" → on_done 호출
+bool APP_Anim_StartCountdown(uint8_t from,
+                             uint8_t pos,
+                             uint32_t step_ms,
+                             app_anim_done_cb_t on_done);
+
+// 텍스트를 띄운 채 밝기를 from → to (bounce면 다시 from까지) 스윕
+bool APP_Anim_StartFade(const char *text,
+                        uint8_t from,
+                        uint8_t to,
+                        uint32_t step_ms,
+                        bool bounce,
+                        app_anim_done_cb_t on_done);
+
+void APP_Anim_Cancel(void);                       // 전부 취소
+void APP_Anim_CancelKind(app_anim_kind_t kind);   // 해당 종류만 취소
+
+bool APP_Anim_IsActive(void);
+
+// 시간 진행. 화면 내용이 바뀌었으면 true (→ 프레임 요청)
+bool APP_Anim_Poll(uint32_t now_ms);
+
+// 현재 연출 한 프레임을 프레임버퍼에 그림 (max7219_FrameBegin/End 사이에서 호출)
+void APP_Anim_Render(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_APP_ANIM_H_ */
@@ -0,0 +1,26 @@
+// boot_time.c
+#include "boot_time.h"
+#include "main.h"
+
+static uint32_t s_boot_ms[BOOT_MS_COUNT];
+static uint32_t s_boot_reached = 0u;   // bit m = 마일스톤 m 도달
+
+void BootTime_Mark(boot_milestone_t m)
+{
+    if (m >= BOOT_MS_COUNT || (s_boot_reached & (1u << m)) != 0u) {
+        return;
+    }
+    s_boot_ms[m]    = HAL_GetTick();
+    s_boot_reached |= (1u << m);
+}
+
+bool BootTime_Get(boot_milestone_t m, uint32_t *out_ms)
+{
+    if (m >= BOOT_MS_COUNT || (s_boot_reached & (1u << m)) == 0u) {
+        return false;
+    }
+    if (out_ms != NULL) {
+        *out_ms = s_boot_ms[m];
+    }
+    return true;
+}
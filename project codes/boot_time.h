@@ -0,0 +1,42 @@
+/*
+ * boot_time.h
+ *
+ *  부팅 마일스톤 타임스탬프 (HAL_GetTick 기준, 리셋 = 0 ms)
+ *  - 각 마일스톤은 처음 도달했을 때 한 번만 기록
+ *  - "전원 → 주행 화면"(BOOT_MS_FIRST_FRAME)이 추적 지표. 목표 1초 미만
+ */
+
+#ifndef INC_BOOT_TIME_H_
+#define INC_BOOT_TIME_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum
+{
+    BOOT_MS_PERIPH = 0,     // 클럭 + MX_*_Init 끝
+    BOOT_MS_DISPLAY,        // MAX7219 / 밝기 엔진 준비
+    BOOT_MS_SETTINGS,       // 플래시 설정 로드 + 적용
+    BOOT_MS_SCHED_START,    // 메인 루프(스케줄러) 진입
+    BOOT_MS_FIRST_FRAME,    // 주행 화면 첫 프레임
+    BOOT_MS_KEY_WINDOW,     // 설정 진입 키 창 닫힘
+    BOOT_MS_GPS_CONFIG,     // 수신기 설정 완료 (UART RX 시작)
+    BOOT_MS_BOOT_DONE,      // 부팅 태스크 종료 (FULL 클럭 해제)
+    BOOT_MS_FIRST_FIX,      // 첫 유효 fix
+    BOOT_MS_COUNT
+} boot_milestone_t;
+
+void BootTime_Mark(boot_milestone_t m);
+
+// 도달했으면 true + 리셋 후 ms
+bool BootTime_Get(boot_milestone_t m, uint32_t *out_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_BOOT_TIME_H_ */
@@ -0,0 +1,321 @@
+// clock_profile.c
+#include "clock_profile.h"
+#include "main.h"
+#include "sched.h"
+#include "max7219.h"
+#include "gps_ubx.h"
+
+extern TIM_HandleTypeDef htim3;
+extern TIM_HandleTypeDef htim4;
+extern TIM_HandleTypeDef htim5;
+
+// ----------------- 설정 -----------------
+#define CLOCK_PROFILE_STEADY_DEFAULT  CLOCK_PROFILE_MID
+#define CLOCK_UART_QUIET_MS           2u     // 전환은 GPS 버스트 사이에서
+#define CLOCK_UART_QUIET_MAX_WAIT_MS  60u    // 2 Hz epoch 버스트 하나보다 조금 길게
+
+typedef struct
+{
+    uint32_t sysclk_hz;      // 코어(HCLK) 클럭 = DWT 카운터 속도
+    uint32_t pll_n;          // 0 = PLL 안 씀 (HSI 16 MHz 직결)
+    uint32_t pll_p;          // RCC_PLLP_DIVx
+    uint32_t ahb_div;        // RCC_SYSCLK_DIVx
+    uint32_t apb1_div;       // APB1 최대 50 MHz
+    uint32_t vos;            // PWR_REGULATOR_VOLTAGE_SCALEx (scale 3은 64 MHz까지)
+    uint32_t flash_latency;  // 2.7~3.6 V 기준 대기 사이클
+} clock_profile_desc_t;
+
+// PLL 입력 = HSI / 8 = 2 MHz, VCO = 2 MHz * N, USB 클럭 = VCO / 4
+#if CLOCK_USB_48MHZ
+#define CLOCK_PLL_N     96u
+#else
+#define CLOCK_PLL_N     100u
+#endif
+#define CLOCK_VCO_HZ    (2000000u * CLOCK_PLL_N)
+
+// USB 빌드: MID는 PLL/VOS1을 FULL 그대로 두고 AHB /2 → FULL↔MID 전환에 PLL이 안 꺼져서
+// USB 48 MHz(PLL Q)가 유지됨 (VOS3 절전은 포기, 전환 중 CDC 링크가 끊기는 것보다 나음)
+static const clock_profile_desc_t s_profiles[CLOCK_PROFILE_COUNT] =
+{
+    [CLOCK_PROFILE_FULL] = { CLOCK_VCO_HZ / 2u, CLOCK_PLL_N, RCC_PLLP_DIV2, RCC_SYSCLK_DIV1, RCC_HCLK_DIV2,
+                             PWR_REGULATOR_VOLTAGE_SCALE1, FLASH_LATENCY_3 },
+#if CLOCK_USB_48MHZ
+    [CLOCK_PROFILE_MID]  = { CLOCK_VCO_HZ / 4u, CLOCK_PLL_N, RCC_PLLP_DIV2, RCC_SYSCLK_DIV2, RCC_HCLK_DIV1,
+                             PWR_REGULATOR_VOLTAGE_SCALE1, FLASH_LATENCY_1 },
+#else
+    [CLOCK_PROFILE_MID]  = { CLOCK_VCO_HZ / 4u, CLOCK_PLL_N, RCC_PLLP_DIV4, RCC_SYSCLK_DIV1, RCC_HCLK_DIV1,
+                             PWR_REGULATOR_VOLTAGE_SCALE3, FLASH_LATENCY_1 },
+#endif
+    [CLOCK_PROFILE_LOW]  = {  16000000u,   0u, 0u,            RCC_SYSCLK_DIV1, RCC_HCLK_DIV1,
+                             PWR_REGULATOR_VOLTAGE_SCALE3, FLASH_LATENCY_0 },
+};
+
+// ----------------- 상태 -----------------
+static clock_profile_t s_current       = CLOCK_PROFILE_FULL;
+static clock_profile_t s_steady        = CLOCK_PROFILE_STEADY_DEFAULT;
+static uint8_t         s_full_requests = 0u;
+
+// 타이머 틱 주파수 (CubeMX 분주값에서 한 번 뽑아 두고, 프로파일이 바뀌어도 유지)
+static uint32_t s_tim3_tick_hz = 0u;
+static uint32_t s_tim4_tick_hz = 0u;
+static uint32_t s_tim5_tick_hz = 0u;
+
+// 사용률 측정
+static clock_util_t    s_util[CLOCK_PROFILE_COUNT];
+static clock_profile_t s_meas_profile  = CLOCK_PROFILE_FULL;
+static uint32_t        s_meas_last_ms  = 0u;
+static uint32_t        s_meas_overruns = 0u;
+static uint8_t         s_meas_mixed    = 0u;   // 창 도중에 프로파일이 바뀜
+#if CLOCK_PROFILE_MEASURE
+static uint32_t        s_dwell_start_ms = 0u;
+#endif
+
+// ----------------- RCC -----------------
+// APB1 분주가 1이 아니면 APB1 타이머 클럭은 PCLK1 x2
+static uint32_t clock_apb1_timer_hz(void)
+{
+    uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+    return ((RCC->CFGR & RCC_CFGR_PPRE1) == RCC_HCLK_DIV1) ? pclk1 : (pclk1 * 2u);
+}
+
+// 두 프로파일이 같은 PLL 출력 / VOS를 쓰는지 (그러면 버스 분주만 바꾸면 됨)
+static bool clock_same_pll(const clock_profile_desc_t *a, const clock_profile_desc_t *b)
+{
+    return (a->pll_n != 0u) && (a->pll_n == b->pll_n) && (a->pll_p == b->pll_p) && (a->vos == b->vos);
+}
+
+// PLL은 그대로 돌리면서 AHB/APB 분주와 플래시 대기만 (HAL이 대기 사이클 순서를 맞춰 줌)
+static bool clock_apply_dividers(const clock_profile_desc_t *d)
+{
+    RCC_ClkInitTypeDef clk = {0};
+
+    clk.ClockType      = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK |
+                         RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+    clk.SYSCLKSource   = RCC_SYSCLKSOURCE_PLLCLK;
+    clk.AHBCLKDivider  = d->ahb_div;
+    clk.APB1CLKDivider = d->apb1_div;
+    clk.APB2CLKDivider = RCC_HCLK_DIV1;
+    return (HAL_RCC_ClockConfig(&clk, d->flash_latency) == HAL_OK);
+}
+
+// HSI로 먼저 내려온 다음 PLL/VOS를 바꾸고 다시 올라감
+// (VOS는 PLL이 꺼져 있을 때만 바꿀 수 있음)
+static bool clock_apply_rcc(const clock_profile_desc_t *d)
+{
+    RCC_OscInitTypeDef osc = {0};
+    RCC_ClkInitTypeDef clk = {0};
+
+    clk.ClockType      = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK |
+                         RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+    clk.SYSCLKSource   = RCC_SYSCLKSOURCE_HSI;
+    clk.AHBCLKDivider  = RCC_SYSCLK_DIV1;
+    clk.APB1CLKDivider = RCC_HCLK_DIV1;
+    clk.APB2CLKDivider = RCC_HCLK_DIV1;
+    if (HAL_RCC_ClockConfig(&clk, FLASH_LATENCY_0) != HAL_OK) {
+        return false;
+    }
+
+    osc.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+    osc.PLL.PLLState   = RCC_PLL_OFF;
+    if (HAL_RCC_OscConfig(&osc) != HAL_OK) {
+        return false;
+    }
+
+    __HAL_PWR_VOLTAGESCALING_CONFIG(d->vos);
+
+    if (d->pll_n == 0u) {
+        return true;
+    }
+
+    osc.PLL.PLLState  = RCC_PLL_ON;
+    osc.PLL.PLLSource = RCC_PLLSOURCE_HSI;
+    osc.PLL.PLLM      = 8;
+    osc.PLL.PLLN      = d->pll_n;
+    osc.PLL.PLLP      = d->pll_p;
+    osc.PLL.PLLQ      = 4;
+    if (HAL_RCC_OscConfig(&osc) != HAL_OK) {
+        return false;
+    }
+
+    return clock_apply_dividers(d);
+}
+
+// ----------------- 주변장치 -----------------
+// 새 분주비를 바로 적용 (URS=1이면 UG로는 업데이트 인터럽트가 안 남)
+static void clock_retune_timer(TIM_HandleTypeDef *htim, uint32_t tim_hz, uint32_t tick_hz)
+{
+    uint32_t psc = (tim_hz / tick_hz) - 1u;
+    uint32_t cr1 = htim->Instance->CR1;
+
+    htim->Init.Prescaler = psc;
+    htim->Instance->PSC  = psc;
+    htim->Instance->CR1  = cr1 | TIM_CR1_URS;
+    htim->Instance->EGR  = TIM_EGR_UG;
+    htim->Instance->CR1  = cr1;
+}
+
+static void clock_retune_peripherals(void)
+{
+    uint32_t pclk2  = HAL_RCC_GetPCLK2Freq();
+    uint32_t tim_hz = clock_apb1_timer_hz();
+
+    // HAL 틱(SysTick)은 HAL_RCC_ClockConfig 안에서 HAL_InitTick으로 이미 다시 맞춰짐
+    GPS_UART_HANDLE.Instance->BRR = UART_BRR_SAMPLING16(pclk2, GPS_UART_HANDLE.Init.BaudRate);
+    max7219_SetSpiClock(pclk2);
+
+    clock_retune_timer(&htim3, tim_hz, s_tim3_tick_hz);
+    clock_retune_timer(&htim4, tim_hz, s_tim4_tick_hz);
+    clock_retune_timer(&htim5, tim_hz, s_tim5_tick_hz);
+
+    Sched_OnClockChange();
+}
+
+// GPS 버스트 중간에 BRR이 바뀌면 그 메시지는 깨지므로 잠깐 조용해질 때까지
+static void clock_wait_uart_quiet(void)
+{
+    uint32_t t0 = HAL_GetTick();
+
+    while ((HAL_GetTick() - GPS_UBX_GetLastRxMs()) < CLOCK_UART_QUIET_MS &&
+           (HAL_GetTick() - t0) < CLOCK_UART_QUIET_MAX_WAIT_MS) {
+    }
+}
+
+static void clock_switch(clock_profile_t p)
+{
+    if (p == s_current) {
+        return;
+    }
+
+    clock_wait_uart_quiet();
+    HAL_NVIC_DisableIRQ(TIM5_IRQn);   // 전환 도중 밝기 ISR이 SPI를 새로 시작하지 않게
+
+    bool ok = clock_same_pll(&s_profiles[s_current], &s_profiles[p]) ? clock_apply_dividers(&s_profiles[p])
+                                                                     : clock_apply_rcc(&s_profiles[p]);
+    if (ok) {
+        s_current = p;
+    } else {
+        // 실패: 어디까지 갔든 FULL로 되돌려 놓고 그 클럭에 맞춤
+        (void)clock_apply_rcc(&s_profiles[CLOCK_PROFILE_FULL]);
+        s_current = CLOCK_PROFILE_FULL;
+    }
+    clock_retune_peripherals();
+
+    HAL_NVIC_EnableIRQ(TIM5_IRQn);
+    s_meas_mixed = 1u;
+}
+
+// ----------------- API -----------------
+void ClockProfile_Init(void)
+{
+    uint32_t tim_hz = clock_apb1_timer_hz();
+
+    s_tim3_tick_hz = tim_hz / (htim3.Init.Prescaler + 1u);
+    s_tim4_tick_hz = tim_hz / (htim4.Init.Prescaler + 1u);
+    s_tim5_tick_hz = tim_hz / (htim5.Init.Prescaler + 1u);
+
+#if CLOCK_USB_48MHZ
+    // SystemClock_Config(CubeMX)는 VCO 200 MHz → USB용 192 MHz로 한 번 다시
+    if (!clock_apply_rcc(&s_profiles[CLOCK_PROFILE_FULL])) {
+        Error_Handler();
+    }
+    clock_retune_peripherals();
+#endif
+
+    // 부팅 설정 구간은 FULL 요청 1건으로 시작 (main이 부팅 끝에서 ReleaseFull)
+    s_current       = CLOCK_PROFILE_FULL;
+    s_full_requests = 1u;
+    s_meas_profile  = CLOCK_PROFILE_FULL;
+    s_meas_last_ms  = HAL_GetTick();
+    s_meas_overruns = 0u;
+}
+
+void ClockProfile_SetSteady(clock_profile_t p)
+{
+    if (p >= CLOCK_PROFILE_COUNT) {
+        return;
+    }
+    s_steady = p;
+    if (s_full_requests == 0u) {
+        clock_switch(p);
+    }
+}
+
+clock_profile_t ClockProfile_GetSteady(void)
+{
+    return s_steady;
+}
+
+void ClockProfile_RequestFull(void)
+{
+    if (s_full_requests++ == 0u) {
+        clock_switch(CLOCK_PROFILE_FULL);
+    }
+}
+
+void ClockProfile_ReleaseFull(void)
+{
+    if (s_full_requests == 0u) {
+        return;
+    }
+    if (--s_full_requests == 0u) {
+        clock_switch(s_steady);
+    }
+}
+
+clock_profile_t ClockProfile_Get(void)
+{
+    return s_current;
+}
+
+uint32_t ClockProfile_GetSysclkHz(void)
+{
+    return s_profiles[s_current].sysclk_hz;
+}
+
+void ClockProfile_RestoreAfterStop(void)
+{
+    // APB 분주 레지스터는 STOP에서도 유지되므로 주변장치 분주는 그대로 맞음
+    (void)clock_apply_rcc(&s_profiles[s_current]);
+}
+
+void ClockProfile_Measure(uint32_t now_ms)
+{
+    uint32_t busy_us  = Sched_TakeBusyUs();
+    uint32_t overruns = Sched_GetTotalOverruns();
+    uint32_t wall_ms  = now_ms - s_meas_last_ms;
+
+    // 창 도중에 프로파일이 바뀌었으면 섞인 창이라 버림
+    if (!s_meas_mixed && s_meas_profile == s_current && wall_ms != 0u) {
+        clock_util_t *u  = &s_util[s_current];
+        uint32_t      pm = busy_us / wall_ms;   // us / ms = 1/1000
+
+        u->windows++;
+        u->busy_us  += busy_us;
+        u->wall_ms  += wall_ms;
+        u->overruns += overruns - s_meas_overruns;
+        u->util_permille = (uint16_t)(u->busy_us / u->wall_ms);
+        if (pm > u->peak_permille) {
+            u->peak_permille = (uint16_t)pm;
+        }
+    }
+
+    s_meas_last_ms  = now_ms;
+    s_meas_overruns = overruns;
+    s_meas_profile  = s_current;
+    s_meas_mixed    = 0u;
+
+#if CLOCK_PROFILE_MEASURE
+    if ((now_ms - s_dwell_start_ms) >= CLOCK_MEASURE_DWELL_MS) {
+        s_dwell_start_ms = now_ms;
+        ClockProfile_SetSteady((clock_profile_t)((s_steady + 1u) % CLOCK_PROFILE_COUNT));
+    }
+#endif
+}
+
+const clock_util_t *ClockProfile_GetUtil(clock_profile_t p)
+{
+    if (p >= CLOCK_PROFILE_COUNT) {
+        return NULL;
+    }
+    return &s_util[p];
+}
@@ -0,0 +1,81 @@
+/*
+ * clock_profile.h
+ *
+ *  런타임 SYSCLK 프로파일
+ *  - FULL : 100 MHz (HSI → PLL, CubeMX 설정 그대로)  부팅 설정 / 플래시 쓰기 / 셀프 테스트
+ *  - MID  :  50 MHz (PLL, VOS scale 3)               평상시 주행 기본값
+ *  - LOW  :  16 MHz (HSI 직결, PLL 끔, VOS scale 3)   주차 절전
+ *  - 전환할 때마다 UART BRR, SPI 분주, TIM3/4/5 분주(틱 주파수 유지), HAL 틱을 같이 맞춘다.
+ *  - FULL 요청은 중첩 가능 (RequestFull/ReleaseFull 짝). 요청이 다 풀리면 steady 프로파일로.
+ *  - CLOCK_PROFILE_MEASURE 1 빌드: 주행 중 steady 프로파일을 돌려 가며 프로파일별
+ *    CPU 사용률과 예산 초과 횟수를 모은다 (디버거 Live Expressions로 ClockProfile_GetUtil 확인).
+ */
+
+#ifndef INC_CLOCK_PROFILE_H_
+#define INC_CLOCK_PROFILE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CLOCK_PROFILE_MEASURE
+#define CLOCK_PROFILE_MEASURE   0
+#endif
+
+#define CLOCK_MEASURE_DWELL_MS  30000u   // 측정 모드에서 프로파일 하나에 머무는 시간
+
+// USB OTG FS(텔레메트리 CDC)는 PLL Q 출력이 정확히 48 MHz여야 함
+//  1이면 VCO 192 MHz → FULL 96 MHz, MID 48 MHz (같은 PLL에 AHB /2, VOS1), Q 48 MHz
+//  FULL↔MID는 분주만 바꾸므로 USB가 안 끊김 (LOW는 PLL을 끄므로 끊김)
+#ifndef CLOCK_USB_48MHZ
+#define CLOCK_USB_48MHZ         0
+#endif
+
+typedef enum
+{
+    CLOCK_PROFILE_FULL = 0,
+    CLOCK_PROFILE_MID,
+    CLOCK_PROFILE_LOW,
+    CLOCK_PROFILE_COUNT
+} clock_profile_t;
+
+// 프로파일별 사용률 통계 (1초 창 단위)
+typedef struct
+{
+    uint32_t windows;          // 모은 1초 창 수
+    uint64_t busy_us;          // 태스크 실행 시간 합
+    uint32_t wall_ms;          // 창 길이 합
+    uint16_t util_permille;    // 평균 사용률 (busy / wall)
+    uint16_t peak_permille;    // 가장 바빴던 1초 창
+    uint32_t overruns;         // 이 프로파일에서 늘어난 태스크 예산 초과
+} clock_util_t;
+
+// SystemClock_Config(= FULL) 직후 1회
+void ClockProfile_Init(void);
+
+// 평상시 프로파일 (FULL 요청이 없을 때 돌아갈 곳)
+void            ClockProfile_SetSteady(clock_profile_t p);
+clock_profile_t ClockProfile_GetSteady(void);
+
+void ClockProfile_RequestFull(void);
+void ClockProfile_ReleaseFull(void);
+
+clock_profile_t ClockProfile_Get(void);
+uint32_t        ClockProfile_GetSysclkHz(void);
+
+// STOP 모드에서 깬 뒤 (HSI 16 MHz, PLL 꺼짐) 현재 프로파일 RCC 설정만 다시
+void ClockProfile_RestoreAfterStop(void);
+
+// 1초마다 호출: 사용률 집계 (측정 모드면 프로파일 순환까지)
+void ClockProfile_Measure(uint32_t now_ms);
+
+const clock_util_t *ClockProfile_GetUtil(clock_profile_t p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_CLOCK_PROFILE_H_ */
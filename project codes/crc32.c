@@ -0,0 +1,97 @@
+// crc32.c
+#include "crc32.h"
+#include "main.h"
+#include <string.h>
+
+#define CRC32_POLY_REFLECTED  0xEDB88320u
+
+// ----------------- 소프트웨어 (slice-by-4) -----------------
+static uint32_t s_table[4][256];
+static uint8_t  s_table_ready = 0u;
+
+static void crc32_build_table(void)
+{
+    for (uint32_t i = 0u; i < 256u; ++i) {
+        uint32_t c = i;
+        for (uint32_t bit = 0u; bit < 8u; ++bit) {
+            c = (c & 1u) ? ((c >> 1) ^ CRC32_POLY_REFLECTED) : (c >> 1);
+        }
+        s_table[0][i] = c;
+    }
+    // table[k][i] = 바이트 i 뒤에 0 바이트 k개가 더 지나간 결과
+    for (uint32_t i = 0u; i < 256u; ++i) {
+        s_table[1][i] = (s_table[0][i] >> 8) ^ s_table[0][s_table[0][i] & 0xFFu];
+        s_table[2][i] = (s_table[1][i] >> 8) ^ s_table[0][s_table[1][i] & 0xFFu];
+        s_table[3][i] = (s_table[2][i] >> 8) ^ s_table[0][s_table[2][i] & 0xFFu];
+    }
+    s_table_ready = 1u;
+}
+
+// crc: 반사된 내부 상태 (최종 XOR 전)
+static uint32_t crc32_sw(uint32_t crc, const uint8_t *p, size_t len)
+{
+    if (!s_table_ready) {
+        crc32_build_table();
+    }
+
+    while (len >= 4u) {
+        uint32_t w;
+        memcpy(&w, p, 4u);   // 리틀 엔디안: p[0]이 하위 바이트
+        crc ^= w;
+        crc = s_table[3][crc & 0xFFu] ^
+              s_table[2][(crc >> 8) & 0xFFu] ^
+              s_table[1][(crc >> 16) & 0xFFu] ^
+              s_table[0][crc >> 24];
+        p   += 4u;
+        len -= 4u;
+    }
+    while (len-- != 0u) {
+        crc = (crc >> 8) ^ s_table[0][(crc ^ *p++) & 0xFFu];
+    }
+    return crc;
+}
+
+// ----------------- 하드웨어 CRC 유닛 -----------------
+#if CRC32_USE_HW
+static uint8_t s_hw_ready = 0u;
+
+// 유닛: 다항식 0x04C11DB7, 초기값 0xFFFFFFFF, 32비트 워드를 MSB부터
+// 리틀 엔디안 워드를 __RBIT 하면 p[0]의 bit0이 MSB로 와서 반사 CRC와 같은 순서가 됨
+static uint32_t crc32_hw(const uint8_t *p, size_t words)
+{
+    if (!s_hw_ready) {
+        __HAL_RCC_CRC_CLK_ENABLE();
+        s_hw_ready = 1u;
+    }
+
+    CRC->CR = CRC_CR_RESET;
+    while (words-- != 0u) {
+        uint32_t w;
+        memcpy(&w, p, 4u);
+        CRC->DR = __RBIT(w);
+        p += 4u;
+    }
+    return __RBIT(CRC->DR);   // 반사 상태로 되돌림 (최종 XOR 전)
+}
+#endif
+
+// ----------------- API -----------------
+uint32_t Crc32_Calc(const void *data, size_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+
+#if CRC32_USE_HW
+    size_t words = len / 4u;
+    if (words != 0u) {
+        uint32_t crc = crc32_hw(p, words);
+        // 4바이트로 안 떨어지는 꼬리만 소프트웨어
+        return ~crc32_sw(crc, p + (words * 4u), len - (words * 4u));
+    }
+#endif
+    return ~crc32_sw(0xFFFFFFFFu, p, len);
+}
+
+uint32_t Crc32_Update(uint32_t crc, const void *data, size_t len)
+{
+    return ~crc32_sw(~crc, (const uint8_t *)data, len);
+}
@@ -0,0 +1,38 @@
+/*
+ * crc32.h
+ *
+ *  CRC-32 (Ethernet/zlib: 반사 다항식 0xEDB88320, 초기값/최종 XOR 0xFFFFFFFF)
+ *  - 소프트웨어: slice-by-4 테이블 (4 KB, 처음 쓸 때 RAM에 만듦)
+ *  - CRC32_USE_HW 1: 4바이트 단위는 STM32F4 하드웨어 CRC 유닛으로.
+ *    유닛은 비반사(MSB first) CRC라서 입력/결과를 __RBIT으로 뒤집어 같은 값을 만든다
+ *    → 이미 플래시에 있는 레코드와 그대로 호환.
+ *  - 하드웨어 유닛은 하나뿐이고 초기값을 못 정하므로 Crc32_Calc만 하드웨어 경로,
+ *    이어 붙이기(Crc32_Update)는 항상 소프트웨어. 메인 컨텍스트에서만 호출.
+ */
+
+#ifndef INC_CRC32_H_
+#define INC_CRC32_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CRC32_USE_HW
+#define CRC32_USE_HW   1
+#endif
+
+// 한 번에 계산
+uint32_t Crc32_Calc(const void *data, size_t len);
+
+// 이어서 계산: crc = Crc32_Update(0, a, n); crc = Crc32_Update(crc, b, m); ...
+// (결과는 a+b를 한 번에 Crc32_Calc 한 것과 같음)
+uint32_t Crc32_Update(uint32_t crc, const void *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_CRC32_H_ */
@@ -0,0 +1,147 @@
+// disp_bright.c
+#include "disp_bright.h"
+#include <max7219.h>
+
+// ----------------- 상태 -----------------
+// 밝기는 level << 8 (Q8)로 들고 있어서 긴 페이드에서도 틱당 증가량이 0이 되지 않음
+static volatile uint32_t s_level_q8  = 0u;
+static volatile uint32_t s_target_q8 = 0u;
+static volatile uint32_t s_step_q8   = 0u;    // 틱당 변화량
+
+// 시그마-델타 누산기: frac/16 비율로 한 단계 위 코드를 섞는다
+static uint8_t s_dither_acc = 0u;
+
+// 마지막으로 내보낸 출력 코드 (0 = shutdown, k = INTENSITY k-1), 0xFF = 모름
+static volatile uint8_t s_out_code     = 0xFFu;
+static uint8_t          s_hw_intensity = 0xFFu;
+static uint8_t          s_hw_on        = 0xFFu;
+
+static uint32_t disp_bright_clamp_q8(uint16_t level)
+{
+    if (level > DISP_BRIGHT_MAX) {
+        level = DISP_BRIGHT_MAX;
+    }
+    return (uint32_t)level << 8;
+}
+
+// 코드 하나를 하드웨어에 반영. SPI가 사용 중이면 다음 틱에 다시
+static void disp_bright_output(uint8_t code)
+{
+    if (code == s_out_code) {
+        return;
+    }
+
+    if (code == 0u) {
+        if (s_hw_on != 0u) {
+            if (!max7219_TrySendDataFromISR(REG_SHUTDOWN, 0x00)) {
+                return;
+            }
+            s_hw_on = 0u;
+        }
+    } else {
+        uint8_t intensity = (uint8_t)(code - 1u);
+
+        // 인접 코드끼리는 레지스터 하나만 바뀜 (0↔1: SHUTDOWN, 나머지: INTENSITY)
+        if (s_hw_intensity != intensity) {
+            if (!max7219_TrySendDataFromISR(REG_INTENSITY, intensity)) {
+                return;
+            }
+            s_hw_intensity = intensity;
+        }
+        if (s_hw_on != 1u) {
+            if (!max7219_TrySendDataFromISR(REG_SHUTDOWN, 0x01)) {
+                return;
+            }
+            s_hw_on = 1u;
+        }
+    }
+
+    s_out_code = code;
+}
+
+// ----------------- API -----------------
+void DispBright_Init(uint16_t level)
+{
+    __disable_irq();
+    s_level_q8   = disp_bright_clamp_q8(level);
+    s_target_q8  = s_level_q8;
+    s_step_q8    = 0u;
+    s_dither_acc = 0u;
+    s_out_code     = 0xFFu;
+    s_hw_intensity = 0xFFu;
+    s_hw_on        = 0xFFu;
+    __enable_irq();
+}
+
+void DispBright_SetTarget(uint16_t level, uint32_t fade_ms)
+{
+    uint32_t target = disp_bright_clamp_q8(level);
+
+    __disable_irq();
+    uint32_t cur = s_level_q8;
+    uint32_t diff = (target > cur) ? (target - cur) : (cur - target);
+    uint32_t ticks = (fade_ms * DISP_BRIGHT_TICK_HZ) / 1000u;
+
+    if (ticks == 0u || diff == 0u) {
+        s_level_q8 = target;
+        s_step_q8  = 0u;
+    } else {
+        s_step_q8 = diff / ticks;
+        if (s_step_q8 == 0u) {
+            s_step_q8 = 1u;
+        }
+    }
+    s_target_q8 = target;
+    __enable_irq();
+}
+
+void DispBright_SetImmediate(uint16_t level)
+{
+    DispBright_SetTarget(level, 0u);
+}
+
+uint16_t DispBright_GetLevel(void)
+{
+    return (uint16_t)(s_level_q8 >> 8);
+}
+
+uint16_t DispBright_GetTarget(void)
+{
+    return (uint16_t)(s_target_q8 >> 8);
+}
+
+bool DispBright_IsFading(void)
+{
+    return (s_level_q8 != s_target_q8);
+}
+
+// ----------------- 타이머 틱 -----------------
+void DispBright_Tick_ISR(void)
+{
+    uint32_t level  = s_level_q8;
+    uint32_t target = s_target_q8;
+
+    // 1) 페이드 진행
+    if (level != target) {
+        uint32_t step = s_step_q8;
+        if (level < target) {
+            level = ((target - level) > step) ? (level + step) : target;
+        } else {
+            level = ((level - target) > step) ? (level - step) : target;
+        }
+        s_level_q8 = level;
+    }
+
+    // 2) fine level → 아래 코드 + 위 코드 비율
+    uint16_t fine = (uint16_t)(level >> 8);
+    uint8_t  code = (uint8_t)(fine / DISP_BRIGHT_SUBSTEPS);
+    uint8_t  frac = (uint8_t)(fine % DISP_BRIGHT_SUBSTEPS);
+
+    s_dither_acc = (uint8_t)(s_dither_acc + frac);
+    if (s_dither_acc >= DISP_BRIGHT_SUBSTEPS) {
+        s_dither_acc = (uint8_t)(s_dither_acc - DISP_BRIGHT_SUBSTEPS);
+        code++;
+    }
+
+    disp_bright_output(code);
+}
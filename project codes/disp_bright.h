@@ -0,0 +1,49 @@
+/*
+ * disp_bright.h
+ *
+ *  MAX7219 밝기 엔진 (페이드 + 시간 디더링)
+ *  - REG_INTENSITY는 16단계뿐이라, 그 사이(와 INTENSITY 0 아래)를
+ *    타이머 ISR에서 두 단계(또는 shutdown)를 번갈아 찍어서 만든다.
+ *  - 밝기 단위는 "fine level": INTENSITY 한 단계 = 16
+ *      0              : 꺼짐 (shutdown)
+ *      1 ~ 15         : INTENSITY 0을 1/16 ~ 15/16 만큼만 켬 (밤용)
+ *      (i+1)*16       : INTENSITY i 고정
+ *      256            : INTENSITY 15 (최대)
+ *  - 이 모듈을 쓰기 시작하면 INTENSITY / SHUTDOWN 레지스터는 여기서만 만진다.
+ */
+
+#ifndef INC_DISP_BRIGHT_H_
+#define INC_DISP_BRIGHT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DISP_BRIGHT_SUBSTEPS     16u
+#define DISP_BRIGHT_MAX          (16u * DISP_BRIGHT_SUBSTEPS)
+#define DISP_BRIGHT_FROM_INTENSITY(i)  ((uint16_t)(((i) + 1u) * DISP_BRIGHT_SUBSTEPS))
+
+// DispBright_Tick_ISR 호출 주기 (TIM5). 1/16 듀티에서도 125 Hz라 깜빡임이 안 보임
+#define DISP_BRIGHT_TICK_HZ      2000u
+
+void DispBright_Init(uint16_t level);
+
+// fade_ms 동안 선형으로 목표까지 (0이면 즉시)
+void DispBright_SetTarget(uint16_t level, uint32_t fade_ms);
+void DispBright_SetImmediate(uint16_t level);
+
+uint16_t DispBright_GetLevel(void);    // 지금 나가고 있는 밝기 (페이드 중간값)
+uint16_t DispBright_GetTarget(void);
+bool     DispBright_IsFading(void);
+
+// TIM5 주기 인터럽트에서 호출
+void DispBright_Tick_ISR(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_DISP_BRIGHT_H_ */
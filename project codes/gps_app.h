@@ -1,65 +1,74 @@
-#ifndef GPS_APP_H
-#define GPS_APP_H
-
-#include "gps_ubx.h"
-#include <stdbool.h>
-#include <stdint.h>
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-typedef struct
-{
-    bool     valid;
-
-    // UTC time
-    uint16_t year;
-    uint8_t  month;
-    uint8_t  day;
-    uint8_t  hour;
-    uint8_t  min;
-    uint8_t  sec;
-
-    // Position (deg / m)
-    double   lat_deg;
-    double   lon_deg;
-    float    height_m;
-    float    hmsl_m;
-
-    // Fix info
-    uint8_t  fixType;
-    bool     fixOk;
-    uint8_t  numSV_used;
-    uint8_t  numSV_visible;
-
-    // Derived kinematics from LLH (HNR 20 Hz)
-    float    speed_mps;        // derived horiz speed
-    float    speed_kmh;        // derived horiz speed
-    float    heading_deg;      // derived heading (0..360)
-    bool     heading_valid;    // true if speed >= 2 km/h when updated
-
-    // Raw chip-reported (for debug / 비교용)
-    float    raw_speed_mps;    // from gSpeed
-    float    raw_heading_deg;  // from headMot
-
-    // ★ 보드 공통 시간축(SysTick/HAL_GetTick) 기준의 호스트 timestamp
-    uint32_t host_time_ms;   // HAL_GetTick() 결과, 이 fix가 갱신된 시점
-    uint32_t tow_ms;           // GPS time-of-week [ms]
-
-} app_gps_state_t;
-
-// GPS 모듈 설정 + UART RX 시작
-void APP_GPS_Init(void);
-
-// 주기적으로 호출해서 내부 state 갱신 (예: main loop에서)
-void APP_GPS_Update(void);
-
-// 최신 상태를 복사해서 가져오기 (APP은 이 함수만 보면 됨)
-bool APP_GPS_GetState(app_gps_state_t *out);
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif // GPS_APP_H
+#ifndef GPS_APP_H
+#define GPS_APP_H
+
+#include "gps_ubx.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GPS_TIME_VALID_YEAR   2020u   // 이보다 이르면 아직 수신기 RTC 기본값 (GPS 시각 아님)
+
+typedef struct
+{
+    bool     valid;
+
+    // UTC time
+    uint16_t year;
+    uint8_t  month;
+    uint8_t  day;
+    uint8_t  hour;
+    uint8_t  min;
+    uint8_t  sec;
+
+    // Position (deg / m)
+    double   lat_deg;
+    double   lon_deg;
+    float    height_m;
+    float    hmsl_m;
+
+    // Fix info
+    uint8_t  fixType;
+    bool     fixOk;
+    uint8_t  numSV_used;
+    uint8_t  numSV_visible;
+
+    // Derived kinematics from LLH (HNR 20 Hz)
+    float    speed_mps;        // derived horiz speed
+    float    speed_kmh;        // derived horiz speed
+    float    heading_deg;      // derived heading (0..360)
+    bool     heading_valid;    // true if speed >= 2 km/h when updated
+
+    // Raw chip-reported (for debug / 비교용)
+    float    raw_speed_mps;    // from gSpeed
+    float    raw_heading_deg;  // from headMot
+    float    speed_acc_mps;    // from sAcc (속도 정확도 추정)
+
+    // ★ 보드 공통 시간축(SysTick/HAL_GetTick) 기준의 호스트 timestamp
+    uint32_t host_time_ms;   // HAL_GetTick() 결과, 이 fix가 갱신된 시점
+    uint32_t tow_ms;           // GPS time-of-week [ms]
+
+    // 새 샘플이 publish될 때마다 +1 (화면 쪽에서 "새 GPS epoch" 판단용)
+    uint32_t epoch;
+
+} app_gps_state_t;
+
+// GPS 상태 초기화 + 모듈 비동기 설정 시작 (GPS_UBX_ConfigPoll로 진행)
+void APP_GPS_Init(void);
+
+// 주기적으로 호출해서 내부 state 갱신 (예: main loop에서)
+void APP_GPS_Update(void);
+
+// 최신 상태를 복사해서 가져오기 (APP은 이 함수만 보면 됨)
+bool APP_GPS_GetState(app_gps_state_t *out);
+
+// fix의 UTC를 2000-01-01 기준 초로 (아직 GPS 시각이 아니면 0)
+uint32_t APP_GPS_UtcSeconds(const app_gps_state_t *gps);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GPS_APP_H
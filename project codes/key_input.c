@@ -0,0 +1,265 @@
+// key_input.c
+#include "key_input.h"
+#include "main.h"
+#include "sched.h"
+#include <string.h>
+
+// ----------------- 엣지 큐 (ISR → 메인, 단일 생산자/단일 소비자) -----------------
+#define KEY_EDGE_QUEUE_LEN   16u    // 2의 거듭제곱
+#define KEY_EVENT_QUEUE_LEN   4u
+
+typedef struct
+{
+    uint32_t t_ms;
+    uint8_t  level;     // 1 = released, 0 = pressed
+} key_edge_t;
+
+static key_edge_t        s_edges[KEY_EDGE_QUEUE_LEN];
+static volatile uint8_t  s_edge_head = 0u;   // ISR만 씀
+static volatile uint8_t  s_edge_tail = 0u;   // 메인만 씀
+static volatile uint16_t s_edge_dropped = 0u;
+static volatile uint32_t s_edge_drop_t  = 0u;   // 마지막으로 버린 엣지 시각
+static uint16_t          s_edge_dropped_seen = 0u;
+
+// ----------------- 디바운스 / 제스처 상태 -----------------
+typedef struct
+{
+    uint8_t  raw_level;        // 마지막 엣지 이후 레벨
+    uint32_t raw_t_ms;         // 마지막 엣지 시각
+    uint8_t  stable_level;     // 디바운스 이후 안정 레벨
+
+    uint8_t  pressed;
+    uint32_t press_t_ms;
+    uint8_t  long_sent;
+    uint32_t next_repeat_ms;
+
+    uint8_t  tap_pending;      // 짧게 한 번 떼고 두 번째를 기다리는 중
+    uint32_t release_t_ms;
+    uint8_t  second_press;     // 지금 눌림이 두 번째 탭
+} key_state_t;
+
+static key_state_t s_key;
+static uint8_t     s_double_enabled = 1u;
+
+static key_event_t s_events[KEY_EVENT_QUEUE_LEN];
+static uint8_t     s_ev_head = 0u;
+static uint8_t     s_ev_tail = 0u;
+
+// PA0 raw 읽기 (풀업 + 스위치 → GND)
+static inline uint8_t key_read_raw(void)
+{
+    GPIO_PinState s = HAL_GPIO_ReadPin(GPIOA, GPIO_PIN_0);
+    return (s == GPIO_PIN_RESET) ? 0u : 1u;  // 0 = pressed
+}
+
+static void key_emit(key_event_t ev)
+{
+    uint8_t next = (uint8_t)((s_ev_head + 1u) % KEY_EVENT_QUEUE_LEN);
+    if (next == s_ev_tail) {
+        return;   // 꺼내 가지 않으면 최신 것을 버림
+    }
+    s_events[s_ev_head] = ev;
+    s_ev_head = next;
+}
+
+// ----------------- ISR -----------------
+void Key_OnEdgeISR(void)
+{
+    uint32_t now  = HAL_GetTick();
+    uint8_t  lvl  = key_read_raw();
+    uint8_t  head = s_edge_head;
+    uint8_t  next = (uint8_t)((head + 1u) & (KEY_EDGE_QUEUE_LEN - 1u));
+
+    if (next != s_edge_tail) {
+        s_edges[head].t_ms  = now;
+        s_edges[head].level = lvl;
+        s_edge_head = next;
+    } else {
+        // 가득 참 (메인이 막혀 있는데 바운스가 심함)
+        //  - 마지막 엣지가 디바운스 시간도 못 버틴 튐이면 지금 엣지와 같이 없앰 → 칸이 다시 생김
+        //    (메인은 tail 칸만 읽고, 가득 찼으면 head-1 칸은 tail에서 멀리 떨어져 있어서 안전)
+        //  - 아니면 버리고 시각만 남김 (Key_Process가 핀 레벨로 다시 맞출 때 씀)
+        uint8_t last = (uint8_t)((head - 1u) & (KEY_EDGE_QUEUE_LEN - 1u));
+        if ((lvl != s_edges[last].level) && ((now - s_edges[last].t_ms) < KEY_DEBOUNCE_MS)) {
+            s_edge_head = last;
+        } else {
+            s_edge_drop_t = now;
+            s_edge_dropped++;
+        }
+    }
+
+    Sched_Post(SCHED_EV_KEY_EDGE);
+}
+
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+    if (GPIO_Pin == GPIO_PIN_0) {
+        Key_OnEdgeISR();
+    }
+}
+
+// ----------------- 제스처 -----------------
+static void key_on_press(uint32_t t)
+{
+    s_key.pressed      = 1u;
+    s_key.press_t_ms   = t;
+    s_key.long_sent    = 0u;
+    s_key.second_press = 0u;
+
+    if (s_key.tap_pending) {
+        if ((t - s_key.release_t_ms) <= KEY_DOUBLE_GAP_MS) {
+            s_key.second_press = 1u;
+        } else {
+            key_emit(KEY_EVENT_SHORT);
+        }
+        s_key.tap_pending = 0u;
+    }
+}
+
+static void key_on_release(uint32_t t)
+{
+    if (!s_key.pressed) {
+        return;
+    }
+    s_key.pressed = 0u;
+
+    uint32_t dur = t - s_key.press_t_ms;
+
+    if (!s_key.long_sent && dur >= KEY_LONGPRESS_MS) {
+        // 메인 루프가 막혀 있는 동안 길게 눌렀다 뗀 경우: 늦게라도 LONG
+        if (s_key.second_press) {
+            key_emit(KEY_EVENT_SHORT);
+        }
+        key_emit(KEY_EVENT_LONG);
+        return;
+    }
+
+    if (s_key.long_sent || dur < KEY_SHORT_MIN_MS) {
+        // LONG/REPEAT로 이미 처리됐거나 노이즈.
+        // (두 번째 탭이 노이즈였으면 첫 탭은 SHORT로 살림)
+        if (s_key.second_press && !s_key.long_sent) {
+            key_emit(KEY_EVENT_SHORT);
+        }
+        return;
+    }
+
+    if (s_key.second_press) {
+        key_emit(KEY_EVENT_DOUBLE);
+    } else if (s_double_enabled) {
+        s_key.tap_pending  = 1u;
+        s_key.release_t_ms = t;
+    } else {
+        key_emit(KEY_EVENT_SHORT);
+    }
+}
+
+// 레벨이 KEY_DEBOUNCE_MS 동안 유지됐으면 안정 레벨로 확정
+static void key_settle(uint32_t t_limit)
+{
+    if (s_key.raw_level == s_key.stable_level) {
+        return;
+    }
+    if ((t_limit - s_key.raw_t_ms) < KEY_DEBOUNCE_MS) {
+        return;
+    }
+
+    s_key.stable_level = s_key.raw_level;
+    if (s_key.stable_level == 0u) {
+        key_on_press(s_key.raw_t_ms);
+    } else {
+        key_on_release(s_key.raw_t_ms);
+    }
+}
+
+// ----------------- API -----------------
+void Key_Init(void)
+{
+    uint32_t now = HAL_GetTick();
+    uint8_t  lvl = key_read_raw();
+
+    memset(&s_key, 0, sizeof(s_key));
+    s_key.raw_level    = lvl;
+    s_key.raw_t_ms     = now;
+    s_key.stable_level = lvl;
+
+    s_edge_tail = s_edge_head;
+    s_edge_dropped_seen = s_edge_dropped;
+    s_ev_head   = 0u;
+    s_ev_tail   = 0u;
+}
+
+void Key_Process(uint32_t now_ms)
+{
+    // 1) 쌓인 엣지를 시간순으로: 이전 레벨이 충분히 유지됐으면 확정 → 새 raw 레벨
+    while (s_edge_tail != s_edge_head) {
+        key_edge_t e = s_edges[s_edge_tail];
+        s_edge_tail = (uint8_t)((s_edge_tail + 1u) & (KEY_EDGE_QUEUE_LEN - 1u));
+
+        key_settle(e.t_ms);
+        if (e.level != s_key.raw_level) {
+            s_key.raw_level = e.level;
+            s_key.raw_t_ms  = e.t_ms;
+        }
+    }
+
+    // 2) 엣지를 놓쳤어도(큐 넘침 등) 지금 핀 레벨과는 맞춰 둠
+    //    마지막 큐 레벨을 먼저 확정하고 (그 사이 눌림을 잃지 않게),
+    //    버린 엣지가 있으면 마지막으로 버린 시각을 새 레벨의 시작으로 봄
+    uint16_t dropped = s_edge_dropped;
+    uint8_t  pin     = key_read_raw();
+    if (pin != s_key.raw_level) {
+        uint32_t t = (dropped != s_edge_dropped_seen) ? s_edge_drop_t : now_ms;
+        key_settle(t);
+        s_key.raw_level = pin;
+        s_key.raw_t_ms  = t;
+    }
+    s_edge_dropped_seen = dropped;
+    key_settle(now_ms);
+
+    // 3) 시간 기반 판정
+    if (s_key.pressed) {
+        uint32_t dur = now_ms - s_key.press_t_ms;
+
+        if (!s_key.long_sent && dur >= KEY_LONGPRESS_MS) {
+            if (s_key.second_press) {
+                // 톡 + 길게: 첫 탭은 SHORT로
+                key_emit(KEY_EVENT_SHORT);
+                s_key.second_press = 0u;
+            }
+            s_key.long_sent      = 1u;
+            s_key.next_repeat_ms = now_ms + KEY_REPEAT_DELAY_MS;
+            key_emit(KEY_EVENT_LONG);
+        } else if (s_key.long_sent && (int32_t)(now_ms - s_key.next_repeat_ms) >= 0) {
+            s_key.next_repeat_ms += KEY_REPEAT_MS;
+            key_emit(KEY_EVENT_REPEAT);
+        }
+    } else if (s_key.tap_pending && (now_ms - s_key.release_t_ms) > KEY_DOUBLE_GAP_MS) {
+        // 두 번째 탭이 안 옴 → SHORT
+        s_key.tap_pending = 0u;
+        key_emit(KEY_EVENT_SHORT);
+    }
+}
+
+key_event_t Key_GetEvent(void)
+{
+    if (s_ev_tail == s_ev_head) {
+        return KEY_EVENT_NONE;
+    }
+    key_event_t ev = s_events[s_ev_tail];
+    s_ev_tail = (uint8_t)((s_ev_tail + 1u) % KEY_EVENT_QUEUE_LEN);
+    return ev;
+}
+
+void Key_SetDoubleTapEnabled(bool enabled)
+{
+    s_double_enabled = enabled ? 1u : 0u;
+    if (!enabled && s_key.tap_pending) {
+        s_key.tap_pending = 0u;
+        key_emit(KEY_EVENT_SHORT);
+    }
+}
+
+bool Key_IsPressedRaw(void)
+{
+    return (key_read_raw() == 0u);
+}
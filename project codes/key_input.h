@@ -0,0 +1,57 @@
+/*
+ * key_input.h
+ *
+ *  단일 버튼(PA0, active-low) 입력
+ *  - EXTI 양쪽 엣지를 ISR에서 타임스탬프와 함께 lock-free 큐에 적재
+ *    → 메인 루프가 늦게 돌아도(블로킹 구간 등) 눌림을 잃지 않음
+ *  - Key_Process()가 큐를 시간순으로 디바운스하고 제스처로 바꿈:
+ *      SHORT / LONG / DOUBLE(두 번 톡톡) / REPEAT(LONG 이후 계속 누르고 있을 때)
+ */
+
+#ifndef INC_KEY_INPUT_H_
+#define INC_KEY_INPUT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    KEY_EVENT_NONE = 0,
+    KEY_EVENT_SHORT,
+    KEY_EVENT_LONG,
+    KEY_EVENT_DOUBLE,
+    KEY_EVENT_REPEAT
+} key_event_t;
+
+#define KEY_DEBOUNCE_MS       30u
+#define KEY_SHORT_MIN_MS      50u    // 이보다 짧으면 노이즈로 무시
+#define KEY_LONGPRESS_MS     800u
+#define KEY_DOUBLE_GAP_MS    300u    // 첫 번째 떼고 나서 두 번째 누를 때까지
+#define KEY_REPEAT_DELAY_MS  500u    // LONG 이후 첫 REPEAT까지
+#define KEY_REPEAT_MS        200u
+
+void Key_Init(void);
+
+// EXTI 콜백에서 호출 (엣지 1개 적재)
+void Key_OnEdgeISR(void);
+
+// 큐 처리 + 시간 기반 판정. 메인 문맥에서 주기적으로 (10 ms 정도)
+void Key_Process(uint32_t now_ms);
+
+// 인식된 제스처 하나 꺼내기 (없으면 KEY_EVENT_NONE)
+key_event_t Key_GetEvent(void);
+
+// DOUBLE 인식 on/off (off면 SHORT가 지연 없이 바로 나옴: 설정 메뉴용)
+void Key_SetDoubleTapEnabled(bool enabled);
+
+// 지금 핀이 눌려 있는지 (디바운스 없음, 부팅 체크용)
+bool Key_IsPressedRaw(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_KEY_INPUT_H_ */
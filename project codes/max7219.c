@@ -1,679 +1,954 @@
-/*
- * max7219.c
- *
- *  Created on: May 11, 2019
- *      Author: tabur
- */
-
-#include <max7219.h>
-
-#define CS_SET() 	HAL_GPIO_WritePin(CS_MAX7219_GPIO_Port, CS_MAX7219_Pin, GPIO_PIN_RESET)
-#define CS_RESET() 	HAL_GPIO_WritePin(CS_MAX7219_GPIO_Port, CS_MAX7219_Pin, GPIO_PIN_SET)
-
-static uint8_t decodeMode = 0x00;  // 0xFF": MAX7219에 내장된 BCD DECODE MODE사용 / 0x00: 생 비트를 그대로 쳐찍는모드
-
-// ★ 화면 더티 캐시
-static char    s_digit_cache[NUMBER_OF_DIGITS];
-static uint8_t s_dot_mask;
-static uint8_t s_cache_initialized = 0;
-
-static void max7219_cache_clear(void)
-{
-    // "아직 아무 것도 모른다" 상태로 리셋
-    for (int i = 0; i < NUMBER_OF_DIGITS; ++i) {
-        s_digit_cache[i] = 0;   // 사용하지 않는 값
-    }
-    s_dot_mask = 0;
-    s_cache_initialized = 1;
-}
-
-// 7-segment bit mapping
-#define SEG_A   0x40u
-#define SEG_B   0x20u
-#define SEG_C   0x10u
-#define SEG_D   0x08u
-#define SEG_E   0x04u
-#define SEG_F   0x02u
-#define SEG_G   0x01u
-#define SEG_DP  0x80u
-
-// SYMBOLS[] 인덱스용 매크로 (순서 바꾸면 같이 수정해야 함)
-#define SYMBOL_MINUS      10u   // 0~9 다음 MINUS
-#define SYMBOL_CARET      23u   // 마지막 SYMBOL_CARET (^)
-
-
-// 0~9
-static const uint8_t FONT_7SEG_DIGITS[10] = {
-    0x7E, // 0 : a b c d e f
-    0x30, // 1 : b c
-    0x6D, // 2 : a b d e g
-    0x79, // 3 : a b c d g
-    0x33, // 4 : f g b c
-    0x5B, // 5 : a f g c d
-    0x5F, // 6 : a f e d c g
-    0x70, // 7 : a b c
-    0x7F, // 8 : a b c d e f g
-    0x7B  // 9 : a b c d f g
-};
-
-static const uint8_t FONT_7SEG_ALPHA[26] = {
-    0x77, // A : a b c e f g
-    0x1F, // B : c d e f g (소문자 b 느낌)
-    0x4E, // C : a f e d
-    0x3D, // D : b c d e g (소문자 d 느낌)
-    0x4F, // E : a f e d g
-    0x47, // F : a f e g
-    0x5E, // G : a f e d c
-    0x37, // H : f e b c g
-    0x30, // I : b c (1이랑 같지만 읽기는 쉬움)
-    0x38, // J : b c d
-    0x07, // K : f e g (대충 K 느낌)
-    0x0E, // L : f e d
-    0x56, // M : a c e f (타협형)
-    0x15, // N : c e g (타협형)
-    0x7E, // O : a b c d e f (0과 동일)
-    0x67, // P : a b f e g
-    0x73, // Q : a b c f g
-    0x05, // R : e g
-    0x5B, // S : a f g c d (5와 동일)
-    0x0F, // T : f e d g
-    0x3E, // U : b c d e f
-    0x1C, // V : c d e
-    0x2A, // W : b d f (타협형)
-    0x37, // X : b c e f g (H랑 같지만 교차 느낌)
-    0x3B, // Y : b c d f g
-    0x6D  // Z : a b d e g (2와 동일)
-};
-
-static uint8_t SYMBOLS[] = {
-    0x7E, // NUM_0
-    0x30, // NUM_1
-    0x6D, // NUM_2
-    0x79, // NUM_3
-    0x33, // NUM_4
-    0x5B, // NUM_5
-    0x5F, // NUM_6
-    0x70, // NUM_7
-    0x7F, // NUM_8
-    0x7B, // NUM_9
-    0x01, // MINUS
-    0x4F, // LETTER_E
-    0x37, // LETTER_H
-    0x0E, // LETTER_L
-    0x67, // LETTER_P
-    0x00, // BLANK
-
-    // ==== 여기부터 커스텀 ====
-    0x5B, // LETTER_S
-    0x77, // LETTER_A
-    0x0F, // LETTER_T
-    0x7B, // LETTER_G
-    0x05, // LETTER_R
-    0x3D, // LETTER_d
-    0x3C, // LETTER_u
-	0x63  // SYMBOL_CARET (^)
-
-
-};
-
-static uint8_t max7219_font_from_ascii(char c)
-{
-    // 숫자
-    if (c >= '0' && c <= '9') {
-        return FONT_7SEG_DIGITS[(uint8_t)(c - '0')];
-    }
-
-    // 알파벳 (대소문자 공통 처리)
-    if (c >= 'A' && c <= 'Z') {
-        return FONT_7SEG_ALPHA[(uint8_t)(c - 'A')];
-    }
-    if (c >= 'a' && c <= 'z') {
-        return FONT_7SEG_ALPHA[(uint8_t)(c - 'a')];
-    }
-
-    // 기호 몇 개
-    if (c == '-') {
-        return SYMBOLS[SYMBOL_MINUS];
-    }
-    if (c == ' ') {
-        return 0x00u;      // blank
-    }
-    if (c == '^') {
-        return SYMBOLS[SYMBOL_CARET];   // 위 동그라미 모양
-    }
-
-
-    // 정의 안 된 글자는 blank
-    return 0x00u;
-}
-
-// 0~7 논리 위치 -> MAX7219 digit 레지스터 (1~8)
-// pos 0 = 가장 왼쪽, pos 7 = 가장 오른쪽
-static uint8_t max7219_pos_to_digit(uint8_t pos)
-{
-    if (pos >= NUMBER_OF_DIGITS) {
-        pos = NUMBER_OF_DIGITS - 1;
-    }
-    // NUMBER_OF_DIGITS == 8 이라고 가정
-    return (uint8_t)(NUMBER_OF_DIGITS - pos);  // 0 -> 8, 7 -> 1
-}
-
-void max7219_WriteCharAt(uint8_t pos, char ch, bool point)
-{
-    if (pos >= NUMBER_OF_DIGITS) {
-        return;
-    }
-
-    if (!s_cache_initialized) {
-        max7219_cache_clear();
-    }
-
-    uint8_t bit = (uint8_t)(1u << pos);
-
-    // 새 dot 마스크 계산
-    uint8_t new_mask = s_dot_mask;
-    if (point) {
-        new_mask |= bit;
-    } else {
-        new_mask &= (uint8_t)~bit;
-    }
-
-    char    prev_ch  = s_digit_cache[pos];
-    uint8_t prev_bit = (uint8_t)(s_dot_mask & bit);
-    uint8_t new_bit  = (uint8_t)(new_mask    & bit);
-
-    // ★ 캐시와 완전히 동일하면 SPI 전송 스킵
-    if (prev_ch == ch && prev_bit == new_bit) {
-        s_dot_mask = new_mask;  // 마스크는 항상 최신 값으로 유지
-        return;
-    }
-
-    // 캐시 업데이트
-    s_digit_cache[pos] = ch;
-    s_dot_mask         = new_mask;
-
-    // 실제 하드웨어로 전송
-    uint8_t digit = max7219_pos_to_digit(pos);  // 0~7 -> 1~8
-    max7219_WriteChar((MAX7219_Digits)digit, ch, point);
-}
-
-
-
-
-
-static uint16_t getSymbol(uint8_t number);
-static uint32_t lcdPow10(uint8_t n);
-
-void max7219_Init(uint8_t intensivity)
-{
-    max7219_Turn_On();
-
-    // 디코드 모드 항상 OFF
-    decodeMode = 0x00;
-    max7219_SendData(REG_DECODE_MODE, decodeMode);
-
-    max7219_SendData(REG_SCAN_LIMIT, NUMBER_OF_DIGITS - 1);
-    max7219_SetIntensivity(intensivity);
-
-    // 하드웨어 클리어
-    max7219_Clean();
-
-    // ★ 소프트웨어 캐시도 초기화
-    max7219_cache_clear();
-}
-
-
-
-void max7219_SetIntensivity(uint8_t intensivity)
-{
-	if (intensivity > 0x0F)
-	{
-		return;
-	}
-
-	max7219_SendData(REG_INTENSITY, intensivity);
-}
-
-static void max7219_cache_clear(void); // 이미 위에 static 있음
-
-void max7219_Clean(void)
-{
-    uint8_t clear = 0x00;
-
-    if (decodeMode == 0xFF)
-    {
-        clear = BLANK;
-    }
-
-    for (int i = 0; i < NUMBER_OF_DIGITS; ++i)
-    {
-        max7219_SendData(i + 1, clear);
-    }
-
-    // ★ 하드웨어 클리어할 때 캐시도 같이 초기화
-    max7219_cache_clear();
-}
-
-
-void max7219_SendData(uint8_t addr, uint8_t data)
-{
-	CS_SET();
-	HAL_SPI_Transmit(&hspi1, &addr, 1, HAL_MAX_DELAY);
-	HAL_SPI_Transmit(&hspi1, &data, 1, HAL_MAX_DELAY);
-	CS_RESET();
-}
-
-void max7219_Turn_On(void)
-{
-	max7219_SendData(REG_SHUTDOWN, 0x01);
-}
-
-void max7219_Turn_Off(void)
-{
-	max7219_SendData(REG_SHUTDOWN, 0x00);
-}
-
-void max7219_Decode_On(void)
-{
-	decodeMode = 0xFF;
-	max7219_SendData(REG_DECODE_MODE, decodeMode);
-}
-
-void max7219_Decode_Off(void)
-{
-	decodeMode = 0x00;
-	max7219_SendData(REG_DECODE_MODE, decodeMode);
-}
-
-void max7219_PrintDigit(MAX7219_Digits position, MAX7219_Numeric numeric, bool point)
-{
-	if(position > NUMBER_OF_DIGITS)
-	{
-		return;
-	}
-
-	if(point)
-	{
-		if(decodeMode == 0x00)
-		{
-			max7219_SendData(position, getSymbol(numeric) | (1 << 7));
-		}
-		else if(decodeMode == 0xFF)
-		{
-			max7219_SendData(position, numeric | (1 << 7));
-		}
-	}
-	else
-	{
-		if(decodeMode == 0x00)
-		{
-			max7219_SendData(position, getSymbol(numeric) & (~(1 << 7)));
-		}
-		else if(decodeMode == 0xFF)
-		{
-			max7219_SendData(position, numeric & (~(1 << 7)));
-		}
-	}
-}
-
-void max7219_WriteChar(MAX7219_Digits position, char ch, bool point)
-{
-    if (position == 0 || position > NUMBER_OF_DIGITS) {
-        return;
-    }
-
-    uint8_t seg = max7219_font_from_ascii(ch);
-
-    if (point) {
-        seg |= SEG_DP;
-    }
-
-    max7219_SendData(position, seg);
-}
-
-void max7219_WriteStringRight(const char *s)
-{
-    // 0~7 전체 범위 안에서 오른쪽 정렬
-    max7219_WriteStringInRange(s, 0, NUMBER_OF_DIGITS - 1, true);
-}
-
-
-
-MAX7219_Digits max7219_PrintItos(MAX7219_Digits position, int value)
-{
-	max7219_SendData(REG_DECODE_MODE, 0xFF);
-
-	int32_t i;
-
-	if (value < 0)
-	{
-		if(position > 0)
-		{
-			max7219_SendData(position, MINUS);
-			position--;
-		}
-		value = -value;
-	}
-
-	i = 1;
-
-	while ((value / i) > 9)
-	{
-		i *= 10;
-	}
-
-	if(position > 0)
-	{
-		max7219_SendData(position, value/i);
-		position--;
-	}
-
-	i /= 10;
-
-	while (i > 0)
-	{
-		if(position > 0)
-		{
-			max7219_SendData(position, (value % (i * 10)) / i);
-			position--;
-		}
-
-		i /= 10;
-	}
-
-	max7219_SendData(REG_DECODE_MODE, decodeMode);
-
-	return position;
-}
-
-MAX7219_Digits max7219_PrintNtos(MAX7219_Digits position, uint32_t value, uint8_t n)
-{
-	max7219_SendData(REG_DECODE_MODE, 0xFF);
-
-	if (n > 0u)
-	{
-		uint32_t i = lcdPow10(n - 1u);
-
-		while (i > 0u)	/* Display at least one symbol */
-		{
-			if(position > 0u)
-			{
-				max7219_SendData(position, (value / i) % 10u);
-				position--;
-			}
-
-			i /= 10u;
-		}
-	}
-
-	max7219_SendData(REG_DECODE_MODE, decodeMode);
-
-	return position;
-}
-
-MAX7219_Digits max7219_PrintFtos(MAX7219_Digits position, float value, uint8_t n)
-{
-	if(n > 4)
-	{
-		n = 4;
-	}
-
-	max7219_SendData(REG_DECODE_MODE, 0xFF);
-
-	if (value < 0.0)
-	{
-		if(position > 0)
-		{
-			max7219_SendData(position, MINUS);
-			position--;
-		}
-
-		value = -value;
-	}
-
-	position = max7219_PrintItos(position, (int32_t) value);
-
-	if (n > 0u)
-	{
-		max7219_PrintDigit(position + 1, ((int32_t) value) % 10, true);
-
-		position = max7219_PrintNtos(position, (uint32_t) (value * (float) lcdPow10(n)), n);
-	}
-
-	max7219_SendData(REG_DECODE_MODE, decodeMode);
-
-	return position;
-}
-
-static uint16_t getSymbol(uint8_t number)
-{
-	return SYMBOLS[number];
-}
-
-static uint32_t lcdPow10(uint8_t n)
-{
-	uint32_t retval = 1u;
-
-	while (n > 0u)
-	{
-		retval *= 10u;
-		n--;
-	}
-
-	return retval;
-}
-
-
-
-
-
-void max7219_WriteStringInRange(const char *s,
-                                uint8_t start,
-                                uint8_t end,
-                                bool align_right)
-{
-    if (s == NULL) {
-        return;
-    }
-
-    // 범위 정규화
-    if (start > end) {
-        uint8_t tmp = start;
-        start = end;
-        end = tmp;
-    }
-
-    if (end >= NUMBER_OF_DIGITS) {
-        end = NUMBER_OF_DIGITS - 1;
-    }
-
-    uint8_t width = end - start + 1u;
-    size_t len = strlen(s);
-
-    if (align_right) {
-        // ---- 오른쪽 정렬: 문자열 오른쪽 끝이 end에 붙음 ----
-        size_t visible = (len < width) ? len : width;
-        uint8_t first_pos  = (uint8_t)(end + 1u - visible); // 출력 시작 슬롯
-        size_t first_char  = len - visible;                // 문자열에서 첫 글자 인덱스
-
-        // 왼쪽 패딩 공백
-        for (uint8_t pos = start; pos < first_pos; ++pos) {
-            max7219_WriteCharAt(pos, ' ', false);
-        }
-
-        // 실제 텍스트
-        uint8_t pos = first_pos;
-        for (size_t i = first_char; i < len && pos <= end; ++i, ++pos) {
-            max7219_WriteCharAt(pos, s[i], false);
-        }
-    } else {
-        // ---- 왼쪽 정렬: 문자열 왼쪽이 start에 붙음 ----
-        size_t visible = (len < width) ? len : width;
-        uint8_t pos = start;
-        size_t i = 0;
-
-        for (; i < visible; ++i, ++pos) {
-            max7219_WriteCharAt(pos, s[i], false);
-        }
-
-        // 나머지 오른쪽 공백
-        for (; pos <= end; ++pos) {
-            max7219_WriteCharAt(pos, ' ', false);
-        }
-    }
-}
-
-
-// 왼쪽 4자리: 슬롯 0~3
-void max7219_WriteLeft4(const char *s, bool align_right)
-{
-    max7219_WriteStringInRange(s, 0, 3, align_right);
-}
-
-// 오른쪽 4자리: 슬롯 4~7
-void max7219_WriteRight4(const char *s, bool align_right)
-{
-    max7219_WriteStringInRange(s, 4, 7, align_right);
-}
-
-
-void max7219_ScrollText(const char *text,
-                        uint8_t start,
-                        uint8_t end,
-                        MAX7219_ScrollDir dir,
-                        uint32_t step_delay_ms,
-                        uint32_t hold_ms)
-{
-    if (text == NULL) {
-        return;
-    }
-
-    if (start > end) {
-        uint8_t tmp = start;
-        start = end;
-        end = tmp;
-    }
-
-    if (end >= NUMBER_OF_DIGITS) {
-        end = NUMBER_OF_DIGITS - 1;
-    }
-
-    uint8_t width = end - start + 1u;
-    size_t len = strlen(text);
-    if (len == 0 || width == 0) {
-        return;
-    }
-
-    if (dir == MAX7219_SCROLL_LEFT) {
-        // 일반적인 "왼쪽으로 흘러가기" (새 글자 오른쪽에서 등장)
-        for (int offset = -(int)width; offset <= (int)len; ++offset) {
-            for (uint8_t pos = 0; pos < width; ++pos) {
-                int idx = offset + (int)pos;
-                char ch = (idx < 0 || idx >= (int)len) ? ' ' : text[idx];
-                max7219_WriteCharAt(start + pos, ch, false);
-            }
-
-            // 텍스트가 윈도우에 딱 들어왔을 때 잠깐 멈춤
-            if (hold_ms > 0 && offset == 0) {
-                HAL_Delay(hold_ms);
-            }
-
-            HAL_Delay(step_delay_ms);
-        }
-    } else {
-        // 오른쪽으로 흘러가기 (새 글자 왼쪽에서 등장)
-        for (int offset = (int)len; offset >= -(int)width; --offset) {
-            for (uint8_t pos = 0; pos < width; ++pos) {
-                int idx = offset - 1 - (int)pos;
-                char ch = (idx < 0 || idx >= (int)len) ? ' ' : text[idx];
-                max7219_WriteCharAt(start + pos, ch, false);
-            }
-
-            if (hold_ms > 0 && offset == (int)len) {
-                HAL_Delay(hold_ms);
-            }
-
-            HAL_Delay(step_delay_ms);
-        }
-    }
-}
-
-
-
-// main.c 상단 쪽에 추가 (USER CODE BEGIN PFP 근처에 놔둬도 됨)
- void MAX7219_RunAllTests(void)
-{
-    char buf[16];
-
-    // 1) 기본 문자열 오른쪽 정렬 테스트
-    max7219_Clean();
-
-    max7219_WriteStringRight("HELP");
-    HAL_Delay(1000);
-
-    max7219_WriteStringRight("SPd");
-    HAL_Delay(1000);
-
-    max7219_WriteStringRight("ALt");
-    HAL_Delay(1000);
-
-    snprintf(buf, sizeof(buf), "%4d", 123);
-    max7219_WriteStringRight(buf);
-    HAL_Delay(1000);
-
-    // 2) 4+4 분할 테스트: 왼쪽은 모드, 오른쪽은 값
-    max7219_Clean();
-
-    max7219_WriteLeft4("SPD", true);   // 왼쪽 4칸에서 'SPD' 오른쪽 정렬
-    max7219_WriteRight4("0123", true); // 오른쪽 4칸에서 '0123' 오른쪽 정렬
-    HAL_Delay(1500);
-
-    // 3) 오른쪽 4자리만 업데이트
-    max7219_WriteRight4("9999", true);
-    HAL_Delay(1500);
-
-    // 4) 개별 자리 제어 테스트
-    max7219_Clean();
-
-    // pos: 0(왼쪽) ~ 7(오른쪽)
-    max7219_WriteCharAt(0, 'A', false); // 가장 왼쪽
-    max7219_WriteCharAt(1, 'B', false);
-    max7219_WriteCharAt(2, 'C', false);
-    max7219_WriteCharAt(3, 'D', false);
-    max7219_WriteCharAt(4, '1', true);  // 가운데 근처에 '1.' (소수점)
-    max7219_WriteCharAt(5, '2', false);
-    max7219_WriteCharAt(6, '3', false);
-    max7219_WriteCharAt(7, '4', false); // 가장 오른쪽
-    HAL_Delay(2000);
-
-    // 5) 전체 8자리 스크롤 테스트 (왼쪽으로 흐르기)
-    max7219_Clean();
-    max7219_ScrollText("HELLO", 0, 7,
-                       MAX7219_SCROLL_LEFT,
-                       120,   // step 딜레이(ms)
-                       400);  // 중앙에 딱 들어왔을 때 hold(ms)
-
-    HAL_Delay(500);
-
-    // 6) 전체 8자리 스크롤 (오른쪽으로 흐르기)
-    max7219_Clean();
-    max7219_ScrollText("SPD=123", 0, 7,
-                       MAX7219_SCROLL_RIGHT,
-                       120,
-                       400);
-
-    HAL_Delay(500);
-
-    // 7) 4+4 조합 + 오른쪽 4자리만 스크롤
-    max7219_Clean();
-    max7219_WriteLeft4("SPD", true); // 왼쪽 4칸에 SPD
-    // 오른쪽 4칸에서만 숫자 흐르게
-    max7219_ScrollText("0123", 4, 7,
-                       MAX7219_SCROLL_LEFT,
-                       120,
-                       300);
-
-    // 끝나면 마지막 상태 그대로 화면에 남겨둠
-}
-
-
+/*
+ * max7219.c
+ *
+ *  Created on: May 11, 2019
+ *      Author: tabur
+ */
+
+#include <max7219.h>
+#include <string.h>
+
+#define CS_SET() 	HAL_GPIO_WritePin(CS_MAX7219_GPIO_Port, CS_MAX7219_Pin, GPIO_PIN_RESET)
+#define CS_RESET() 	HAL_GPIO_WritePin(CS_MAX7219_GPIO_Port, CS_MAX7219_Pin, GPIO_PIN_SET)
+
+static uint8_t decodeMode = 0x00;  // 0xFF": MAX7219에 내장된 BCD DECODE MODE사용 / 0x00: 생 비트를 그대로 쳐찍는모드
+
+// ★ 프레임버퍼 + 화면 더티 캐시 (세그먼트 코드 단위, DP 포함)
+//  - s_fb       : 지금 그리고 있는(또는 마지막으로 그린) 프레임
+//  - s_hw       : 실제 MAX7219 digit 레지스터에 마지막으로 써 넣은 값
+//  - s_hw_known : s_hw 값을 믿을 수 있는 자리 (bit = pos)
+//  - 프레임이 열려 있는 동안(max7219_FrameBegin ~ FrameEnd)은 s_fb만 갱신하고,
+//    FrameEnd에서 바뀐 자리만 한 번에 SPI로 내보낸다.
+//  - pos는 체인 전체 기준 (0~7 = 모듈 0, 8~15 = 모듈 1 ...)
+static uint8_t  s_fb[NUMBER_OF_DIGITS];
+static uint8_t  s_hw[NUMBER_OF_DIGITS];
+static uint32_t s_hw_known  = 0u;
+static uint8_t  s_frame_open = 0u;
+
+// ★ 데이지 체인 전송
+//  - MAX7219는 digit 레지스터 하나(row)를 모든 모듈에 대해 한 CS 프레임으로 밀어 넣는다.
+//    (처음 나간 2바이트가 체인 가장 끝 모듈로 밀려감)
+//  - 바뀐 row만 골라서 row당 SPI DMA 1회, 완료 콜백에서 다음 row 시작
+//  - s_hw는 전송 시작 전에 확정되고, 전송 중에는 ISR만 읽는다.
+static uint8_t          s_tx[2u * MAX7219_NUM_MODULES];
+static volatile uint8_t s_tx_rows = 0u;    // 아직 보낼 row 비트 (bit r = digit 레지스터 r+1)
+static volatile uint8_t s_tx_busy = 0u;
+
+#define MAX7219_TX_TIMEOUT_MS   5u
+
+static void max7219_cache_clear(void)
+{
+    // "아직 아무 것도 모른다" 상태로 리셋 → 다음 쓰기는 무조건 전송
+    s_hw_known = 0u;
+}
+
+// s_hw_known 비트마스크는 32자리(모듈 4개)까지
+#if (NUMBER_OF_DIGITS > 32)
+#error "MAX7219_NUM_MODULES는 최대 4"
+#endif
+#define MAX7219_ALL_KNOWN   (0xFFFFFFFFu >> (32u - NUMBER_OF_DIGITS))
+
+// 7-segment bit mapping
+#define SEG_A   0x40u
+#define SEG_B   0x20u
+#define SEG_C   0x10u
+#define SEG_D   0x08u
+#define SEG_E   0x04u
+#define SEG_F   0x02u
+#define SEG_G   0x01u
+#define SEG_DP  0x80u
+
+// ASCII 0x00~0x7F → 세그먼트 코드 (O(1) 인덱싱)
+//  - 출력 가능한 문자(0x20~0x7E)는 전부 글리프가 정해져 있음 (' '만 빈칸)
+//  - 알파벳은 대소문자 공통 (7-seg에서 읽기 쉬운 쪽 모양 하나만 사용)
+//  - seg_format에서도 숫자 글리프를 직접 사용
+const uint8_t MAX7219_FONT_ASCII[128] = {
+    // 0x00 ~ 0x1F 제어 문자: blank (지정 안 된 자리는 0)
+    [' '] = 0x00, // 공백
+    ['!'] = 0xA0, // ! : b + dp
+    ['"'] = 0x22, // " : b f
+    ['#'] = 0x36, // # : b c e f (||)
+    ['$'] = 0x5B, // $ : S와 동일
+    ['%'] = 0x25, // % : b e g (/와 동일)
+    ['&'] = 0x7D, // & : a b c d e g
+    ['\''] = 0x02, // ' : f
+    ['('] = 0x4E, // ( : C와 동일
+    [')'] = 0x78, // ) : a b c d
+    ['*'] = 0x63, // * : a b f g (°와 동일)
+    ['+'] = 0x31, // + : b c g
+    [','] = 0x18, // , : c d
+    ['-'] = 0x01, // - : g
+    ['.'] = 0x80, // . : dp
+    ['/'] = 0x25, // / : b e g
+    ['0'] = 0x7E, // 0 : a b c d e f
+    ['1'] = 0x30, // 1 : b c
+    ['2'] = 0x6D, // 2 : a b d e g
+    ['3'] = 0x79, // 3 : a b c d g
+    ['4'] = 0x33, // 4 : f g b c
+    ['5'] = 0x5B, // 5 : a f g c d
+    ['6'] = 0x5F, // 6 : a f e d c g
+    ['7'] = 0x70, // 7 : a b c
+    ['8'] = 0x7F, // 8 : a b c d e f g
+    ['9'] = 0x7B, // 9 : a b c d f g
+    [':'] = 0x48, // : : a d
+    [';'] = 0x28, // ; : b d
+    ['<'] = 0x0D, // < : d e g
+    ['='] = 0x09, // = : d g
+    ['>'] = 0x19, // > : c d g
+    ['?'] = 0xE5, // ? : a b e g + dp
+    ['@'] = 0x7D, // @ : a b c d e g
+    ['A'] = 0x77, // A : a b c e f g
+    ['B'] = 0x1F, // B : c d e f g (소문자 b 느낌)
+    ['C'] = 0x4E, // C : a f e d
+    ['D'] = 0x3D, // D : b c d e g (소문자 d 느낌)
+    ['E'] = 0x4F, // E : a f e d g
+    ['F'] = 0x47, // F : a f e g
+    ['G'] = 0x5E, // G : a f e d c
+    ['H'] = 0x37, // H : f e b c g
+    ['I'] = 0x30, // I : b c (1이랑 같지만 읽기는 쉬움)
+    ['J'] = 0x38, // J : b c d
+    ['K'] = 0x07, // K : f e g (대충 K 느낌)
+    ['L'] = 0x0E, // L : f e d
+    ['M'] = 0x56, // M : a c e f (타협형)
+    ['N'] = 0x15, // N : c e g (타협형)
+    ['O'] = 0x7E, // O : a b c d e f (0과 동일)
+    ['P'] = 0x67, // P : a b f e g
+    ['Q'] = 0x73, // Q : a b c f g
+    ['R'] = 0x05, // R : e g
+    ['S'] = 0x5B, // S : a f g c d (5와 동일)
+    ['T'] = 0x0F, // T : f e d g
+    ['U'] = 0x3E, // U : b c d e f
+    ['V'] = 0x1C, // V : c d e
+    ['W'] = 0x2A, // W : b d f (타협형)
+    ['X'] = 0x37, // X : b c e f g (H랑 같지만 교차 느낌)
+    ['Y'] = 0x3B, // Y : b c d f g
+    ['Z'] = 0x6D, // Z : a b d e g (2와 동일)
+    ['['] = 0x4E, // [ : C와 동일
+    ['\\'] = 0x13, // 백슬래시 : c f g
+    [']'] = 0x78, // ] : a b c d
+    ['^'] = 0x63, // ^ : a b f g (각도 °)
+    ['_'] = 0x08, // _ : d
+    ['`'] = 0x20, // ` : b
+    ['a'] = 0x77, // a : 대문자와 동일
+    ['b'] = 0x1F, // b : 대문자와 동일
+    ['c'] = 0x4E, // c : 대문자와 동일
+    ['d'] = 0x3D, // d : 대문자와 동일
+    ['e'] = 0x4F, // e : 대문자와 동일
+    ['f'] = 0x47, // f : 대문자와 동일
+    ['g'] = 0x5E, // g : 대문자와 동일
+    ['h'] = 0x37, // h : 대문자와 동일
+    ['i'] = 0x30, // i : 대문자와 동일
+    ['j'] = 0x38, // j : 대문자와 동일
+    ['k'] = 0x07, // k : 대문자와 동일
+    ['l'] = 0x0E, // l : 대문자와 동일
+    ['m'] = 0x56, // m : 대문자와 동일
+    ['n'] = 0x15, // n : 대문자와 동일
+    ['o'] = 0x7E, // o : 대문자와 동일
+    ['p'] = 0x67, // p : 대문자와 동일
+    ['q'] = 0x73, // q : 대문자와 동일
+    ['r'] = 0x05, // r : 대문자와 동일
+    ['s'] = 0x5B, // s : 대문자와 동일
+    ['t'] = 0x0F, // t : 대문자와 동일
+    ['u'] = 0x3E, // u : 대문자와 동일
+    ['v'] = 0x1C, // v : 대문자와 동일
+    ['w'] = 0x2A, // w : 대문자와 동일
+    ['x'] = 0x37, // x : 대문자와 동일
+    ['y'] = 0x3B, // y : 대문자와 동일
+    ['z'] = 0x6D, // z : 대문자와 동일
+    ['{'] = 0x4E, // { : [와 동일
+    ['|'] = 0x06, // | : e f
+    ['}'] = 0x78, // } : ]와 동일
+    ['~'] = 0x40, // ~ : a (윗줄)
+    // 0x7F DEL: blank
+};
+
+#define GLYPH_DEGREE      0x63u   // '°' (Latin-1 0xB0) → '^'와 같은 윗동그라미
+
+// MAX7219_Numeric(레거시 PrintDigit용) → 문자
+static const char s_numeric_chars[] = "0123456789-EHLP SATGRdu^";
+
+// 레거시 코드 중 ASCII 폰트와 모양이 다른 것 (예전 SYMBOLS 표 그대로 유지)
+#define GLYPH_LEGACY_G    0x7Bu   // LETTER_G : a b c d f g (ASCII 'G'는 a f e d c)
+#define GLYPH_LEGACY_u    0x3Cu   // LETTER_u : b c d e     (ASCII 'u'는 b c d e f)
+
+static uint8_t max7219_font_from_ascii(char c)
+{
+    uint8_t u = (uint8_t)c;
+
+    if (u < 0x80u) {
+        return MAX7219_FONT_ASCII[u];
+    }
+
+    // 7비트 밖은 각도 기호만 (그 외 blank)
+    return (u == 0xB0u) ? GLYPH_DEGREE : 0x00u;
+}
+
+// 모듈 m의 digit 레지스터 row(0~7 → 레지스터 1~8)에 해당하는 논리 위치
+// 모듈 안에서 pos 0 = 가장 왼쪽 = 레지스터 8, pos 7 = 가장 오른쪽 = 레지스터 1
+static uint8_t max7219_row_to_pos(uint8_t module, uint8_t row)
+{
+    return (uint8_t)(module * MAX7219_DIGITS_PER_MODULE +
+                     (MAX7219_DIGITS_PER_MODULE - 1u - row));
+}
+
+// row 하나를 체인 전체 프레임으로 s_tx에 구성 (s_hw 기준)
+static void max7219_build_row(uint8_t row)
+{
+    for (uint8_t m = 0u; m < MAX7219_NUM_MODULES; ++m) {
+        // 모듈 0(MCU 쪽)이 마지막에 나가야 함
+        uint8_t slot = (uint8_t)(MAX7219_NUM_MODULES - 1u - m);
+        s_tx[2u * slot]      = (uint8_t)(row + 1u);
+        s_tx[2u * slot + 1u] = s_hw[max7219_row_to_pos(m, row)];
+    }
+}
+
+// 다음 row 전송 시작. 보낼 게 없으면 false
+static bool max7219_tx_next_row(void)
+{
+    uint8_t rows = s_tx_rows;
+    if (rows == 0u) {
+        return false;
+    }
+
+    uint8_t row = 0u;
+    while ((rows & (1u << row)) == 0u) {
+        row++;
+    }
+    s_tx_rows = (uint8_t)(rows & ~(1u << row));
+
+    max7219_build_row(row);
+
+    CS_SET();
+    if (HAL_SPI_Transmit_DMA(&SPI_PORT, s_tx, sizeof(s_tx)) != HAL_OK) {
+        // DMA를 못 쓰면 블로킹으로 마저 보냄
+        HAL_SPI_Transmit(&SPI_PORT, s_tx, sizeof(s_tx), HAL_MAX_DELAY);
+        CS_RESET();
+        return max7219_tx_next_row();
+    }
+    return true;
+}
+
+// SPI TX DMA 완료 → CS 올려서 래치, 다음 row
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi->Instance != SPI_PORT.Instance) {
+        return;
+    }
+
+    CS_RESET();
+
+    if (!max7219_tx_next_row()) {
+        s_tx_busy = 0u;
+    }
+}
+
+// 진행 중인 체인 전송이 끝날 때까지 대기 (row 하나 = 수십 us 수준)
+static void max7219_wait_idle(void)
+{
+    uint32_t t0 = HAL_GetTick();
+
+    while (s_tx_busy) {
+        if ((HAL_GetTick() - t0) > MAX7219_TX_TIMEOUT_MS) {
+            // DMA가 멈춘 경우: 정리하고 캐시는 믿지 않음
+            HAL_SPI_DMAStop(&SPI_PORT);
+            CS_RESET();
+            s_tx_rows  = 0u;
+            s_tx_busy  = 0u;
+            s_hw_known = 0u;
+            break;
+        }
+    }
+}
+
+// 프레임버퍼를 하드웨어와 동기화 (바뀐 row만, row당 체인 전송 1회)
+static void max7219_flush(void)
+{
+    max7219_wait_idle();
+
+    uint8_t rows = 0u;
+
+    for (uint8_t row = 0u; row < MAX7219_DIGITS_PER_MODULE; ++row) {
+        for (uint8_t m = 0u; m < MAX7219_NUM_MODULES; ++m) {
+            uint8_t  pos = max7219_row_to_pos(m, row);
+            uint32_t bit = (uint32_t)1u << pos;
+
+            // ★ 캐시와 완전히 동일하면 SPI 전송 스킵
+            if (!(s_hw_known & bit) || (s_hw[pos] != s_fb[pos])) {
+                rows |= (uint8_t)(1u << row);
+                break;
+            }
+        }
+    }
+
+    if (rows == 0u) {
+        return;
+    }
+
+    // 보낼 row는 모듈 전체 값을 확정 (같은 row의 다른 모듈도 같이 나감)
+    for (uint8_t row = 0u; row < MAX7219_DIGITS_PER_MODULE; ++row) {
+        if (rows & (1u << row)) {
+            for (uint8_t m = 0u; m < MAX7219_NUM_MODULES; ++m) {
+                uint8_t pos = max7219_row_to_pos(m, row);
+                s_hw[pos]   = s_fb[pos];
+                s_hw_known |= (uint32_t)1u << pos;
+            }
+        }
+    }
+
+    s_tx_rows = rows;
+    s_tx_busy = 1u;
+    if (!max7219_tx_next_row()) {
+        s_tx_busy = 0u;
+    }
+}
+
+uint8_t max7219_SegFromChar(char ch)
+{
+    return max7219_font_from_ascii(ch);
+}
+
+// 세그먼트 코드(DP 포함)를 그대로 pos 자리에 기록
+void max7219_WriteSegAt(uint8_t pos, uint8_t seg)
+{
+    if (pos >= NUMBER_OF_DIGITS) {
+        return;
+    }
+
+    s_fb[pos] = seg;
+
+    // 프레임 밖에서 호출된 경우(설정 메뉴, HW 테스트 등)는 기존처럼 즉시 반영
+    if (!s_frame_open) {
+        max7219_flush();
+    }
+}
+
+void max7219_WriteCharAt(uint8_t pos, char ch, bool point)
+{
+    uint8_t seg = max7219_font_from_ascii(ch);
+    if (point) {
+        seg |= SEG_DP;
+    }
+    max7219_WriteSegAt(pos, seg);
+}
+
+void max7219_FrameBegin(void)
+{
+    s_frame_open = 1u;
+}
+
+void max7219_FrameEnd(void)
+{
+    s_frame_open = 0u;
+
+    max7219_flush();
+}
+
+
+
+
+
+static uint16_t getSymbol(uint8_t number);
+static uint32_t lcdPow10(uint8_t n);
+
+void max7219_Init(uint8_t intensivity)
+{
+    max7219_Turn_On();
+
+    // 디코드 모드 항상 OFF
+    decodeMode = 0x00;
+    max7219_SendData(REG_DECODE_MODE, decodeMode);
+
+    max7219_SendData(REG_SCAN_LIMIT, MAX7219_DIGITS_PER_MODULE - 1);
+    max7219_SetIntensivity(intensivity);
+
+    // 하드웨어 클리어
+    max7219_Clean();
+
+    // ★ 소프트웨어 캐시도 초기화
+    max7219_cache_clear();
+}
+
+
+
+void max7219_SetIntensivity(uint8_t intensivity)
+{
+	if (intensivity > 0x0F)
+	{
+		return;
+	}
+
+	max7219_SendData(REG_INTENSITY, intensivity);
+}
+
+void max7219_Clean(void)
+{
+    // 프레임 안에서는 프레임버퍼만 비움 (FrameEnd에서 한 번에 반영)
+    memset(s_fb, 0, sizeof(s_fb));
+    if (s_frame_open) {
+        return;
+    }
+
+    uint8_t clear = 0x00;
+
+    if (decodeMode == 0xFF)
+    {
+        clear = BLANK;
+    }
+
+    for (int i = 0; i < MAX7219_DIGITS_PER_MODULE; ++i)
+    {
+        max7219_SendData(i + 1, clear);
+    }
+
+    // ★ 하드웨어 클리어할 때 캐시도 같이 갱신 (전부 빈칸으로 알고 있음)
+    memset(s_hw, 0, sizeof(s_hw));
+    s_hw_known = (clear == 0x00) ? MAX7219_ALL_KNOWN : 0u;
+}
+
+
+// 같은 레지스터/값을 체인의 모든 모듈에 한 번에 (설정 레지스터용, 블로킹)
+void max7219_SendData(uint8_t addr, uint8_t data)
+{
+	uint8_t buf[2u * MAX7219_NUM_MODULES];
+
+	for (uint8_t m = 0u; m < MAX7219_NUM_MODULES; ++m) {
+		buf[2u * m]      = addr;
+		buf[2u * m + 1u] = data;
+	}
+
+	max7219_wait_idle();
+
+	// 블로킹 전송 중에도 busy로 표시 (밝기 ISR이 끼어들지 않게)
+	s_tx_busy = 1u;
+	CS_SET();
+	HAL_SPI_Transmit(&SPI_PORT, buf, sizeof(buf), HAL_MAX_DELAY);
+	CS_RESET();
+	s_tx_busy = 0u;
+}
+
+// 타이머 ISR용: 버스가 비어 있을 때만 보냄 (사용 중이면 false → 다음 틱에 재시도)
+bool max7219_TrySendDataFromISR(uint8_t addr, uint8_t data)
+{
+	if (s_tx_busy) {
+		return false;
+	}
+
+	uint8_t buf[2u * MAX7219_NUM_MODULES];
+
+	for (uint8_t m = 0u; m < MAX7219_NUM_MODULES; ++m) {
+		buf[2u * m]      = addr;
+		buf[2u * m + 1u] = data;
+	}
+
+	CS_SET();
+	HAL_SPI_Transmit(&SPI_PORT, buf, sizeof(buf), HAL_MAX_DELAY);
+	CS_RESET();
+	return true;
+}
+
+// SCK가 MAX7219_SPI_MAX_HZ를 넘지 않는 가장 작은 분주 (BR 비트는 SPE=0일 때만 바꿀 수 있음,
+// 다음 전송에서 HAL이 다시 켬)
+void max7219_SetSpiClock(uint32_t pclk_hz)
+{
+    static const uint32_t br[8] = {
+        SPI_BAUDRATEPRESCALER_2,  SPI_BAUDRATEPRESCALER_4,
+        SPI_BAUDRATEPRESCALER_8,  SPI_BAUDRATEPRESCALER_16,
+        SPI_BAUDRATEPRESCALER_32, SPI_BAUDRATEPRESCALER_64,
+        SPI_BAUDRATEPRESCALER_128, SPI_BAUDRATEPRESCALER_256
+    };
+    uint8_t i = 0u;
+
+    while (i < 7u && (pclk_hz >> (i + 1u)) > MAX7219_SPI_MAX_HZ) {
+        i++;
+    }
+
+    max7219_wait_idle();
+    __HAL_SPI_DISABLE(&SPI_PORT);
+    MODIFY_REG(SPI_PORT.Instance->CR1, SPI_CR1_BR, br[i]);
+    SPI_PORT.Init.BaudRatePrescaler = br[i];
+}
+
+void max7219_Turn_On(void)
+{
+	max7219_SendData(REG_SHUTDOWN, 0x01);
+}
+
+void max7219_Turn_Off(void)
+{
+	max7219_SendData(REG_SHUTDOWN, 0x00);
+}
+
+// 전원 저하(last gasp)용: 진행 중인 전송을 끊고 바로 shutdown
+// 메인 문맥의 블로킹 HAL_SPI_Transmit을 끊고 들어왔으면 hspi 락/상태가 잡힌 채로 남아 있어서
+// (HAL_SPI_DMAStop은 DMA만 멈추고 락은 안 풂) HAL로 보내면 HAL_BUSY → 레지스터로 직접 보냄.
+// CS는 올리지 않고 체인 길이만큼 새로 밀어 넣음 → 끊긴 프레임의 비트는 체인 밖으로 밀려나고
+// 마지막 CS 상승에서 shutdown만 래치됨
+void max7219_ShutdownFromISR(void)
+{
+	SPI_TypeDef *spi = SPI_PORT.Instance;
+
+	HAL_SPI_DMAStop(&SPI_PORT);
+	CLEAR_BIT(spi->CR2, SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
+	SET_BIT(spi->CR1, SPI_CR1_SPE);      // SetSpiClock 직후면 꺼져 있음
+	s_tx_rows  = 0u;
+	s_tx_busy  = 1u;                     // 밝기 ISR이 끼어들지 않게 (이 ISR은 돌아가지 않음)
+	s_hw_known = 0u;
+
+	CS_SET();
+	for (uint8_t m = 0u; m < MAX7219_NUM_MODULES; ++m) {
+		const uint8_t frame[2] = { REG_SHUTDOWN, 0x00 };
+		for (uint8_t i = 0u; i < 2u; ++i) {
+			while ((spi->SR & SPI_SR_TXE) == 0u) {
+			}
+			*(volatile uint8_t *)&spi->DR = frame[i];
+		}
+	}
+	while ((spi->SR & SPI_SR_TXE) == 0u) {
+	}
+	while ((spi->SR & SPI_SR_BSY) != 0u) {
+	}
+	CS_RESET();
+
+	// 2-line이라 RX에 쌓인 바이트 / OVR 정리 (DR 읽고 SR 읽기)
+	(void)spi->DR;
+	(void)spi->SR;
+}
+
+void max7219_Decode_On(void)
+{
+	decodeMode = 0xFF;
+	max7219_SendData(REG_DECODE_MODE, decodeMode);
+}
+
+void max7219_Decode_Off(void)
+{
+	decodeMode = 0x00;
+	max7219_SendData(REG_DECODE_MODE, decodeMode);
+}
+
+void max7219_PrintDigit(MAX7219_Digits position, MAX7219_Numeric numeric, bool point)
+{
+	if(position > MAX7219_DIGITS_PER_MODULE)
+	{
+		return;
+	}
+
+	if(point)
+	{
+		if(decodeMode == 0x00)
+		{
+			max7219_SendData(position, getSymbol(numeric) | (1 << 7));
+		}
+		else if(decodeMode == 0xFF)
+		{
+			max7219_SendData(position, numeric | (1 << 7));
+		}
+	}
+	else
+	{
+		if(decodeMode == 0x00)
+		{
+			max7219_SendData(position, getSymbol(numeric) & (~(1 << 7)));
+		}
+		else if(decodeMode == 0xFF)
+		{
+			max7219_SendData(position, numeric & (~(1 << 7)));
+		}
+	}
+}
+
+void max7219_WriteChar(MAX7219_Digits position, char ch, bool point)
+{
+    if (position == 0 || position > MAX7219_DIGITS_PER_MODULE) {
+        return;
+    }
+
+    uint8_t seg = max7219_font_from_ascii(ch);
+
+    if (point) {
+        seg |= SEG_DP;
+    }
+
+    max7219_SendData(position, seg);
+}
+
+void max7219_WriteStringRight(const char *s)
+{
+    // 0~7 전체 범위 안에서 오른쪽 정렬
+    max7219_WriteStringInRange(s, 0, MAX7219_DIGITS_PER_MODULE - 1, true);
+}
+
+
+
+MAX7219_Digits max7219_PrintItos(MAX7219_Digits position, int value)
+{
+	max7219_SendData(REG_DECODE_MODE, 0xFF);
+
+	int32_t i;
+
+	if (value < 0)
+	{
+		if(position > 0)
+		{
+			max7219_SendData(position, MINUS);
+			position--;
+		}
+		value = -value;
+	}
+
+	i = 1;
+
+	while ((value / i) > 9)
+	{
+		i *= 10;
+	}
+
+	if(position > 0)
+	{
+		max7219_SendData(position, value/i);
+		position--;
+	}
+
+	i /= 10;
+
+	while (i > 0)
+	{
+		if(position > 0)
+		{
+			max7219_SendData(position, (value % (i * 10)) / i);
+			position--;
+		}
+
+		i /= 10;
+	}
+
+	max7219_SendData(REG_DECODE_MODE, decodeMode);
+
+	return position;
+}
+
+MAX7219_Digits max7219_PrintNtos(MAX7219_Digits position, uint32_t value, uint8_t n)
+{
+	max7219_SendData(REG_DECODE_MODE, 0xFF);
+
+	if (n > 0u)
+	{
+		uint32_t i = lcdPow10(n - 1u);
+
+		while (i > 0u)	/* Display at least one symbol */
+		{
+			if(position > 0u)
+			{
+				max7219_SendData(position, (value / i) % 10u);
+				position--;
+			}
+
+			i /= 10u;
+		}
+	}
+
+	max7219_SendData(REG_DECODE_MODE, decodeMode);
+
+	return position;
+}
+
+MAX7219_Digits max7219_PrintFtos(MAX7219_Digits position, float value, uint8_t n)
+{
+	if(n > 4)
+	{
+		n = 4;
+	}
+
+	max7219_SendData(REG_DECODE_MODE, 0xFF);
+
+	if (value < 0.0)
+	{
+		if(position > 0)
+		{
+			max7219_SendData(position, MINUS);
+			position--;
+		}
+
+		value = -value;
+	}
+
+	position = max7219_PrintItos(position, (int32_t) value);
+
+	if (n > 0u)
+	{
+		max7219_PrintDigit(position + 1, ((int32_t) value) % 10, true);
+
+		position = max7219_PrintNtos(position, (uint32_t) (value * (float) lcdPow10(n)), n);
+	}
+
+	max7219_SendData(REG_DECODE_MODE, decodeMode);
+
+	return position;
+}
+
+static uint16_t getSymbol(uint8_t number)
+{
+	if (number >= (sizeof(s_numeric_chars) - 1u)) {
+		return 0x00u;
+	}
+	if (number == LETTER_G) {
+		return GLYPH_LEGACY_G;
+	}
+	if (number == LETTER_u) {
+		return GLYPH_LEGACY_u;
+	}
+	return max7219_font_from_ascii(s_numeric_chars[number]);
+}
+
+static uint32_t lcdPow10(uint8_t n)
+{
+	uint32_t retval = 1u;
+
+	while (n > 0u)
+	{
+		retval *= 10u;
+		n--;
+	}
+
+	return retval;
+}
+
+
+
+
+
+void max7219_WriteStringInRange(const char *s,
+                                uint8_t start,
+                                uint8_t end,
+                                bool align_right)
+{
+    if (s == NULL) {
+        return;
+    }
+
+    // 범위 정규화
+    if (start > end) {
+        uint8_t tmp = start;
+        start = end;
+        end = tmp;
+    }
+
+    if (end >= NUMBER_OF_DIGITS) {
+        end = NUMBER_OF_DIGITS - 1;
+    }
+
+    uint8_t width = end - start + 1u;
+    size_t len = strlen(s);
+
+    if (align_right) {
+        // ---- 오른쪽 정렬: 문자열 오른쪽 끝이 end에 붙음 ----
+        size_t visible = (len < width) ? len : width;
+        uint8_t first_pos  = (uint8_t)(end + 1u - visible); // 출력 시작 슬롯
+        size_t first_char  = len - visible;                // 문자열에서 첫 글자 인덱스
+
+        // 왼쪽 패딩 공백
+        for (uint8_t pos = start; pos < first_pos; ++pos) {
+            max7219_WriteCharAt(pos, ' ', false);
+        }
+
+        // 실제 텍스트
+        uint8_t pos = first_pos;
+        for (size_t i = first_char; i < len && pos <= end; ++i, ++pos) {
+            max7219_WriteCharAt(pos, s[i], false);
+        }
+    } else {
+        // ---- 왼쪽 정렬: 문자열 왼쪽이 start에 붙음 ----
+        size_t visible = (len < width) ? len : width;
+        uint8_t pos = start;
+        size_t i = 0;
+
+        for (; i < visible; ++i, ++pos) {
+            max7219_WriteCharAt(pos, s[i], false);
+        }
+
+        // 나머지 오른쪽 공백
+        for (; pos <= end; ++pos) {
+            max7219_WriteCharAt(pos, ' ', false);
+        }
+    }
+}
+
+
+// 왼쪽 4자리: 슬롯 0~3
+void max7219_WriteLeft4(const char *s, bool align_right)
+{
+    max7219_WriteStringInRange(s, 0, 3, align_right);
+}
+
+// 오른쪽 4자리: 슬롯 4~7
+void max7219_WriteRight4(const char *s, bool align_right)
+{
+    max7219_WriteStringInRange(s, 4, 7, align_right);
+}
+
+
+// 스크롤 한 프레임 그리기 (offset 위치의 텍스트 창을 start~end 에 출력)
+//  - LEFT : offset = -width ... len  (offset 0 에서 텍스트가 창에 딱 들어옴)
+//  - RIGHT: offset = len ... -width  (offset len 에서 텍스트가 창에 딱 들어옴)
+void max7219_WriteScrollFrame(const char *text,
+                              uint8_t start,
+                              uint8_t end,
+                              MAX7219_ScrollDir dir,
+                              int offset)
+{
+    if (text == NULL) {
+        return;
+    }
+
+    if (start > end) {
+        uint8_t tmp = start;
+        start = end;
+        end = tmp;
+    }
+
+    if (end >= NUMBER_OF_DIGITS) {
+        end = NUMBER_OF_DIGITS - 1;
+    }
+
+    uint8_t width = end - start + 1u;
+    int     len   = (int)strlen(text);
+
+    for (uint8_t pos = 0; pos < width; ++pos) {
+        int idx = (dir == MAX7219_SCROLL_LEFT)
+                ? (offset + (int)pos)
+                : (offset - 1 - (int)pos);
+        char ch = (idx < 0 || idx >= len) ? ' ' : text[idx];
+        max7219_WriteCharAt(start + pos, ch, false);
+    }
+}
+
+// 블로킹 스크롤 (테스트/부팅용). 화면 모드 전환 연출은 app_anim의 논블로킹 스크롤 사용.
+void max7219_ScrollText(const char *text,
+                        uint8_t start,
+                        uint8_t end,
+                        MAX7219_ScrollDir dir,
+                        uint32_t step_delay_ms,
+                        uint32_t hold_ms)
+{
+    if (text == NULL) {
+        return;
+    }
+
+    if (start > end) {
+        uint8_t tmp = start;
+        start = end;
+        end = tmp;
+    }
+
+    if (end >= NUMBER_OF_DIGITS) {
+        end = NUMBER_OF_DIGITS - 1;
+    }
+
+    uint8_t width = end - start + 1u;
+    size_t len = strlen(text);
+    if (len == 0 || width == 0) {
+        return;
+    }
+
+    if (dir == MAX7219_SCROLL_LEFT) {
+        // 일반적인 "왼쪽으로 흘러가기" (새 글자 오른쪽에서 등장)
+        for (int offset = -(int)width; offset <= (int)len; ++offset) {
+            max7219_WriteScrollFrame(text, start, end, dir, offset);
+
+            // 텍스트가 윈도우에 딱 들어왔을 때 잠깐 멈춤
+            if (hold_ms > 0 && offset == 0) {
+                HAL_Delay(hold_ms);
+            }
+
+            HAL_Delay(step_delay_ms);
+        }
+    } else {
+        // 오른쪽으로 흘러가기 (새 글자 왼쪽에서 등장)
+        for (int offset = (int)len; offset >= -(int)width; --offset) {
+            max7219_WriteScrollFrame(text, start, end, dir, offset);
+
+            if (hold_ms > 0 && offset == (int)len) {
+                HAL_Delay(hold_ms);
+            }
+
+            HAL_Delay(step_delay_ms);
+        }
+    }
+}
+
+
+
+// main.c 상단 쪽에 추가 (USER CODE BEGIN PFP 근처에 놔둬도 됨)
+ void MAX7219_RunAllTests(void)
+{
+    // 1) 기본 문자열 오른쪽 정렬 테스트
+    max7219_Clean();
+
+    max7219_WriteStringRight("HELP");
+    HAL_Delay(1000);
+
+    max7219_WriteStringRight("SPd");
+    HAL_Delay(1000);
+
+    max7219_WriteStringRight("ALt");
+    HAL_Delay(1000);
+
+    max7219_WriteStringRight(" 123");
+    HAL_Delay(1000);
+
+    // 2) 4+4 분할 테스트: 왼쪽은 모드, 오른쪽은 값
+    max7219_Clean();
+
+    max7219_WriteLeft4("SPD", true);   // 왼쪽 4칸에서 'SPD' 오른쪽 정렬
+    max7219_WriteRight4("0123", true); // 오른쪽 4칸에서 '0123' 오른쪽 정렬
+    HAL_Delay(1500);
+
+    // 3) 오른쪽 4자리만 업데이트
+    max7219_WriteRight4("9999", true);
+    HAL_Delay(1500);
+
+    // 4) 개별 자리 제어 테스트
+    max7219_Clean();
+
+    // pos: 0(왼쪽) ~ 7(오른쪽)
+    max7219_WriteCharAt(0, 'A', false); // 가장 왼쪽
+    max7219_WriteCharAt(1, 'B', false);
+    max7219_WriteCharAt(2, 'C', false);
+    max7219_WriteCharAt(3, 'D', false);
+    max7219_WriteCharAt(4, '1', true);  // 가운데 근처에 '1.' (소수점)
+    max7219_WriteCharAt(5, '2', false);
+    max7219_WriteCharAt(6, '3', false);
+    max7219_WriteCharAt(7, '4', false); // 가장 오른쪽
+    HAL_Delay(2000);
+
+    // 5) 전체 8자리 스크롤 테스트 (왼쪽으로 흐르기)
+    max7219_Clean();
+    max7219_ScrollText("HELLO", 0, 7,
+                       MAX7219_SCROLL_LEFT,
+                       120,   // step 딜레이(ms)
+                       400);  // 중앙에 딱 들어왔을 때 hold(ms)
+
+    HAL_Delay(500);
+
+    // 6) 전체 8자리 스크롤 (오른쪽으로 흐르기)
+    max7219_Clean();
+    max7219_ScrollText("SPD=123", 0, 7,
+                       MAX7219_SCROLL_RIGHT,
+                       120,
+                       400);
+
+    HAL_Delay(500);
+
+    // 7) 4+4 조합 + 오른쪽 4자리만 스크롤
+    max7219_Clean();
+    max7219_WriteLeft4("SPD", true); // 왼쪽 4칸에 SPD
+    // 오른쪽 4칸에서만 숫자 흐르게
+    max7219_ScrollText("0123", 4, 7,
+                       MAX7219_SCROLL_LEFT,
+                       120,
+                       300);
+
+    // 끝나면 마지막 상태 그대로 화면에 남겨둠
+}
+
+
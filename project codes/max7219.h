@@ -1,119 +1,149 @@
-/*
- * max7219.h
- *
- *  Created on: May 11, 2019
- *      Author: tabur
- */
-
-#ifndef MAX7219_H_
-#define MAX7219_H_
-
-#include "main.h"
-#include "stdbool.h"
-
-#define NUMBER_OF_DIGITS	8
-#define SPI_PORT			hspi1
-
-extern SPI_HandleTypeDef 	SPI_PORT;
-
-typedef enum {
-	REG_NO_OP 			= 0x00,
-	REG_DIGIT_0 		= 0x01,
-	REG_DIGIT_1 		= 0x02,
-	REG_DIGIT_2 		= 0x03,
-	REG_DIGIT_3 		= 0x04,
-	REG_DIGIT_4 		= 0x05,
-	REG_DIGIT_5 		= 0x06,
-	REG_DIGIT_6 		= 0x07,
-	REG_DIGIT_7 		= 0x08,
-	REG_DECODE_MODE 	= 0x09,
-	REG_INTENSITY 		= 0x0A,
-	REG_SCAN_LIMIT 		= 0x0B,
-	REG_SHUTDOWN 		= 0x0C,
-	REG_DISPLAY_TEST 	= 0x0F,
-} MAX7219_REGISTERS;
-
-typedef enum {
-	DIGIT_1 = 1, DIGIT_2 = 2, DIGIT_3 = 3, DIGIT_4 = 4,
-	DIGIT_5 = 5, DIGIT_6 = 6, DIGIT_7 = 7, DIGIT_8 = 8
-} MAX7219_Digits;
-
-typedef enum {
-	NUM_0		= 0x00,
-	NUM_1		= 0x01,
-	NUM_2		= 0x02,
-	NUM_3		= 0x03,
-	NUM_4		= 0x04,
-	NUM_5		= 0x05,
-	NUM_6		= 0x06,
-	NUM_7		= 0x07,
-	NUM_8		= 0x08,
-	NUM_9		= 0x09,
-	MINUS		= 0x0A,
-	LETTER_E	= 0x0B,
-	LETTER_H	= 0x0C,
-	LETTER_L	= 0x0D,
-	LETTER_P	= 0x0E,
-	BLANK		= 0x0F,
-
-
-
-    // 여기부터 울애기 커스텀 👇
-    LETTER_S   = 0x10,
-    LETTER_A   = 0x11,
-    LETTER_T   = 0x12,
-    LETTER_G   = 0x13,
-    LETTER_R   = 0x14,
-    LETTER_d   = 0x15,   // 소문자 d 느낌
-    LETTER_u   = 0x16,   // 소문자 u 느낌
-    SYMBOL_CARET = 0x17  // ^
-
-
-}MAX7219_Numeric;
-
-
-typedef enum {
-    MAX7219_SCROLL_LEFT = 0,   // 텍스트가 왼쪽으로 흘러감 (새 글자가 오른쪽에서 등장)
-    MAX7219_SCROLL_RIGHT = 1   // 텍스트가 오른쪽으로 흘러감 (새 글자가 왼쪽에서 등장)
-} MAX7219_ScrollDir;
-
-
-void max7219_Init(uint8_t intensivity);
-void max7219_SetIntensivity(uint8_t intensivity);
-void max7219_Clean(void);
-void max7219_SendData(uint8_t addr, uint8_t data);
-void max7219_Turn_On(void);
-void max7219_Turn_Off(void);
-void max7219_Decode_On(void);
-void max7219_Decode_Off(void);
-void max7219_PrintDigit(MAX7219_Digits position, MAX7219_Numeric numeric, bool point);
-MAX7219_Digits max7219_PrintItos(MAX7219_Digits position, int value);
-MAX7219_Digits max7219_PrintNtos(MAX7219_Digits position, uint32_t value, uint8_t n);
-MAX7219_Digits max7219_PrintFtos(MAX7219_Digits position, float value, uint8_t n);
-
-void max7219_WriteChar(MAX7219_Digits position, char ch, bool point);
-void max7219_WriteStringRight(const char *s);
-
-void max7219_WriteCharAt(uint8_t pos, char ch, bool point);
-
-
-void max7219_WriteStringInRange(const char *s,
-                                uint8_t start,
-                                uint8_t end,
-                                bool align_right);
-
-
-void max7219_WriteLeft4(const char *s, bool align_right);
-void max7219_WriteRight4(const char *s, bool align_right);
-
-
-void max7219_ScrollText(const char *text,
-                        uint8_t start,
-                        uint8_t end,
-                        MAX7219_ScrollDir dir,
-                        uint32_t step_delay_ms,
-                        uint32_t hold_ms);
-
-
-
-#endif /* MAX7219_H_ */
+/*
+ * max7219.h
+ *
+ *  Created on: May 11, 2019
+ *      Author: tabur
+ */
+
+#ifndef MAX7219_H_
+#define MAX7219_H_
+
+#include "main.h"
+#include "stdbool.h"
+
+// 데이지 체인 모듈 수 (모듈당 8자리). 빌드 옵션으로 덮어쓸 수 있음
+#ifndef MAX7219_NUM_MODULES
+#define MAX7219_NUM_MODULES	1
+#endif
+
+#define MAX7219_DIGITS_PER_MODULE	8
+#define NUMBER_OF_DIGITS	(MAX7219_DIGITS_PER_MODULE * MAX7219_NUM_MODULES)
+#define SPI_PORT			hspi1
+
+// SCK 상한. CubeMX 설정(100 MHz / 256 ≈ 390 kHz)과 같은 여유를 클럭 프로파일이 바뀌어도 유지
+#define MAX7219_SPI_MAX_HZ	400000u
+
+extern SPI_HandleTypeDef 	SPI_PORT;
+
+typedef enum {
+	REG_NO_OP 			= 0x00,
+	REG_DIGIT_0 		= 0x01,
+	REG_DIGIT_1 		= 0x02,
+	REG_DIGIT_2 		= 0x03,
+	REG_DIGIT_3 		= 0x04,
+	REG_DIGIT_4 		= 0x05,
+	REG_DIGIT_5 		= 0x06,
+	REG_DIGIT_6 		= 0x07,
+	REG_DIGIT_7 		= 0x08,
+	REG_DECODE_MODE 	= 0x09,
+	REG_INTENSITY 		= 0x0A,
+	REG_SCAN_LIMIT 		= 0x0B,
+	REG_SHUTDOWN 		= 0x0C,
+	REG_DISPLAY_TEST 	= 0x0F,
+} MAX7219_REGISTERS;
+
+typedef enum {
+	DIGIT_1 = 1, DIGIT_2 = 2, DIGIT_3 = 3, DIGIT_4 = 4,
+	DIGIT_5 = 5, DIGIT_6 = 6, DIGIT_7 = 7, DIGIT_8 = 8
+} MAX7219_Digits;
+
+typedef enum {
+	NUM_0		= 0x00,
+	NUM_1		= 0x01,
+	NUM_2		= 0x02,
+	NUM_3		= 0x03,
+	NUM_4		= 0x04,
+	NUM_5		= 0x05,
+	NUM_6		= 0x06,
+	NUM_7		= 0x07,
+	NUM_8		= 0x08,
+	NUM_9		= 0x09,
+	MINUS		= 0x0A,
+	LETTER_E	= 0x0B,
+	LETTER_H	= 0x0C,
+	LETTER_L	= 0x0D,
+	LETTER_P	= 0x0E,
+	BLANK		= 0x0F,
+
+
+
+    // 여기부터 울애기 커스텀 👇
+    LETTER_S   = 0x10,
+    LETTER_A   = 0x11,
+    LETTER_T   = 0x12,
+    LETTER_G   = 0x13,
+    LETTER_R   = 0x14,
+    LETTER_d   = 0x15,   // 소문자 d 느낌
+    LETTER_u   = 0x16,   // 소문자 u 느낌
+    SYMBOL_CARET = 0x17  // ^
+
+
+}MAX7219_Numeric;
+
+
+typedef enum {
+    MAX7219_SCROLL_LEFT = 0,   // 텍스트가 왼쪽으로 흘러감 (새 글자가 오른쪽에서 등장)
+    MAX7219_SCROLL_RIGHT = 1   // 텍스트가 오른쪽으로 흘러감 (새 글자가 왼쪽에서 등장)
+} MAX7219_ScrollDir;
+
+
+void max7219_Init(uint8_t intensivity);
+void max7219_SetIntensivity(uint8_t intensivity);
+void max7219_Clean(void);
+void max7219_SendData(uint8_t addr, uint8_t data);
+bool max7219_TrySendDataFromISR(uint8_t addr, uint8_t data);
+void max7219_SetSpiClock(uint32_t pclk_hz);   // APB2가 바뀐 뒤 분주 재계산 (전송 끝날 때까지 대기)
+void max7219_Turn_On(void);
+void max7219_Turn_Off(void);
+void max7219_ShutdownFromISR(void);   // 전원 저하용: 전송 중단 후 레지스터로 직접 shutdown (HAL 락 무시)
+void max7219_Decode_On(void);
+void max7219_Decode_Off(void);
+void max7219_PrintDigit(MAX7219_Digits position, MAX7219_Numeric numeric, bool point);
+MAX7219_Digits max7219_PrintItos(MAX7219_Digits position, int value);
+MAX7219_Digits max7219_PrintNtos(MAX7219_Digits position, uint32_t value, uint8_t n);
+MAX7219_Digits max7219_PrintFtos(MAX7219_Digits position, float value, uint8_t n);
+
+void max7219_WriteChar(MAX7219_Digits position, char ch, bool point);
+void max7219_WriteStringRight(const char *s);
+
+void max7219_WriteCharAt(uint8_t pos, char ch, bool point);
+
+// 세그먼트 코드 단위 접근 (화면 레이아웃 엔진용)
+#define MAX7219_SEG_DP      0x80u
+extern const uint8_t MAX7219_FONT_ASCII[128];
+uint8_t max7219_SegFromChar(char ch);
+void    max7219_WriteSegAt(uint8_t pos, uint8_t seg);
+
+// 프레임 단위 갱신: Begin ~ End 사이의 WriteCharAt/Clean은 프레임버퍼에만 쌓이고
+// End에서 바뀐 자리만 한 번에 전송된다 (중간 상태가 화면에 보이지 않음)
+void max7219_FrameBegin(void);
+void max7219_FrameEnd(void);
+
+
+void max7219_WriteStringInRange(const char *s,
+                                uint8_t start,
+                                uint8_t end,
+                                bool align_right);
+
+
+void max7219_WriteLeft4(const char *s, bool align_right);
+void max7219_WriteRight4(const char *s, bool align_right);
+
+
+// 스크롤 한 프레임만 그리기 (논블로킹 애니메이션용)
+void max7219_WriteScrollFrame(const char *text,
+                              uint8_t start,
+                              uint8_t end,
+                              MAX7219_ScrollDir dir,
+                              int offset);
+
+void max7219_ScrollText(const char *text,
+                        uint8_t start,
+                        uint8_t end,
+                        MAX7219_ScrollDir dir,
+                        uint32_t step_delay_ms,
+                        uint32_t hold_ms);
+
+
+
+#endif /* MAX7219_H_ */
@@ -0,0 +1,131 @@
+// power_fail.c
+#include "power_fail.h"
+#include "main.h"
+#include "max7219.h"
+#include "gps_ubx.h"
+#include "trip_store.h"
+#include "track_log.h"
+#include "settings_storage.h"
+#include "clock_profile.h"
+
+// ----------------- 상태 -----------------
+static power_fail_stats_t s_stats;
+static volatile uint8_t   s_triggered = 0u;
+static volatile uint8_t   s_erasing   = 0u;
+static volatile uint32_t  s_erase_c0  = 0u;   // erase 시작 CYCCNT
+
+// 파워온 리셋 뒤에는 TRCENA가 꺼져 있어서 CYCCNT가 0에 멈춰 있음. PVD는 Sched_Init(카운터를
+// 켜는 곳)보다 먼저 켜지므로 여기서도 켬 (Sched_Init는 나중에 0부터 다시 셀 뿐)
+static void power_fail_cyccnt_enable(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static uint32_t power_fail_us_since(uint32_t c0)
+{
+    return (DWT->CYCCNT - c0) / (ClockProfile_GetSysclkHz() / 1000000u);
+}
+
+// 전부 PVD ISR 안에서. PVD는 우선순위 0이고 DMA2/EXTI0/TIM3/USART1도 0이라 끼어들지 못하고
+// (같은 우선순위는 선점 불가) 펜딩으로 남음 — 이 ISR은 리셋까지 돌아가지 않으므로 끝내 안 돌아감.
+// TIM5(1) / RTC_WKUP(2)도 마찬가지. 대신 메인 문맥에서 하던 일(블로킹 SPI, 플래시)은 중간에
+// 끊겼을 수 있어서 각 모듈의 FromISR / LastGasp 경로가 HAL 락/상태를 직접 정리함
+static void power_fail_last_gasp(void)
+{
+    uint32_t c0 = DWT->CYCCNT;
+
+    // 0) erase 도중이었으면 전압이 떨어진 뒤 여기까지 이미 그만큼 흘렀음 (c0부터 재는 단계 시간엔 안 잡힘)
+    if (s_erasing) {
+        s_stats.erase_in_progress = 1u;
+        s_stats.erase_latency_us  = power_fail_us_since(s_erase_c0);
+    }
+
+    // 1) 전류를 제일 많이 먹는 화면부터 끔 (GPS UART 중단은 3)의 GPS_UBX_ParkFromISR가 함)
+    max7219_ShutdownFromISR();
+    s_stats.display_us = power_fail_us_since(c0);
+
+    // 2) 밀린 트립 값 저장 (설정은 바뀔 때마다 바로 저장되므로 밀린 게 없음)
+    //    그다음 RAM에 모아 둔 궤적 블록 (시동 끈 위치가 여기 있음)
+    //    플래시가 아직 BSY(erase가 안 끝남)면 쓰기가 BSY를 기다리느라 예산을 다 쓰므로 건너뜀
+    if (FLASH->SR & FLASH_SR_BSY) {
+        s_stats.flash_skipped = 1u;
+    } else {
+        Settings_BeginLastGasp();
+        TripStore_Flush();
+        TrackLog_FlushFromISR();
+    }
+    s_stats.flush_us = power_fail_us_since(c0);
+
+    // 3) 수신기 백업 모드 (데이터를 먼저 살리고 나서)
+    GPS_UBX_ParkFromISR();
+    s_stats.total_us = power_fail_us_since(c0);
+
+    uint32_t worst_us = s_stats.erase_latency_us + s_stats.total_us;
+    s_stats.over_budget = (worst_us > POWER_FAIL_BUDGET_US) ? 1u : 0u;
+
+    // 4) 최악 시간은 플래시에 (여기까지 살아남았을 때만 남음)
+    if (!s_stats.flash_skipped && (int32_t)worst_us > Settings_Get(SETTINGS_KEY_LASTGASP_MAX_US)) {
+        Settings_Set(SETTINGS_KEY_LASTGASP_MAX_US, (int32_t)worst_us);
+    }
+}
+
+// ----------------- API -----------------
+void PowerFail_Init(void)
+{
+    PWR_PVDTypeDef pvd;
+
+    power_fail_cyccnt_enable();
+
+    pvd.PVDLevel = POWER_FAIL_PVD_LEVEL;
+    pvd.Mode     = PWR_PVD_MODE_IT_RISING;   // PVDO 상승 = VDD가 레벨 아래로
+    HAL_PWR_ConfigPVD(&pvd);
+    HAL_PWR_EnablePVD();
+
+    HAL_NVIC_SetPriority(PVD_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(PVD_IRQn);
+}
+
+void HAL_PWR_PVDCallback(void)
+{
+    if (s_triggered) {
+        return;
+    }
+    s_triggered = 1u;
+    s_stats.count++;
+
+    power_fail_last_gasp();
+
+    // 전원이 그대로 죽으면 여기서 끝. 잠깐 떨어졌다 돌아온 경우는
+    // 화면/UART/수신기를 다 멈춰 놨으니 리셋해서 처음부터
+    //  - 반복 횟수로도 끝냄: 한 바퀴가 최소 1사이클이므로 cycles_ok 바퀴면 적어도 RECOVER_MS
+    //    (CYCCNT가 어떤 이유로든 멈춰 있어도 ISR에 갇히지 않게)
+    uint32_t cycles_ok = (ClockProfile_GetSysclkHz() / 1000u) * POWER_FAIL_RECOVER_MS;
+    uint32_t ok_since  = DWT->CYCCNT;
+    uint32_t ok_loops  = 0u;
+
+    for (;;) {
+        if (PWR->CSR & PWR_CSR_PVDO) {
+            ok_since = DWT->CYCCNT;
+            ok_loops = 0u;
+        } else if (((DWT->CYCCNT - ok_since) >= cycles_ok) || (++ok_loops >= cycles_ok)) {
+            NVIC_SystemReset();
+        }
+    }
+}
+
+void PowerFail_EraseBegin(void)
+{
+    s_erase_c0 = DWT->CYCCNT;
+    s_erasing  = 1u;
+}
+
+void PowerFail_EraseEnd(void)
+{
+    s_erasing = 0u;
+}
+
+const power_fail_stats_t *PowerFail_GetStats(void)
+{
+    return &s_stats;
+}
@@ -0,0 +1,56 @@
+/*
+ * power_fail.h
+ *
+ *  전원 저하(시동 끔) 감지 + last gasp 저장
+ *  - PVD: VDD가 POWER_FAIL_PVD_LEVEL 아래로 내려가면 인터럽트
+ *  - ISR 안에서 바로: 화면 shutdown(LED 전류) → GPS 수신 중단 → 밀린 트립 값 저장
+ *    (설정 로그에 미리 비워 둔 예약 슬롯, erase 없음) → 궤적 RAM 블록 쓰기 → 수신기 백업 모드
+ *  - 단계별 시간은 DWT로 재서 PowerFail_GetStats, 최악값은 설정 키
+ *    SETTINGS_KEY_LASTGASP_MAX_US로 남겨 다음 부팅에서 확인 (홀드업 예산 확인용)
+ *  - 전압이 다시 올라오면(크랭킹 등 순간 저하) 리셋해서 처음부터
+ *  - 메인 문맥의 섹터 erase(1~2초) 도중에는 벡터 테이블도 플래시라 ISR이 erase가 끝나야 들어옴
+ *    → erase 구간을 PowerFail_EraseBegin/End로 알려 주면 그 지연까지 예산에 넣고,
+ *      ISR에서 플래시가 아직 BSY면 저장은 건너뜀
+ */
+
+#ifndef INC_POWER_FAIL_H_
+#define INC_POWER_FAIL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 2.9 V: 워드(x32) 플래시 쓰기 하한 2.7 V까지의 여유가 가장 큼
+#define POWER_FAIL_PVD_LEVEL    PWR_PVDLEVEL_7
+#define POWER_FAIL_BUDGET_US    2000u    // 홀드업 커패시터로 버틸 수 있는 시간 (보드 실측으로 조정)
+#define POWER_FAIL_RECOVER_MS   20u      // VDD가 이만큼 계속 정상이면 리셋
+
+typedef struct
+{
+    uint32_t count;              // 이번 전원에서 last gasp 실행 횟수
+    uint32_t erase_latency_us;   // erase 시작 → ISR 진입 (erase 도중이 아니었으면 0)
+    uint32_t display_us;         // 시작 → 화면/UART 정지까지
+    uint32_t flush_us;           // 시작 → 트립/궤적 저장까지
+    uint32_t total_us;           // 시작 → 수신기 백업 명령까지
+    uint8_t  erase_in_progress;  // 메인 문맥의 섹터 erase 도중에 전압이 떨어짐
+    uint8_t  flash_skipped;      // 플래시가 BSY라 트립/궤적 저장을 건너뜀
+    uint8_t  over_budget;        // erase_latency_us + total_us > POWER_FAIL_BUDGET_US
+} power_fail_stats_t;
+
+// 설정/트립 복원(TripStore_Init) 뒤 1회
+void PowerFail_Init(void);
+
+// 블로킹 섹터 erase 앞뒤 (settings_storage / track_log)
+void PowerFail_EraseBegin(void);
+void PowerFail_EraseEnd(void);
+
+const power_fail_stats_t *PowerFail_GetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_POWER_FAIL_H_ */
@@ -0,0 +1,247 @@
+// power_mgr.c
+#include "power_mgr.h"
+#include "main.h"
+#include "gps_ubx.h"
+#include "disp_bright.h"
+#include "key_input.h"
+#include "clock_profile.h"
+
+extern TIM_HandleTypeDef htim5;
+#if POWER_STOP_MODE_ENABLED
+extern RTC_HandleTypeDef hrtc;
+#endif
+
+// ----------------- 설정 -----------------
+#define POWER_PARK_TIMEOUT_MS     (POWER_PARK_TIMEOUT_MIN * 60000u)
+#define POWER_DISPLAY_FADE_MS     1000u    // 주차 진입 시 화면 페이드 아웃
+#define POWER_RESTORE_FADE_MS     300u     // 복구 시 페이드 인
+#define POWER_TICK_STOP_DELAY_MS  100u     // 페이드 끝나고 shutdown 명령이 나갈 여유
+
+#define POWER_RX_QUIET_MS         5u       // 이만큼 UART가 조용하면 epoch 버스트 끝
+#define POWER_STOP_GUARD_MS       80u      // 다음 epoch보다 이만큼 먼저 깸 (LSI 오차 + 지터)
+#define POWER_STOP_MIN_MS         50u      // 이보다 짧으면 STOP 안 하고 WFI로
+
+// RTC wakeup 클럭 = LSI / 16 (공칭 2 kHz). LSI는 17~47 kHz로 흩어져 있어서
+// 주차 진입 때마다 SysTick으로 한 번 재고, 주차 중에도 가끔 다시 잰다.
+#define POWER_LSI_CAL_COUNTS      2000u    // 공칭 1초
+#define POWER_LSI_RECAL_MS        600000u  // 10분마다 재보정
+
+// ----------------- 상태 -----------------
+static power_state_t s_state       = POWER_STATE_ACTIVE;
+static uint8_t       s_changed     = 0u;
+
+static uint32_t s_still_since_ms   = 0u;   // 마지막으로 움직였거나 버튼 누른 시각
+static uint32_t s_last_fix_ms      = 0u;
+static uint8_t  s_fix_fresh        = 0u;   // 마지막 STOP 이후 새 epoch이 왔는지
+
+static uint32_t s_park_ms          = 0u;
+static uint16_t s_saved_level      = 0u;   // 주차 직전 밝기 (복구용)
+static clock_profile_t s_saved_clock = CLOCK_PROFILE_MID;
+static uint8_t  s_tick_stopped     = 0u;   // TIM5 정지 여부
+
+#if POWER_STOP_MODE_ENABLED
+static volatile uint8_t  s_rtc_fired    = 0u;
+static volatile uint32_t s_rtc_fired_ms = 0u;
+
+static uint8_t  s_cal_running      = 0u;
+static uint32_t s_cal_start_ms     = 0u;
+static uint32_t s_cal_done_ms      = 0u;
+static uint32_t s_rtc_hz           = 0u;   // 0 = 아직 보정 전 (STOP 안 함)
+#endif
+
+// ----------------- RTC wakeup -----------------
+#if POWER_STOP_MODE_ENABLED
+void HAL_RTCEx_WakeUpTimerEventCallback(RTC_HandleTypeDef *h)
+{
+    (void)h;
+    s_rtc_fired_ms = HAL_GetTick();
+    s_rtc_fired    = 1u;
+}
+
+static void power_cal_start(uint32_t now_ms)
+{
+    s_rtc_fired    = 0u;
+    s_cal_start_ms = now_ms;
+    if (HAL_RTCEx_SetWakeUpTimer_IT(&hrtc, POWER_LSI_CAL_COUNTS - 1u,
+                                    RTC_WAKEUPCLOCK_RTCCLK_DIV16) == HAL_OK) {
+        s_cal_running = 1u;
+    }
+}
+
+static void power_cal_poll(void)
+{
+    if (!s_cal_running || !s_rtc_fired) {
+        return;
+    }
+    HAL_RTCEx_DeactivateWakeUpTimer(&hrtc);
+    s_cal_running = 0u;
+
+    uint32_t elapsed = s_rtc_fired_ms - s_cal_start_ms;
+    if (elapsed > 0u) {
+        s_rtc_hz = (POWER_LSI_CAL_COUNTS * 1000u) / elapsed;
+    }
+    s_cal_done_ms = s_rtc_fired_ms;
+}
+
+// sleep_ms 동안 STOP. RTC wakeup 또는 버튼(EXTI0)으로만 깬다.
+static void power_stop_for(uint32_t sleep_ms)
+{
+    uint32_t counts = (sleep_ms * s_rtc_hz) / 1000u;
+    if (counts < 2u) {
+        return;
+    }
+    if (counts > 0xFFFFu) {
+        counts = 0xFFFFu;
+    }
+
+    s_rtc_fired = 0u;
+    if (HAL_RTCEx_SetWakeUpTimer_IT(&hrtc, counts - 1u,
+                                    RTC_WAKEUPCLOCK_RTCCLK_DIV16) != HAL_OK) {
+        return;
+    }
+
+    HAL_SuspendTick();
+    // 대기 중이던 다른 인터럽트(TIM3 등)로 깨면 그대로 다시 잠듦
+    while (!s_rtc_fired && !Key_IsPressedRaw()) {
+        HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
+    }
+    HAL_ResumeTick();
+
+    // STOP에서 깨면 HSI 16 MHz → 지금 프로파일로 복구 (SysTick도 다시 설정됨)
+    ClockProfile_RestoreAfterStop();
+    HAL_RTCEx_DeactivateWakeUpTimer(&hrtc);
+
+    // 자는 동안 SysTick이 멈춰 있었으니 HAL 시간축을 밀어 줌
+    // (버튼으로 깬 경우는 길이를 모르므로 그대로 → 곧 ACTIVE로 복구됨)
+    if (s_rtc_fired) {
+        uwTick += (counts * 1000u) / s_rtc_hz;
+    }
+}
+#endif
+
+// ----------------- 상태 전환 -----------------
+static void power_enter_park(uint32_t now_ms)
+{
+    s_state        = POWER_STATE_PARKED;
+    s_changed      = 1u;
+    s_park_ms      = now_ms;
+    s_tick_stopped = 0u;
+    s_fix_fresh    = 0u;
+
+    s_saved_level = DispBright_GetTarget();
+    DispBright_SetTarget(0u, POWER_DISPLAY_FADE_MS);
+
+    // 1 Hz fix 하나 처리하는 데는 HSI 16 MHz로 충분
+    s_saved_clock = ClockProfile_GetSteady();
+    ClockProfile_SetSteady(CLOCK_PROFILE_LOW);
+
+    GPS_UBX_SetPowerMode(GPS_POWER_SAVE);
+
+#if POWER_STOP_MODE_ENABLED
+    power_cal_start(now_ms);
+#endif
+}
+
+static void power_leave_park(uint32_t now_ms)
+{
+#if POWER_STOP_MODE_ENABLED
+    if (s_cal_running) {
+        HAL_RTCEx_DeactivateWakeUpTimer(&hrtc);
+        s_cal_running = 0u;
+    }
+#endif
+
+    ClockProfile_SetSteady(s_saved_clock);
+    GPS_UBX_SetPowerMode(GPS_POWER_CONTINUOUS);
+
+    if (s_tick_stopped) {
+        HAL_TIM_Base_Start_IT(&htim5);
+        s_tick_stopped = 0u;
+    }
+    DispBright_SetTarget(s_saved_level, POWER_RESTORE_FADE_MS);
+
+    s_state          = POWER_STATE_ACTIVE;
+    s_changed        = 1u;
+    s_still_since_ms = now_ms;
+}
+
+// ----------------- API -----------------
+void PowerMgr_Init(void)
+{
+    uint32_t now = HAL_GetTick();
+
+    s_state          = POWER_STATE_ACTIVE;
+    s_changed        = 0u;
+    s_still_since_ms = now;
+    s_last_fix_ms    = now;
+    s_fix_fresh      = 0u;
+    s_tick_stopped   = 0u;
+}
+
+void PowerMgr_OnFix(const app_gps_state_t *gps, uint32_t now_ms)
+{
+    s_last_fix_ms = now_ms;
+    s_fix_fresh   = 1u;
+
+    float limit = (s_state == POWER_STATE_PARKED) ? POWER_WAKE_SPEED_KMH
+                                                  : POWER_PARK_SPEED_KMH;
+    // fix가 없으면(지하 주차장 등) 서 있는 것으로 본다
+    if (gps->valid && gps->speed_kmh >= limit) {
+        s_still_since_ms = now_ms;
+        if (s_state == POWER_STATE_PARKED) {
+            power_leave_park(now_ms);
+        }
+    }
+}
+
+void PowerMgr_NoteActivity(uint32_t now_ms)
+{
+    s_still_since_ms = now_ms;
+    if (s_state == POWER_STATE_PARKED) {
+        power_leave_park(now_ms);
+    }
+}
+
+bool PowerMgr_Process(uint32_t now_ms)
+{
+    if (s_state == POWER_STATE_ACTIVE) {
+        if ((now_ms - s_still_since_ms) >= POWER_PARK_TIMEOUT_MS) {
+            power_enter_park(now_ms);
+        }
+    } else {
+        // 페이드 아웃이 끝나면 2 kHz 밝기 틱도 멈춤 (안 그러면 STOP/WFI를 계속 깨움)
+        if (!s_tick_stopped &&
+            !DispBright_IsFading() && DispBright_GetLevel() == 0u &&
+            (now_ms - s_park_ms) >= (POWER_DISPLAY_FADE_MS + POWER_TICK_STOP_DELAY_MS)) {
+            HAL_TIM_Base_Stop_IT(&htim5);
+            s_tick_stopped = 1u;
+        }
+
+#if POWER_STOP_MODE_ENABLED
+        power_cal_poll();
+        if (!s_cal_running && (now_ms - s_cal_done_ms) >= POWER_LSI_RECAL_MS) {
+            power_cal_start(now_ms);
+        }
+
+        // epoch 버스트를 다 받은 직후에만, 다음 epoch 직전까지 STOP
+        if (s_tick_stopped && !s_cal_running && s_rtc_hz != 0u && s_fix_fresh &&
+            (now_ms - GPS_UBX_GetLastRxMs()) >= POWER_RX_QUIET_MS) {
+            uint32_t since_fix = now_ms - s_last_fix_ms;
+
+            s_fix_fresh = 0u;
+            if ((since_fix + POWER_STOP_GUARD_MS + POWER_STOP_MIN_MS) <= GPS_PSM_RATE_MS) {
+                power_stop_for(GPS_PSM_RATE_MS - since_fix - POWER_STOP_GUARD_MS);
+            }
+        }
+#endif
+    }
+
+    bool changed = (s_changed != 0u);
+    s_changed = 0u;
+    return changed;
+}
+
+power_state_t PowerMgr_GetState(void)
+{
+    return s_state;
+}
@@ -0,0 +1,57 @@
+/*
+ * power_mgr.h
+ *
+ *  주차 절전 관리
+ *  - 주행 중: 스케줄러가 할 일 없을 때 WFI (sched.c) → 여기서는 정차 시간만 잰다.
+ *  - 속도 ≈ 0 이 POWER_PARK_TIMEOUT_MIN 분 이어지면 PARKED:
+ *      화면 페이드 아웃 → MAX7219 shutdown, TIM5(2 kHz 밝기 틱) 정지
+ *      수신기 1 Hz + power save (GPS_UBX_SetPowerMode)
+ *      epoch 사이에는 STOP 모드, 다음 epoch 직전에 RTC wakeup으로 깸
+ *  - 움직임이 잡히거나 버튼을 누르면 그 epoch 안에 전부 원래대로
+ */
+
+#ifndef INC_POWER_MGR_H_
+#define INC_POWER_MGR_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "gps_app.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// STOP 모드 사용 여부 (0이면 PARKED에서도 WFI 슬립까지만)
+#ifndef POWER_STOP_MODE_ENABLED
+#define POWER_STOP_MODE_ENABLED   1
+#endif
+
+#define POWER_PARK_TIMEOUT_MIN    5u       // 이만큼 서 있으면 PARKED
+#define POWER_PARK_SPEED_KMH      3.0f     // 이 아래면 "서 있음"
+#define POWER_WAKE_SPEED_KMH      6.0f     // PARKED에서 이 이상이면 출발 (히스테리시스)
+
+typedef enum
+{
+    POWER_STATE_ACTIVE = 0,
+    POWER_STATE_PARKED
+} power_state_t;
+
+void PowerMgr_Init(void);
+
+// 새 GPS epoch마다 (Task_GPS에서 APP_GPS_Update 직후)
+void PowerMgr_OnFix(const app_gps_state_t *gps, uint32_t now_ms);
+
+// 버튼 등 사용자 입력: 정차 타이머 리셋, PARKED면 바로 복구
+void PowerMgr_NoteActivity(uint32_t now_ms);
+
+// 주기적으로 호출. PARKED에서는 여기서 다음 epoch까지 STOP으로 잠들 수 있음
+// 상태가 바뀌었으면 true (→ 화면 태스크 on/off)
+bool PowerMgr_Process(uint32_t now_ms);
+
+power_state_t PowerMgr_GetState(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_POWER_MGR_H_ */
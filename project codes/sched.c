@@ -0,0 +1,181 @@
+// sched.c
+#include "sched.h"
+#include "main.h"
+#include <string.h>
+
+// ----------------- 상태 -----------------
+typedef struct
+{
+    uint8_t            enabled;
+    uint32_t           next_due_ms;
+    sched_task_stats_t stats;
+} sched_task_state_t;
+
+static const sched_task_desc_t *s_tasks = NULL;
+static uint8_t                  s_task_count = 0u;
+static sched_task_state_t       s_state[SCHED_MAX_TASKS];
+
+static volatile uint32_t s_events       = 0u;
+static volatile uint32_t s_first_post_ms = 0u;   // 비어 있던 이벤트가 처음 세워진 시각
+
+static uint32_t s_cycles_per_us = 1u;
+static uint32_t s_busy_us       = 0u;   // Sched_TakeBusyUs 이후 누적
+
+// ----------------- 사이클 카운터 -----------------
+static void sched_cyccnt_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0u;
+    DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+
+    Sched_OnClockChange();
+}
+
+void Sched_OnClockChange(void)
+{
+    s_cycles_per_us = SystemCoreClock / 1000000u;
+    if (s_cycles_per_us == 0u) {
+        s_cycles_per_us = 1u;
+    }
+}
+
+// ----------------- API -----------------
+void Sched_Init(const sched_task_desc_t *tasks, uint8_t count)
+{
+    if (count > SCHED_MAX_TASKS) {
+        count = SCHED_MAX_TASKS;
+    }
+
+    s_tasks      = tasks;
+    s_task_count = count;
+    memset(s_state, 0, sizeof(s_state));
+
+    uint32_t now = HAL_GetTick();
+    for (uint8_t i = 0u; i < count; ++i) {
+        s_state[i].enabled     = 1u;
+        s_state[i].next_due_ms = now;
+    }
+
+    sched_cyccnt_init();
+}
+
+void Sched_Post(uint32_t events)
+{
+    __disable_irq();
+    if (s_events == 0u) {
+        s_first_post_ms = HAL_GetTick();
+    }
+    s_events |= events;
+    __enable_irq();
+}
+
+void Sched_SetEnabled(uint8_t task, bool enabled)
+{
+    if (task >= s_task_count) {
+        return;
+    }
+    s_state[task].enabled     = enabled ? 1u : 0u;
+    s_state[task].next_due_ms = HAL_GetTick();
+}
+
+const sched_task_stats_t *Sched_GetStats(uint8_t task)
+{
+    if (task >= s_task_count) {
+        return NULL;
+    }
+    return &s_state[task].stats;
+}
+
+uint32_t Sched_TakeBusyUs(void)
+{
+    uint32_t us = s_busy_us;
+    s_busy_us = 0u;
+    return us;
+}
+
+uint32_t Sched_GetTotalOverruns(void)
+{
+    uint32_t sum = 0u;
+    for (uint8_t i = 0u; i < s_task_count; ++i) {
+        sum += s_state[i].stats.overruns;
+    }
+    return sum;
+}
+
+// 주기 태스크 중 이미 때가 된 것이 있는지
+static bool sched_any_due(uint32_t now)
+{
+    for (uint8_t i = 0u; i < s_task_count; ++i) {
+        if (s_state[i].enabled && s_tasks[i].period_ms != 0u &&
+            (int32_t)(now - s_state[i].next_due_ms) >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Sched_RunOnce(void)
+{
+    uint32_t now = HAL_GetTick();
+
+    // 이벤트는 한 번에 가져가고 비움 (실행 중 들어온 건 다음 바퀴)
+    __disable_irq();
+    uint32_t events  = s_events;
+    uint32_t post_ms = s_first_post_ms;
+    s_events = 0u;
+    __enable_irq();
+
+    for (uint8_t i = 0u; i < s_task_count; ++i) {
+        const sched_task_desc_t *t  = &s_tasks[i];
+        sched_task_state_t      *st = &s_state[i];
+
+        if (!st->enabled) {
+            continue;
+        }
+
+        uint32_t mine = events & t->events;
+        bool     due  = (t->period_ms != 0u) &&
+                        ((int32_t)(now - st->next_due_ms) >= 0);
+
+        if (mine == 0u && !due) {
+            continue;
+        }
+
+        if (due) {
+            st->next_due_ms += t->period_ms;
+            // 한참 밀렸으면 따라잡기 대신 지금부터 다시
+            if ((int32_t)(now - st->next_due_ms) >= 0) {
+                st->next_due_ms = now + t->period_ms;
+            }
+        }
+
+        if (mine != 0u) {
+            uint32_t lat = now - post_ms;
+            if (lat > st->stats.max_latency_ms) {
+                st->stats.max_latency_ms = lat;
+            }
+        }
+
+        uint32_t c0 = DWT->CYCCNT;
+        t->fn(now, mine);
+        uint32_t us = (DWT->CYCCNT - c0) / s_cycles_per_us;
+
+        s_busy_us += us;
+        st->stats.runs++;
+        st->stats.last_us = us;
+        if (us > st->stats.max_us) {
+            st->stats.max_us = us;
+        }
+        if (t->budget_us != 0u && us > t->budget_us) {
+            st->stats.overruns++;
+        }
+    }
+
+    // 할 일이 없으면 다음 인터럽트(SysTick 1 ms / UART / TIM)까지 슬립
+    // (PRIMASK=1 상태에서도 WFI는 인터럽트로 깨어나므로 검사~슬립 사이 경합 없음)
+    __disable_irq();
+    if (s_events == 0u && !sched_any_due(HAL_GetTick())) {
+        __WFI();
+    }
+    __enable_irq();
+}
@@ -0,0 +1,74 @@
+/*
+ * sched.h
+ *
+ *  메인 루프용 run-to-completion 스케줄러
+ *  - ISR은 Sched_Post()로 이벤트 비트만 세우고, 실제 일은 태스크가 메인 문맥에서 처리
+ *  - 태스크는 (구독 이벤트가 왔거나) (주기가 됐을 때) 표 순서대로 한 번씩 실행
+ *  - 할 일이 없으면 WFI로 다음 인터럽트까지 슬립
+ *  - 태스크별 실행 시간(DWT 사이클)과 이벤트→실행 지연을 기록, 예산 초과 횟수 카운트
+ */
+
+#ifndef INC_SCHED_H_
+#define INC_SCHED_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SCHED_MAX_TASKS        8u
+
+// 이벤트 비트 (ISR에서 Sched_Post 가능)
+#define SCHED_EV_GPS_FIX       (1u << 0)   // UBX 파서가 새 fix를 publish
+#define SCHED_EV_KEY           (1u << 1)   // 키 입력 변화
+#define SCHED_EV_TICK_100MS    (1u << 2)   // TIM3 100 ms
+#define SCHED_EV_FRAME         (1u << 3)   // 그릴 프레임이 남아 있음
+#define SCHED_EV_KEY_EDGE      (1u << 4)   // 버튼 EXTI 엣지 (key_input)
+
+typedef void (*sched_task_fn_t)(uint32_t now_ms, uint32_t events);
+
+typedef struct
+{
+    const char      *name;
+    sched_task_fn_t  fn;
+    uint32_t         events;      // 깨어날 이벤트 비트
+    uint16_t         period_ms;   // 0 = 이벤트로만 실행
+    uint16_t         budget_us;   // 1회 실행 예산 (넘으면 overruns++)
+} sched_task_desc_t;
+
+typedef struct
+{
+    uint32_t runs;
+    uint32_t overruns;
+    uint32_t last_us;
+    uint32_t max_us;
+    uint32_t max_latency_ms;      // 이벤트 post → 실행 시작 최대 지연
+} sched_task_stats_t;
+
+// tasks 표는 프로그램 끝까지 살아 있어야 함 (const 전역 권장)
+void Sched_Init(const sched_task_desc_t *tasks, uint8_t count);
+
+void Sched_Post(uint32_t events);
+void Sched_SetEnabled(uint8_t task, bool enabled);
+
+// 준비된 태스크를 한 바퀴 실행. 아무것도 없으면 WFI
+void Sched_RunOnce(void);
+
+const sched_task_stats_t *Sched_GetStats(uint8_t task);
+
+// 마지막 호출 이후 태스크 실행에 쓴 시간 합 [us] (읽으면서 0으로)
+uint32_t Sched_TakeBusyUs(void);
+
+// 모든 태스크 overruns 합 (예산 초과 = 데드라인 놓침)
+uint32_t Sched_GetTotalOverruns(void);
+
+// SYSCLK이 바뀌었을 때 (clock_profile) 사이클 → us 환산 갱신
+void Sched_OnClockChange(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_SCHED_H_ */
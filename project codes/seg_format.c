@@ -0,0 +1,96 @@
+// seg_format.c
+#include "seg_format.h"
+#include <max7219.h>
+
+// v / 10 (Cortex-M4: UMULL 1회, 전 uint32 범위에서 정확)
+static inline uint32_t segfmt_div10(uint32_t v)
+{
+    return (uint32_t)(((uint64_t)v * 0xCCCCCCCDull) >> 35);
+}
+
+// width 자리로 표현 가능한 최대값
+static const uint32_t s_segfmt_limit[SEGFMT_MAX_WIDTH + 1u] = {
+    0u, 9u, 99u, 999u, 9999u, 99999u, 999999u, 9999999u, 99999999u, 999999999u
+};
+
+void SegFmt_Unsigned(uint8_t *out, uint8_t width, uint32_t value,
+                     uint8_t decimals, uint32_t max, uint8_t flags)
+{
+    if (out == NULL || width == 0u) {
+        return;
+    }
+    if (width > SEGFMT_MAX_WIDTH) {
+        width = SEGFMT_MAX_WIDTH;
+    }
+
+    uint32_t limit = s_segfmt_limit[width];
+    if (max < limit) {
+        limit = max;
+    }
+
+    if (value > limit) {
+        if (flags & SEGFMT_OVF_MARK) {
+            for (uint8_t i = 0u; i < width; ++i) {
+                out[i] = SEGFMT_SEG_OVF;
+            }
+            return;
+        }
+        value = limit;
+    }
+
+    uint8_t dp_index = (flags & SEGFMT_DP_LAST) ? (uint8_t)(width - 1u)
+                     : (decimals > 0u && decimals < width) ? (uint8_t)(width - 1u - decimals)
+                     : 0xFFu;
+
+    // 정수부 1자리 + 소수부는 항상 표시, ZERO_PAD면 전 자리 표시
+    uint8_t always = (flags & SEGFMT_ZERO_PAD) ? width : (uint8_t)(decimals + 1u);
+
+    // 오른쪽(낮은 자리)부터: 자리마다 div10 1회 + 테이블 1회
+    for (uint8_t nth = 0u; nth < width; ++nth) {
+        uint8_t  idx = (uint8_t)(width - 1u - nth);
+        uint32_t q   = segfmt_div10(value);
+        uint8_t  d   = (uint8_t)(value - q * 10u);
+
+        // 남은 값이 있거나 항상 표시 자리면 0xFF, 아니면 0x00 (리딩 제로 → 공백)
+        uint8_t show = (uint8_t)-(uint8_t)((value != 0u) | (nth < always));
+
+        out[idx] = (uint8_t)((MAX7219_FONT_ASCII['0' + d] & show) |
+                             ((idx == dp_index) ? MAX7219_SEG_DP : 0x00u));
+        value = q;
+    }
+}
+
+void SegFmt_Signed(uint8_t *out, uint8_t width, int32_t value,
+                   uint8_t decimals, uint32_t max, uint8_t flags)
+{
+    if (out == NULL || width < 2u) {
+        return;
+    }
+
+    uint32_t mag = (value < 0) ? (uint32_t)(-(int64_t)value) : (uint32_t)value;
+
+    // 0은 부호 없이 표시
+    out[0] = (value < 0 && mag != 0u) ? SEGFMT_SEG_MINUS : 0x00u;
+    SegFmt_Unsigned(&out[1], (uint8_t)(width - 1u), mag, decimals, max, flags);
+}
+
+void SegFmt_Text(uint8_t *out, uint8_t width, const char *s)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    for (uint8_t i = 0u; i < width; ++i) {
+        char ch = ' ';
+        bool dp = false;
+
+        if (s != NULL && *s != '\0') {
+            ch = *s++;
+            if (*s == '.') {
+                dp = true;
+                s++;
+            }
+        }
+        out[i] = (uint8_t)(max7219_SegFromChar(ch) | (dp ? MAX7219_SEG_DP : 0x00u));
+    }
+}
@@ -0,0 +1,47 @@
+/*
+ * seg_format.h
+ *
+ *  7-seg 숫자/문자열 → 세그먼트 코드 변환 (정수 연산만 사용)
+ *  - snprintf / float 없이 MAX7219 프레임버퍼용 세그먼트 바이트를 바로 만든다.
+ *  - out[0]이 가장 왼쪽 자리.
+ */
+
+#ifndef INC_SEG_FORMAT_H_
+#define INC_SEG_FORMAT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SEGFMT_MAX_WIDTH   9u      // uint32 10진 9자리까지
+
+// flags
+#define SEGFMT_ZERO_PAD    0x01u   // 리딩 제로 유지 (시각/날짜)
+#define SEGFMT_DP_LAST     0x02u   // 마지막 자리에 DP (YYYY. MM.)
+#define SEGFMT_OVF_MARK    0x04u   // max 초과 시 클램프 대신 윗줄(‾) 표시
+
+#define SEGFMT_SEG_MINUS   0x01u   // g
+#define SEGFMT_SEG_OVF     0x40u   // a
+
+// width 자리 우측 정렬, 소수 decimals 자리 앞에 DP
+//  - 정수부는 최소 1자리(0.x) 표시, 그 앞 리딩 제로는 공백 (ZERO_PAD면 유지)
+//  - value > max 이면 max로 클램프 (OVF_MARK면 전 자리 오버플로 표시)
+void SegFmt_Unsigned(uint8_t *out, uint8_t width, uint32_t value,
+                     uint8_t decimals, uint32_t max, uint8_t flags);
+
+// 첫 자리 부호('-' 또는 공백) + 나머지 width-1 자리 SegFmt_Unsigned
+void SegFmt_Signed(uint8_t *out, uint8_t width, int32_t value,
+                   uint8_t decimals, uint32_t max, uint8_t flags);
+
+// 문자열 왼쪽 정렬 ('.'은 앞 글자 DP, 남는 자리는 공백, NULL이면 전부 공백)
+void SegFmt_Text(uint8_t *out, uint8_t width, const char *s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_SEG_FORMAT_H_ */
@@ -1,200 +1,693 @@
-/* settings_storage.c */
-
-#include "settings_storage.h"
-#include "main.h"
-#include <string.h>
-#include <stddef.h>
-
-/* 아무 의미 없는 매직 값 (레코드 식별용) */
-#define SETTINGS_MAGIC               (0x43504647u)  /* 'G','F','P','C' 같은 느낌 */
-
-/* STM32F411CEU6 (512KB Flash)
- * Sector 0: 0x08000000, 16KB
- * ...
- * Sector 4: 0x08010000, 64KB
- * Sector 5: 0x08020000, 128KB
- * Sector 6: 0x08040000, 128KB
- * Sector 7: 0x08060000, 128KB
- *
- * => 끝부분 3섹터 = 5,6,7 사용 (총 384KB)
- */
-#define SETTINGS_FLASH_BASE          (0x08020000u)  /* Sector 5 시작 */
-#define SETTINGS_FLASH_END           (0x08080000u)  /* Flash 끝 주소 (exclusive) */
-
-#define SETTINGS_FLASH_SECTOR_FIRST  FLASH_SECTOR_5
-#define SETTINGS_FLASH_SECTOR_COUNT  (3u)           /* 5,6,7 섹터 사용 */
-
-typedef struct {
-    uint32_t       magic;
-    uint32_t       seq;
-    app_settings_t payload;
-    uint32_t       crc32;
-} settings_record_t;
-
-#define SETTINGS_RECORD_SIZE   (sizeof(settings_record_t))
-
-/* CRC32 (Ethernet 폴리노미얼) */
-static uint32_t crc32_calc(const uint8_t *data, size_t len)
-{
-    uint32_t crc = 0xFFFFFFFFu;
-    for (size_t i = 0; i < len; ++i) {
-        crc ^= (uint32_t)data[i];
-        for (uint32_t bit = 0; bit < 8u; ++bit) {
-            uint32_t mask = (uint32_t)-(int32_t)(crc & 1u);
-            crc = (crc >> 1) ^ (0xEDB88320u & mask);
-        }
-    }
-    return ~crc;
-}
-
-/* 플래시 영역을 스캔해서
- *  - 마지막으로 유효한 레코드의 seq, 주소
- *  - 다음에 쓸 수 있는 빈 슬롯 주소
- * 를 찾는다. (웨어 레벨링용 로그 스캔)
- */
-static bool settings_scan(uint32_t *out_last_seq,
-                          uint32_t *out_last_addr,
-                          uint32_t *out_next_free_addr)
-{
-    uint32_t last_seq      = 0u;
-    uint32_t last_addr     = 0u;
-    bool     have_last     = false;
-
-    uint32_t addr = SETTINGS_FLASH_BASE;
-    const uint32_t end = SETTINGS_FLASH_END;
-
-    while ((addr + SETTINGS_RECORD_SIZE) <= end) {
-        const settings_record_t *rec = (const settings_record_t *)addr;
-
-        uint32_t magic = rec->magic;
-
-        /* 플래시 erase 상태: 0xFFFFFFFF...
-         * 첫 번째 지워진 슬롯을 만나면 그 뒤는 전부 빈 영역이라고 가정
-         */
-        if (magic == 0xFFFFFFFFu) {
-            break;
-        }
-
-        if (magic != SETTINGS_MAGIC) {
-            addr += SETTINGS_RECORD_SIZE;
-            continue;
-        }
-
-        uint32_t calc_crc = crc32_calc((const uint8_t *)&rec->magic,
-                                       sizeof(settings_record_t) - sizeof(uint32_t));
-        if (calc_crc != rec->crc32) {
-            addr += SETTINGS_RECORD_SIZE;
-            continue;
-        }
-
-        if (!have_last || (rec->seq > last_seq)) {
-            have_last = true;
-            last_seq  = rec->seq;
-            last_addr = addr;
-        }
-
-        addr += SETTINGS_RECORD_SIZE;
-    }
-
-    if (out_last_seq) {
-        *out_last_seq = last_seq;
-    }
-    if (out_last_addr) {
-        *out_last_addr = last_addr;
-    }
-
-    if (out_next_free_addr) {
-        if ((addr + SETTINGS_RECORD_SIZE) <= end) {
-            *out_next_free_addr = addr;
-        } else {
-            *out_next_free_addr = 0u; /* 더 쓸 곳 없음 */
-        }
-    }
-
-    return have_last;
-}
-
-/* 플래시에서 마지막 유효 설정을 읽기 */
-bool Settings_Load(app_settings_t *out)
-{
-    if (!out) {
-        return false;
-    }
-
-    uint32_t last_seq  = 0u;
-    uint32_t last_addr = 0u;
-    uint32_t next_addr = 0u;
-
-    (void)next_addr;
-
-    bool have_last = settings_scan(&last_seq, &last_addr, &next_addr);
-    if (!have_last) {
-        return false;
-    }
-
-    const settings_record_t *rec = (const settings_record_t *)last_addr;
-    *out = rec->payload;
-    return true;
-}
-
-/* 현재 설정을 플래시에 1레코드로 append (웨어 레벨링) */
-bool Settings_Save(const app_settings_t *cfg)
-{
-    if (!cfg) {
-        return false;
-    }
-
-    uint32_t last_seq  = 0u;
-    uint32_t last_addr = 0u;
-    uint32_t next_addr = 0u;
-
-    (void)last_addr;
-    bool have_last = settings_scan(&last_seq, &last_addr, &next_addr);
-
-    uint32_t new_seq = have_last ? (last_seq + 1u) : 1u;
-
-    HAL_FLASH_Unlock();
-
-    /* 더 쓸 수 있는 슬롯이 없으면 3개 섹터 전체를 지우고 처음부터 다시 시작 */
-    if (next_addr == 0u) {
-        FLASH_EraseInitTypeDef erase;
-        uint32_t sector_error = 0u;
-
-        erase.TypeErase    = FLASH_TYPEERASE_SECTORS;
-        erase.Sector       = SETTINGS_FLASH_SECTOR_FIRST;
-        erase.NbSectors    = SETTINGS_FLASH_SECTOR_COUNT;
-        erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
-
-        if (HAL_FLASHEx_Erase(&erase, &sector_error) != HAL_OK) {
-            HAL_FLASH_Lock();
-            return false;
-        }
-
-        next_addr = SETTINGS_FLASH_BASE;
-    }
-
-    /* RAM에서 새 레코드 구성 */
-    /* RAM에서 새 레코드 구성 */
-    settings_record_t rec;
-    memset(&rec, 0xFF, sizeof(rec));  /* 플래시에 맞춰 기본 all-1 (필수는 아님) */
-    rec.magic   = SETTINGS_MAGIC;
-    rec.seq     = new_seq;
-    rec.payload = *cfg;
-    rec.crc32   = crc32_calc((const uint8_t *)&rec.magic,
-                             sizeof(settings_record_t) - sizeof(uint32_t));
-
-    /* 32비트 워드 단위로 프로그래밍 (F4 시리즈) */
-    uint32_t *p_word = (uint32_t *)&rec;
-    uint32_t addr    = next_addr;
-    for (size_t i = 0u; i < (sizeof(settings_record_t) / 4u); ++i) {
-        if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr, p_word[i]) != HAL_OK) {
-            HAL_FLASH_Lock();
-            return false;
-        }
-        addr += 4u;
-    }
-
-
-    HAL_FLASH_Lock();
-    return true;
-}
+/* settings_storage.c */
+
+#include "settings_storage.h"
+#include "main.h"
+#include "clock_profile.h"
+#include "crc32.h"
+#include "power_fail.h"
+#include <string.h>
+#include <stddef.h>
+#include <limits.h>
+
+/* 아무 의미 없는 매직 값 (레코드 식별용) */
+#define SETTINGS_MAGIC               (0x43504647u)  /* 'G','F','P','C' : 예전 통짜 레코드 */
+#define SETTINGS_SLOG_MAGIC          (0x474F4C53u)  /* 'S','L','O','G' : 예전 통짜 레코드 섹터 헤더 */
+#define SETTINGS_KV_MAGIC            (0x31564B53u)  /* 'S','K','V','1' : 키-값 섹터 헤더 */
+
+/* 키 의미/범위가 바뀌면 올림 (헤더에 기록, 다르면 읽은 뒤 settings_migrate → 새 섹터로 정리) */
+#define SETTINGS_SCHEMA_VERSION      (1u)
+
+/* STM32F411CEU6 (512KB Flash)
+ * Sector 0: 0x08000000, 16KB
+ * ...
+ * Sector 4: 0x08010000, 64KB
+ * Sector 5: 0x08020000, 128KB
+ * Sector 6: 0x08040000, 128KB
+ * Sector 7: 0x08060000, 128KB
+ *
+ * => 설정 로그는 5,6 두 섹터를 번갈아 사용 (한쪽이 차면 다른 쪽으로 넘어가고 옛 섹터만 지움)
+ *    (예전 펌웨어는 5,6,7 세 섹터를 한 로그로 썼음 → 처음 부팅 때 한 번 옮겨 옴)
+ *    Sector 7은 이제 궤적 로그 (track_log.c)
+ */
+#define SETTINGS_SECTOR_SIZE         (0x20000u)     /* 5,6 모두 128KB */
+#define SETTINGS_FLASH_SECTOR_COUNT  (2u)
+
+#define SETTINGS_LEGACY_BASE         (0x08020000u)  /* 예전 로그: Sector 5 시작 */
+#define SETTINGS_LEGACY_END          (0x08080000u)  /*           Flash 끝 (exclusive) */
+
+/* 활성 섹터 끝 슬롯 몇 개는 전원 저하 저장용으로 비워 둠 (평소에는 여기 닿기 전에 넘어감) */
+#define SETTINGS_LAST_GASP_SLOTS     (32u)
+
+/* 활성 섹터가 이만큼(%) 차면 주행 중이라도 지울 섹터를 미리 지움 */
+#define SETTINGS_ERASE_FORCE_PCT     (50u)
+
+/* 마지막 체크포인트에서 이만큼 슬롯이 쌓이면 저장된 키 전부를 다시 씀
+ * → 부팅 때 뒤로 읽는 양이 이 정도로 묶임 (쓰기량은 키 수 / 이 값 ≈ 7% 늘어남) */
+#define SETTINGS_CHECKPOINT_SLOTS    (256u)
+
+/* 체크포인트 표시 레코드 tag (value = 뒤따르는 키 비트 마스크) */
+#define SETTINGS_TAG_CHECKPOINT      (0xFEu)
+
+static const uint32_t s_sector_base[SETTINGS_FLASH_SECTOR_COUNT] = { 0x08020000u, 0x08040000u };
+static const uint32_t s_sector_id[SETTINGS_FLASH_SECTOR_COUNT]   = { FLASH_SECTOR_5, FLASH_SECTOR_6 };
+
+/* 섹터 맨 앞 헤더. 레코드를 다 옮겨 쓴 다음 마지막에 씀 (= 이 섹터가 완성됐다는 표시) */
+typedef struct {
+    uint32_t magic;
+    uint32_t gen;        /* 섹터 세대 번호, 넘어갈 때마다 +1 (큰 쪽이 활성) */
+    uint32_t gen_inv;    /* ~gen : 지우다 만 헤더 걸러내기 */
+    uint32_t schema;     /* SETTINGS_SCHEMA_VERSION (KV 섹터만) */
+} settings_sector_hdr_t;
+
+/* 키-값 레코드 (8바이트 고정 → 섹터 안에서 이진 탐색 가능)
+ *  - tag 0x00 / 0xFF 는 안 씀 (0xFF = 지워진 슬롯), 0xFE = 체크포인트 표시
+ *  - value는 len 바이트만 의미 있음 (리틀 엔디안), 나머지는 0xFF
+ */
+typedef struct {
+    uint8_t  tag;
+    uint8_t  len;
+    uint8_t  value[4];
+    uint16_t crc;        /* CRC32(tag ~ value) 하위 16비트 */
+} settings_kv_t;
+
+/* 예전 통짜 레코드 (옮겨 올 때 읽기만) */
+typedef struct {
+    uint32_t       magic;
+    uint32_t       seq;
+    app_settings_t payload;
+    uint32_t       crc32;
+} settings_record_t;
+
+#define SETTINGS_KV_SIZE       (sizeof(settings_kv_t))
+#define SETTINGS_RECORD_SIZE   (sizeof(settings_record_t))
+#define SETTINGS_HDR_SIZE      (sizeof(settings_sector_hdr_t))
+#define SETTINGS_SLOT_COUNT    ((SETTINGS_SECTOR_SIZE - SETTINGS_HDR_SIZE) / SETTINGS_KV_SIZE)
+#define SETTINGS_SLOG_HDR_SIZE (12u)                /* 예전 헤더에는 schema가 없었음 */
+#define SETTINGS_SLOG_SLOTS    ((SETTINGS_SECTOR_SIZE - SETTINGS_SLOG_HDR_SIZE) / SETTINGS_RECORD_SIZE)
+#define SETTINGS_LEGACY_SLOTS  ((SETTINGS_LEGACY_END - SETTINGS_LEGACY_BASE) / SETTINGS_RECORD_SIZE)
+
+#define SETTINGS_NO_SECTOR     (0xFFu)
+
+/* 키별 크기 / 기본값 / 허용 범위 (범위 밖 값이 읽히면 기본값) */
+typedef struct {
+    uint8_t len;
+    uint8_t is_signed;
+    int32_t def;
+    int32_t min;
+    int32_t max;
+} settings_key_desc_t;
+
+static const settings_key_desc_t s_keys[SETTINGS_KEY_COUNT] =
+{
+    [SETTINGS_KEY_TIMEZONE]    = { 1u, 1u, 9, -12, 14 },   /* GMT +9 (한국) */
+    [SETTINGS_KEY_BRIGHTNESS]  = { 1u, 0u, 2,   1,  3 },
+    [SETTINGS_KEY_AUTO_MODE]   = { 1u, 0u, 0,   0,  1 },
+    [SETTINGS_KEY_BEEP_VOLUME] = { 1u, 0u, 4,   0,  4 },
+
+    [SETTINGS_KEY_TRIP_A_DIST_M]    = { 4u, 0u, 0,   0, INT32_MAX },
+    [SETTINGS_KEY_TRIP_A_TIME_S]    = { 4u, 0u, 0,   0, INT32_MAX },
+    [SETTINGS_KEY_TRIP_A_TOP_KMH10] = { 2u, 0u, 0,   0, 4000 },
+    [SETTINGS_KEY_TRIP_B_DIST_M]    = { 4u, 0u, 0,   0, INT32_MAX },
+    [SETTINGS_KEY_TRIP_B_TIME_S]    = { 4u, 0u, 0,   0, INT32_MAX },
+    [SETTINGS_KEY_TRIP_B_TOP_KMH10] = { 2u, 0u, 0,   0, 4000 },
+    [SETTINGS_KEY_ODO_DIST_M]       = { 4u, 0u, 0,   0, INT32_MAX },
+    [SETTINGS_KEY_ODO_TIME_S]       = { 4u, 0u, 0,   0, INT32_MAX },
+    [SETTINGS_KEY_ODO_TOP_KMH10]    = { 2u, 0u, 0,   0, 4000 },
+    [SETTINGS_KEY_TRIP_LAST_UTC_S]  = { 4u, 0u, 0,   0, INT32_MAX },
+    [SETTINGS_KEY_LASTGASP_MAX_US]  = { 4u, 0u, 0,   0, INT32_MAX },
+    [SETTINGS_KEY_TELEM_RATE_HZ]    = { 1u, 0u, 5,   1, 20 },
+    [SETTINGS_KEY_TELEM_MASK]       = { 1u, 0u, 0x3F, 0, 0x3F },
+};
+
+/* 로그 인덱스 (부팅 후 첫 Load/Save 때 한 번 만들고, 이후 append마다 갱신)
+ *  - 활성 섹터 안에서는 앞에서부터 순서대로만 쓰므로 "쓰인 슬롯 → 빈 슬롯" 경계가 하나뿐
+ *    → 경계는 이진 탐색, 키별 최신 값은 경계 바로 앞에서 뒤로 (마지막 완성된 체크포인트까지)
+ */
+typedef struct {
+    uint8_t  built;
+    uint8_t  active;                                     /* 활성 섹터 (SETTINGS_NO_SECTOR = 없음) */
+    uint8_t  dirty_mask;                                 /* 지워야 하는 섹터 비트 */
+    uint32_t active_gen;
+    uint32_t next_free_slot;                             /* 활성 섹터 안 다음 빈 슬롯 */
+    uint32_t checkpoint_slot;                            /* 마지막 체크포인트 표시 슬롯 */
+    uint32_t stored_mask;                                /* 플래시에 값이 있는 키 비트 */
+    int32_t  value[SETTINGS_KEY_COUNT];                  /* 키별 현재 값 (없으면 기본값) */
+    uint32_t sector_used[SETTINGS_FLASH_SECTOR_COUNT];   /* 섹터별 사용 바이트 */
+} settings_index_t;
+
+static settings_index_t s_index;
+static volatile uint8_t s_last_gasp        = 0u;   /* 전원 저하 저장 중 (erase 금지) */
+static uint32_t         s_migrate_src_addr = 0u;   /* 옮겨 올 예전 레코드 위치 */
+
+static uint32_t settings_slot_addr(uint8_t sector, uint32_t slot)
+{
+    return s_sector_base[sector] + SETTINGS_HDR_SIZE + (slot * SETTINGS_KV_SIZE);
+}
+
+/* 지워진 슬롯인지 (tag가 든 첫 워드를 제일 먼저 쓰므로 쓰다 만 레코드도 "쓰인 슬롯") */
+static bool settings_addr_blank(uint32_t addr)
+{
+    return (*(const uint32_t *)addr == 0xFFFFFFFFu);
+}
+
+static uint16_t settings_kv_crc(const settings_kv_t *kv)
+{
+    return (uint16_t)Crc32_Calc(kv, offsetof(settings_kv_t, crc));
+}
+
+static bool settings_key_valid(uint8_t tag)
+{
+    return (tag != 0u && tag < SETTINGS_KEY_COUNT);
+}
+
+static uint32_t settings_kv_raw(const settings_kv_t *kv)
+{
+    uint32_t raw = 0u;
+    for (uint8_t i = 0u; i < kv->len; ++i) {
+        raw |= (uint32_t)kv->value[i] << (8u * i);
+    }
+    return raw;
+}
+
+static int32_t settings_kv_decode(const settings_kv_t *kv)
+{
+    uint32_t raw = settings_kv_raw(kv);
+    /* 부호 있는 키는 부호 확장 */
+    if (s_keys[kv->tag].is_signed && kv->len < 4u && (raw & (1u << ((8u * kv->len) - 1u)))) {
+        raw |= 0xFFFFFFFFu << (8u * kv->len);
+    }
+    return (int32_t)raw;
+}
+
+static bool settings_value_in_range(settings_key_t key, int32_t v)
+{
+    return (v >= s_keys[key].min && v <= s_keys[key].max);
+}
+
+static bool settings_hdr_valid(uint8_t sector, uint32_t magic, uint32_t *out_gen)
+{
+    const settings_sector_hdr_t *h = (const settings_sector_hdr_t *)s_sector_base[sector];
+
+    if (h->magic != magic || h->gen_inv != ~h->gen) {
+        return false;
+    }
+    *out_gen = h->gen;
+    return true;
+}
+
+/* 섹터 전체가 지워진 상태인지 (128KB 읽기, 100 MHz에서 1~2 ms) */
+static bool settings_sector_blank(uint8_t sector)
+{
+    const uint32_t *p   = (const uint32_t *)s_sector_base[sector];
+    const uint32_t *end = p + (SETTINGS_SECTOR_SIZE / 4u);
+
+    for (; p < end; ++p) {
+        if (*p != 0xFFFFFFFFu) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* 활성 섹터 경계로부터 섹터별 사용량 다시 계산 */
+static void settings_index_update_fill(void)
+{
+    for (uint8_t i = 0u; i < SETTINGS_FLASH_SECTOR_COUNT; ++i) {
+        if (i == s_index.active) {
+            s_index.sector_used[i] = SETTINGS_HDR_SIZE + (s_index.next_free_slot * SETTINGS_KV_SIZE);
+        } else if (s_index.dirty_mask & (1u << i)) {
+            s_index.sector_used[i] = SETTINGS_SECTOR_SIZE;
+        } else {
+            s_index.sector_used[i] = 0u;
+        }
+    }
+}
+
+/* [base, base + count * stride) 구간의 첫 빈 슬롯 (이진 탐색, 슬롯 ~1.6만 개 → 14번 정도 읽기) */
+static uint32_t settings_find_boundary(uint32_t base, uint32_t count, uint32_t stride)
+{
+    uint32_t lo = 0u;       /* [0, lo) 는 쓰인 슬롯 */
+    uint32_t hi = count;    /* [hi, N) 는 빈 슬롯 */
+
+    while (lo < hi) {
+        uint32_t mid = lo + ((hi - lo) / 2u);
+        if (settings_addr_blank(base + (mid * stride))) {
+            hi = mid;
+        } else {
+            lo = mid + 1u;
+        }
+    }
+    return lo;
+}
+
+/* 경계 바로 앞부터 뒤로 가며 키별 최신 값 (쓰다 만 / 깨진 레코드는 건너뜀)
+ * 체크포인트 표시를 만났을 때 그 마스크의 키를 뒤쪽에서 다 찾았으면 멈춤
+ *  - 그 앞에만 있는 키는 없음 (저장된 키는 체크포인트에 다 들어 있으므로)
+ *  - 쓰다 끊긴 체크포인트는 키가 모자라서 그냥 지나감 → 한 개 더 앞 체크포인트까지
+ * 체크포인트를 SETTINGS_CHECKPOINT_SLOTS마다 쓰므로 보통 수백 슬롯 이내
+ * (체크포인트가 없는 예전 섹터만 섹터 처음까지) */
+static void settings_replay_kv(uint32_t base, uint32_t boundary)
+{
+    s_index.checkpoint_slot = 0u;
+
+    while (boundary > 0u) {
+        --boundary;
+        const settings_kv_t *kv = (const settings_kv_t *)(base + (boundary * SETTINGS_KV_SIZE));
+        bool is_cp = (kv->tag == SETTINGS_TAG_CHECKPOINT);
+
+        if ((!is_cp && (!settings_key_valid(kv->tag) || (s_index.stored_mask & (1u << kv->tag)))) ||
+            kv->len == 0u || kv->len > 4u || settings_kv_crc(kv) != kv->crc) {
+            continue;   /* 모르는 키(새 펌웨어가 쓴 것)도 여기서 건너뜀 */
+        }
+
+        if (is_cp) {
+            uint32_t mask = settings_kv_raw(kv);
+            if ((s_index.stored_mask & mask) == mask) {
+                s_index.checkpoint_slot = boundary;
+                return;
+            }
+            continue;
+        }
+
+        int32_t v = settings_kv_decode(kv);
+        if (settings_value_in_range((settings_key_t)kv->tag, v)) {
+            s_index.value[kv->tag] = v;
+        }
+        s_index.stored_mask |= (1u << kv->tag);
+    }
+}
+
+/* 예전 통짜 레코드 구간에서 최신 레코드 → 키 값으로 */
+static void settings_load_records(uint32_t base, uint32_t count)
+{
+    uint32_t boundary = settings_find_boundary(base, count, SETTINGS_RECORD_SIZE);
+
+    while (boundary > 0u) {
+        --boundary;
+        uint32_t addr = base + (boundary * SETTINGS_RECORD_SIZE);
+        const settings_record_t *rec = (const settings_record_t *)addr;
+
+        if (rec->magic != SETTINGS_MAGIC ||
+            Crc32_Calc(&rec->magic, sizeof(settings_record_t) - sizeof(uint32_t)) != rec->crc32) {
+            continue;
+        }
+
+        const int32_t v[SETTINGS_KEY_COUNT] = {
+            [SETTINGS_KEY_TIMEZONE]    = rec->payload.timezone_hours,
+            [SETTINGS_KEY_BRIGHTNESS]  = rec->payload.brightness,
+            [SETTINGS_KEY_AUTO_MODE]   = rec->payload.auto_mode,
+            [SETTINGS_KEY_BEEP_VOLUME] = rec->payload.beep_volume,
+        };
+        for (uint8_t k = 1u; k <= SETTINGS_KEY_BEEP_VOLUME; ++k) {   /* 통짜 레코드에 있던 키만 */
+            if (settings_value_in_range((settings_key_t)k, v[k])) {
+                s_index.value[k] = v[k];
+            }
+            s_index.stored_mask |= (1u << k);
+        }
+        s_migrate_src_addr = addr;
+        return;
+    }
+}
+
+/* 헤더의 schema가 지금 펌웨어와 다를 때 키 의미 변환 (v1이 첫 KV 포맷이라 아직 없음)
+ * 여기서 값을 고친 뒤 settings_rotate로 새 schema 섹터에 정리해서 씀 */
+static void settings_migrate(uint32_t from_schema)
+{
+    (void)from_schema;
+}
+
+static bool settings_program(uint32_t addr, const void *data, size_t len)
+{
+    const uint32_t *p_word = (const uint32_t *)data;
+
+    /* 32비트 워드 단위로 프로그래밍 (F4 시리즈) */
+    for (size_t i = 0u; i < (len / 4u); ++i) {
+        if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr, p_word[i]) != HAL_OK) {
+            return false;
+        }
+        addr += 4u;
+    }
+    return true;
+}
+
+/* 섹터 하나 지우기 (128KB: 1~2초, 그동안 플래시에서 도는 코드/인터럽트 전부 멈춤) */
+static bool settings_erase_sector(uint8_t sector)
+{
+    FLASH_EraseInitTypeDef erase;
+    uint32_t sector_error = 0u;
+
+    erase.TypeErase    = FLASH_TYPEERASE_SECTORS;
+    erase.Sector       = s_sector_id[sector];
+    erase.NbSectors    = 1u;
+    erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+
+    HAL_FLASH_Unlock();
+    PowerFail_EraseBegin();
+    bool ok = (HAL_FLASHEx_Erase(&erase, &sector_error) == HAL_OK);
+    PowerFail_EraseEnd();
+    HAL_FLASH_Lock();
+
+    if (ok) {
+        s_index.dirty_mask &= (uint8_t)~(1u << sector);
+        settings_index_update_fill();
+    }
+    return ok;
+}
+
+/* 레코드 하나 append (활성 섹터에 자리가 있어야 함) */
+static bool settings_write_slot(uint8_t tag, uint8_t len, uint32_t raw)
+{
+    settings_kv_t kv;
+    memset(&kv, 0xFF, sizeof(kv));
+    kv.tag = tag;
+    kv.len = len;
+    for (uint8_t i = 0u; i < len; ++i) {
+        kv.value[i] = (uint8_t)(raw >> (8u * i));
+    }
+    kv.crc = settings_kv_crc(&kv);
+
+    /* 메인 문맥이 첫 워드만 쓰고 전원 저하 인터럽트에 끊겼으면 그 슬롯은 건너뜀 */
+    uint32_t addr = settings_slot_addr(s_index.active, s_index.next_free_slot);
+    while (!settings_addr_blank(addr)) {
+        if (++s_index.next_free_slot >= SETTINGS_SLOT_COUNT) {
+            settings_index_update_fill();
+            return false;
+        }
+        addr += SETTINGS_KV_SIZE;
+    }
+
+    const uint32_t *w = (const uint32_t *)&kv;
+
+    HAL_FLASH_Unlock();
+    bool ok = (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr, w[0]) == HAL_OK);
+    /* 첫 워드(tag)가 들어간 뒤에 경계를 옮김 → 여기서 전원이 나가도 쓰인 구간 중간에 빈 슬롯이 안 생김 */
+    s_index.next_free_slot++;
+    settings_index_update_fill();
+    ok = ok && (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr + 4u, w[1]) == HAL_OK);
+    HAL_FLASH_Lock();
+
+    return ok;
+}
+
+static bool settings_write_kv(settings_key_t key, int32_t value)
+{
+    if (!settings_write_slot((uint8_t)key, s_keys[key].len, (uint32_t)value)) {
+        return false;
+    }
+    s_index.value[key]   = value;
+    s_index.stored_mask |= (1u << key);
+    return true;
+}
+
+/* 체크포인트: 표시(저장된 키 마스크) 다음에 저장된 키 전부
+ *  표시를 먼저 쓰므로 중간에 끊기면 표시 뒤에 키가 모자람 → 읽을 때 이 체크포인트는 무시됨 */
+static bool settings_write_checkpoint(void)
+{
+    uint32_t mask = s_index.stored_mask;
+
+    if (!settings_write_slot(SETTINGS_TAG_CHECKPOINT, 4u, mask)) {
+        return false;
+    }
+    s_index.checkpoint_slot = s_index.next_free_slot - 1u;
+
+    for (uint8_t k = 1u; k < SETTINGS_KEY_COUNT; ++k) {
+        if ((mask & (1u << k)) && !settings_write_kv((settings_key_t)k, s_index.value[k])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* 활성 섹터가 없을 때 처음 쓸 섹터: 깨끗한 쪽 우선.
+ * 둘 다 쓰여 있으면(예전 형식) 옮겨 올 레코드가 들어 있지 않은 쪽을 지우고 씀 */
+static uint8_t settings_pick_first(void)
+{
+    for (uint8_t i = 0u; i < SETTINGS_FLASH_SECTOR_COUNT; ++i) {
+        if (!(s_index.dirty_mask & (1u << i))) {
+            return i;
+        }
+    }
+    return (s_migrate_src_addr >= s_sector_base[1] &&
+            s_migrate_src_addr < (s_sector_base[1] + SETTINGS_SECTOR_SIZE)) ? 0u : 1u;
+}
+
+/* 다음 섹터로 넘어가기
+ *  1) 새 섹터가 깨끗한지 확인 (아니면 여기서 지움 = 평소에는 Settings_Process가 미리 해 둠)
+ *  2) 값이 저장돼 있는 키를 전부 새 섹터로 복사 = 체크포인트 (키당 8바이트)
+ *  3) 헤더를 마지막에 씀 → 이 순간부터 새 섹터가 활성
+ *  4) 옛 섹터는 "지울 것"으로만 표시 (실제 erase는 Settings_Process)
+ *  어느 단계에서 전원이 나가도 헤더가 유효한 섹터 중 세대가 큰 쪽에 최신 설정이 있음
+ */
+static bool settings_rotate(void)
+{
+    uint8_t old    = s_index.active;
+    uint8_t target = (old == SETTINGS_NO_SECTOR) ? settings_pick_first()
+                                                 : (uint8_t)((old + 1u) % SETTINGS_FLASH_SECTOR_COUNT);
+
+    if ((s_index.dirty_mask & (1u << target)) || !settings_sector_blank(target)) {
+        s_index.dirty_mask |= (uint8_t)(1u << target);
+        if (!settings_erase_sector(target)) {
+            return false;
+        }
+    }
+
+    s_index.active         = target;
+    s_index.next_free_slot = 0u;
+
+    if (!settings_write_checkpoint()) {
+        s_index.built = 0u;   /* 어디까지 썼는지 모름 → 다음에 다시 스캔 */
+        return false;
+    }
+
+    settings_sector_hdr_t hdr;
+    hdr.magic   = SETTINGS_KV_MAGIC;
+    hdr.gen     = (old == SETTINGS_NO_SECTOR) ? 1u : (s_index.active_gen + 1u);
+    hdr.gen_inv = ~hdr.gen;
+    hdr.schema  = SETTINGS_SCHEMA_VERSION;
+
+    HAL_FLASH_Unlock();
+    bool ok = settings_program(s_sector_base[target], &hdr, sizeof(hdr));
+    HAL_FLASH_Lock();
+    if (!ok) {
+        s_index.built = 0u;
+        return false;
+    }
+
+    s_index.active_gen = hdr.gen;
+    if (old != SETTINGS_NO_SECTOR) {
+        s_index.dirty_mask |= (uint8_t)(1u << old);
+    }
+    settings_index_update_fill();
+    return true;
+}
+
+/* 헤더 magic이 같은 섹터 중 세대가 가장 큰 것 */
+static uint8_t settings_newest_sector(uint32_t magic, uint32_t *out_gen)
+{
+    uint8_t best = SETTINGS_NO_SECTOR;
+
+    for (uint8_t i = 0u; i < SETTINGS_FLASH_SECTOR_COUNT; ++i) {
+        uint32_t gen;
+        if (settings_hdr_valid(i, magic, &gen) &&
+            (best == SETTINGS_NO_SECTOR || gen > *out_gen)) {
+            best     = i;
+            *out_gen = gen;
+        }
+    }
+    return best;
+}
+
+/* 섹터 헤더를 읽어서 인덱스 구성 */
+static void settings_index_build(void)
+{
+    memset(&s_index, 0, sizeof(s_index));
+    s_index.active = settings_newest_sector(SETTINGS_KV_MAGIC, &s_index.active_gen);
+    for (uint8_t k = 1u; k < SETTINGS_KEY_COUNT; ++k) {
+        s_index.value[k] = s_keys[k].def;
+    }
+
+    /* 활성이 아닌 섹터는 머리만 보고 쓰인 흔적이 있으면 "지울 것"
+     * (지우다 만 섹터도 여기 걸림, 넘어가기 직전에 한 번 더 전체 확인) */
+    for (uint8_t i = 0u; i < SETTINGS_FLASH_SECTOR_COUNT; ++i) {
+        if (i != s_index.active &&
+            (!settings_addr_blank(s_sector_base[i]) ||
+             !settings_addr_blank(settings_slot_addr(i, 0u)))) {
+            s_index.dirty_mask |= (uint8_t)(1u << i);
+        }
+    }
+
+    if (s_index.active != SETTINGS_NO_SECTOR) {
+        uint32_t base   = settings_slot_addr(s_index.active, 0u);
+        uint32_t schema = ((const settings_sector_hdr_t *)s_sector_base[s_index.active])->schema;
+
+        s_index.next_free_slot = settings_find_boundary(base, SETTINGS_SLOT_COUNT, SETTINGS_KV_SIZE);
+        settings_replay_kv(base, s_index.next_free_slot);
+        settings_index_update_fill();
+        s_index.built = 1u;
+
+        if (schema != SETTINGS_SCHEMA_VERSION) {
+            settings_migrate(schema);
+            ClockProfile_RequestFull();
+            (void)settings_rotate();
+            ClockProfile_ReleaseFull();
+        }
+        return;
+    }
+
+    /* KV 섹터가 없으면 예전 형식을 찾아서 최신 레코드를 키 값으로 옮김
+     *  - 두 섹터 번갈아 쓰던 통짜 레코드 ('SLOG' 헤더)
+     *  - 그 전의 5,6,7 통짜 로그 (헤더 없이 섹터 5 맨 앞부터 레코드)
+     * 평생 한 번, erase 때문에 부팅이 1~2초 늦어질 수 있음 */
+    uint32_t gen  = 0u;
+    uint8_t  slog = settings_newest_sector(SETTINGS_SLOG_MAGIC, &gen);
+
+    if (slog != SETTINGS_NO_SECTOR) {
+        settings_load_records(s_sector_base[slog] + SETTINGS_SLOG_HDR_SIZE, SETTINGS_SLOG_SLOTS);
+    } else if (*(const uint32_t *)SETTINGS_LEGACY_BASE == SETTINGS_MAGIC) {
+        settings_load_records(SETTINGS_LEGACY_BASE, SETTINGS_LEGACY_SLOTS);
+    }
+
+    s_index.built = 1u;
+    settings_index_update_fill();
+
+    if (s_index.stored_mask != 0u) {
+        ClockProfile_RequestFull();
+        (void)settings_rotate();
+        ClockProfile_ReleaseFull();
+    }
+}
+
+static void settings_index_ensure(void)
+{
+    if (!s_index.built) {
+        settings_index_build();
+    }
+}
+
+/* 값이 바뀐 키만 append */
+static bool settings_set(settings_key_t key, int32_t value)
+{
+    if (!settings_key_valid((uint8_t)key) || !settings_value_in_range(key, value)) {
+        return false;
+    }
+
+    if (s_last_gasp && !s_index.built) {
+        return false;   /* 플래시 훑을 시간 없음 */
+    }
+
+    settings_index_ensure();
+    if ((s_index.stored_mask & (1u << key)) && s_index.value[key] == value) {
+        return true;
+    }
+
+    /* 활성 섹터가 없거나 (예약 슬롯 빼고) 꽉 찼으면 다음 섹터로 */
+    uint32_t limit = s_last_gasp ? SETTINGS_SLOT_COUNT
+                                 : (SETTINGS_SLOT_COUNT - SETTINGS_LAST_GASP_SLOTS);
+    if (s_index.active == SETTINGS_NO_SECTOR || s_index.next_free_slot >= limit) {
+        if (s_last_gasp || !settings_rotate()) {
+            return false;
+        }
+    }
+
+    if (!settings_write_kv(key, value)) {
+        return false;
+    }
+
+    /* 마지막 체크포인트에서 멀어졌으면 다시 (예약 슬롯은 안 건드림, 모자라면 곧 넘어가기가 대신함) */
+    if (!s_last_gasp &&
+        (s_index.next_free_slot - s_index.checkpoint_slot) >= SETTINGS_CHECKPOINT_SLOTS &&
+        (s_index.next_free_slot + SETTINGS_KEY_COUNT) <= limit) {
+        (void)settings_write_checkpoint();
+    }
+    return true;
+}
+
+/* 플래시에서 마지막 유효 설정을 읽기 (저장 안 된 키는 기본값) */
+bool Settings_Load(app_settings_t *out)
+{
+    if (!out) {
+        return false;
+    }
+
+    settings_index_ensure();
+
+    memset(out, 0, sizeof(*out));
+    out->timezone_hours = (int8_t)s_index.value[SETTINGS_KEY_TIMEZONE];
+    out->brightness     = (uint8_t)s_index.value[SETTINGS_KEY_BRIGHTNESS];
+    out->auto_mode      = (uint8_t)s_index.value[SETTINGS_KEY_AUTO_MODE];
+    out->beep_volume    = (uint8_t)s_index.value[SETTINGS_KEY_BEEP_VOLUME];
+
+    return (s_index.stored_mask != 0u);
+}
+
+/* 플래시 쓰기 동안은 FULL 클럭 */
+bool Settings_Save(const app_settings_t *cfg)
+{
+    if (!cfg) {
+        return false;
+    }
+
+    ClockProfile_RequestFull();
+    bool ok = settings_set(SETTINGS_KEY_TIMEZONE, cfg->timezone_hours);
+    ok = settings_set(SETTINGS_KEY_BRIGHTNESS, cfg->brightness) && ok;
+    ok = settings_set(SETTINGS_KEY_AUTO_MODE, cfg->auto_mode) && ok;
+    ok = settings_set(SETTINGS_KEY_BEEP_VOLUME, cfg->beep_volume) && ok;
+    ClockProfile_ReleaseFull();
+
+    return ok;
+}
+
+int32_t Settings_Get(settings_key_t key)
+{
+    if (!settings_key_valid((uint8_t)key)) {
+        return 0;
+    }
+    settings_index_ensure();
+    return s_index.value[key];
+}
+
+/* 키 하나 = 워드 2개 쓰기라 FULL 전환(UART 조용해질 때까지 대기)보다 쌈 → 지금 클럭 그대로 */
+bool Settings_Set(settings_key_t key, int32_t value)
+{
+    return settings_set(key, value);
+}
+
+void Settings_BeginLastGasp(void)
+{
+    s_last_gasp = 1u;
+    /* 메인 문맥에서 쓰다가 끊겼으면 HAL 플래시 락이 잡힌 채일 수 있음
+     * (첫 워드까지 쓰인 슬롯은 settings_write_kv가 보고 건너뜀) */
+    pFlash.Lock = HAL_UNLOCKED;
+}
+
+bool Settings_Process(bool idle)
+{
+    if (!s_index.built || s_index.dirty_mask == 0u) {
+        return false;
+    }
+
+    /* 주행 중에는 활성 섹터가 어느 정도 찼을 때만 (그 전에 주차하면 그때 지움) */
+    if (!idle && s_index.active != SETTINGS_NO_SECTOR &&
+        s_index.sector_used[s_index.active] < ((SETTINGS_SECTOR_SIZE / 100u) * SETTINGS_ERASE_FORCE_PCT)) {
+        return false;
+    }
+
+    for (uint8_t i = 0u; i < SETTINGS_FLASH_SECTOR_COUNT; ++i) {
+        if (s_index.dirty_mask & (1u << i)) {
+            ClockProfile_RequestFull();
+            (void)settings_erase_sector(i);
+            ClockProfile_ReleaseFull();
+            return true;    /* 한 번에 한 섹터 */
+        }
+    }
+    return false;
+}
+
+uint32_t Settings_GetSectorUsed(uint8_t sector_idx)
+{
+    if (sector_idx >= SETTINGS_FLASH_SECTOR_COUNT) {
+        return 0u;
+    }
+    settings_index_ensure();
+    return s_index.sector_used[sector_idx];
+}
@@ -1,36 +1,81 @@
-/* settings_storage.h */
-
-#ifndef INC_SETTINGS_STORAGE_H_
-#define INC_SETTINGS_STORAGE_H_
-
-#include <stdint.h>
-#include <stdbool.h>
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-typedef struct {
-    int8_t  timezone_hours;  /* GMT offset, 예: +9 */
-    uint8_t brightness;      /* 1~3 */
-    uint8_t auto_mode;       /* 0=off, 1=on */
-    // Beep volume: 0~4 (0=mute, 4=max)
-    uint8_t beep_volume;
-    uint8_t reserved;        /* 정렬/확장용 */
-
-} app_settings_t;
-
-/* 플래시에서 설정을 읽어온다.
- *  - 성공: true, out에 값 채움
- *  - 실패: false (유효한 레코드 없음, CRC 에러 등)
- */
-bool Settings_Load(app_settings_t *out);
-
-/* 현재 설정을 플래시에 저장한다 (웨어 레벨링 적용). */
-bool Settings_Save(const app_settings_t *cfg);
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif /* INC_SETTINGS_STORAGE_H_ */
+/* settings_storage.h */
+
+#ifndef INC_SETTINGS_STORAGE_H_
+#define INC_SETTINGS_STORAGE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    int8_t  timezone_hours;  /* GMT offset, 예: +9 */
+    uint8_t brightness;      /* 1~3 */
+    uint8_t auto_mode;       /* 0=off, 1=on */
+    // Beep volume: 0~4 (0=mute, 4=max)
+    uint8_t beep_volume;
+    uint8_t reserved;        /* 정렬/확장용 */
+
+} app_settings_t;
+
+/* 설정 키 (플래시에는 tag/len/value로 키마다 따로 저장)
+ *  - 태그 번호가 곧 플래시 포맷: 새 키는 COUNT 앞에 추가만, 번호 재사용 금지
+ *  - 기본값/범위는 settings_storage.c 의 s_keys 표
+ */
+typedef enum {
+    SETTINGS_KEY_TIMEZONE = 1,   /* int8  -12 ~ +14, 기본 +9 */
+    SETTINGS_KEY_BRIGHTNESS,     /* uint8 1 ~ 3, 기본 2 */
+    SETTINGS_KEY_AUTO_MODE,      /* uint8 0/1, 기본 0 */
+    SETTINGS_KEY_BEEP_VOLUME,    /* uint8 0 ~ 4, 기본 4 */
+
+    /* 트립 (trip_store): 트립마다 거리 [m], 시간 [s], 최고 속도 [0.1 km/h] 순서 */
+    SETTINGS_KEY_TRIP_A_DIST_M,
+    SETTINGS_KEY_TRIP_A_TIME_S,
+    SETTINGS_KEY_TRIP_A_TOP_KMH10,
+    SETTINGS_KEY_TRIP_B_DIST_M,
+    SETTINGS_KEY_TRIP_B_TIME_S,
+    SETTINGS_KEY_TRIP_B_TOP_KMH10,
+    SETTINGS_KEY_ODO_DIST_M,
+    SETTINGS_KEY_ODO_TIME_S,
+    SETTINGS_KEY_ODO_TOP_KMH10,
+    SETTINGS_KEY_TRIP_LAST_UTC_S,   /* 마지막 저장 때 GPS 시각 (2000-01-01 기준 초) */
+    SETTINGS_KEY_LASTGASP_MAX_US,   /* power_fail: 전원 저하 저장에 걸린 최악 시간 [us] */
+    SETTINGS_KEY_TELEM_RATE_HZ,     /* telemetry: 빠른 메시지(fix/motion) 주기 1 ~ 20 Hz, 기본 5 */
+    SETTINGS_KEY_TELEM_MASK,        /* telemetry: 보낼 메시지 비트 (TELEM_MASK_x), 기본 전부 */
+    SETTINGS_KEY_COUNT
+} settings_key_t;
+
+/* 플래시에서 설정을 읽어온다.
+ *  - out은 항상 채움 (저장 안 된 키는 기본값)
+ *  - 저장된 키가 하나라도 있으면 true, 처음 부팅이면 false
+ */
+bool Settings_Load(app_settings_t *out);
+
+/* 현재 설정을 플래시에 저장한다 (웨어 레벨링 적용).
+ *  - 바뀐 키만 append (키당 8바이트), 로그 위치는 RAM 인덱스에서 바로
+ */
+bool Settings_Save(const app_settings_t *cfg);
+
+/* 키 하나 읽기/쓰기. Set은 값이 같으면 안 쓰고, 범위 밖이면 false */
+int32_t Settings_Get(settings_key_t key);
+bool    Settings_Set(settings_key_t key, int32_t value);
+
+/* 전원 저하 ISR에서 호출: 이후 Set은 예약 슬롯만 쓰고 섹터 넘어가기/erase는 안 함 */
+void Settings_BeginLastGasp(void);
+
+/* 다 쓴 옛 섹터 지우기 (섹터 erase 동안은 플래시 전체가 1~2초 멈춤).
+ *  - idle: 지금 멈춰도 되는 때인지 (주차 중 등). 아니면 활성 섹터가 반 넘게 찼을 때만 지움
+ *  - 한 번에 한 섹터, 지웠으면 true
+ */
+bool Settings_Process(bool idle);
+
+/* 설정 섹터별 사용 바이트 (0 = 섹터 5, 1 = 6). 디버그/웨어 확인용 */
+uint32_t Settings_GetSectorUsed(uint8_t sector_idx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_SETTINGS_STORAGE_H_ */
@@ -0,0 +1,204 @@
+// solar.c
+#include "solar.h"
+#include <math.h>
+
+// ----------------- 일별 태양 파라미터 표 -----------------
+// day-of-year 1~366, UTC 정오 기준 (2024~2027 4년 평균, NOAA/Meeus 식으로 생성)
+//  decl: 적위 [0.01 deg], eot: 균시차 [0.01 min]
+typedef struct
+{
+    int16_t decl;
+    int16_t eot;
+} solar_day_t;
+
+static const solar_day_t s_solar_days[366] =
+{
+    {-2299,  -351}, {-2290,  -398}, {-2280,  -444}, {-2270,  -489}, {-2259,  -534}, {-2247,  -578},
+    {-2235,  -622}, {-2222,  -664}, {-2208,  -706}, {-2193,  -747}, {-2178,  -787}, {-2162,  -826},
+    {-2145,  -864}, {-2127,  -900}, {-2109,  -936}, {-2090,  -971}, {-2071, -1004}, {-2051, -1037},
+    {-2030, -1068}, {-2008, -1098}, {-1986, -1127}, {-1964, -1154}, {-1940, -1180}, {-1917, -1205},
+    {-1892, -1229}, {-1867, -1251}, {-1841, -1272}, {-1815, -1292}, {-1788, -1310}, {-1761, -1327},
+    {-1733, -1342}, {-1705, -1356}, {-1676, -1369}, {-1647, -1380}, {-1617, -1390}, {-1587, -1399},
+    {-1557, -1406}, {-1525, -1412}, {-1494, -1417}, {-1462, -1420}, {-1430, -1422}, {-1397, -1423},
+    {-1364, -1422}, {-1330, -1420}, {-1296, -1417}, {-1262, -1412}, {-1227, -1407}, {-1193, -1400},
+    {-1157, -1392}, {-1122, -1383}, {-1086, -1373}, {-1050, -1361}, {-1013, -1349}, { -977, -1335},
+    { -940, -1321}, { -903, -1305}, { -866, -1289}, { -828, -1271}, { -790, -1253}, { -752, -1234},
+    { -714, -1214}, { -676, -1193}, { -637, -1171}, { -599, -1149}, { -560, -1126}, { -521, -1102},
+    { -482, -1078}, { -443, -1053}, { -404, -1027}, { -365, -1001}, { -325,  -974}, { -286,  -947},
+    { -247,  -920}, { -207,  -892}, { -168,  -863}, { -128,  -835}, {  -89,  -806}, {  -49,  -777},
+    {   -9,  -747}, {   30,  -717}, {   70,  -688}, {  109,  -658}, {  148,  -628}, {  188,  -597},
+    {  227,  -567}, {  266,  -537}, {  305,  -507}, {  344,  -477}, {  383,  -447}, {  422,  -417},
+    {  461,  -387}, {  499,  -358}, {  537,  -329}, {  576,  -300}, {  614,  -271}, {  652,  -242},
+    {  689,  -214}, {  727,  -187}, {  764,  -159}, {  801,  -132}, {  838,  -106}, {  874,   -80},
+    {  911,   -55}, {  947,   -30}, {  983,    -5}, { 1018,    18}, { 1054,    41}, { 1089,    64},
+    { 1123,    86}, { 1158,   107}, { 1192,   127}, { 1225,   147}, { 1259,   166}, { 1292,   184},
+    { 1325,   201}, { 1357,   218}, { 1389,   234}, { 1421,   249}, { 1452,   263}, { 1483,   276},
+    { 1513,   288}, { 1543,   300}, { 1573,   310}, { 1602,   320}, { 1630,   328}, { 1659,   336},
+    { 1686,   343}, { 1714,   349}, { 1740,   354}, { 1767,   358}, { 1793,   361}, { 1818,   363},
+    { 1843,   364}, { 1867,   364}, { 1891,   363}, { 1914,   362}, { 1937,   359}, { 1959,   355},
+    { 1981,   351}, { 2002,   345}, { 2022,   339}, { 2042,   332}, { 2061,   324}, { 2080,   315},
+    { 2098,   305}, { 2116,   295}, { 2133,   283}, { 2149,   271}, { 2164,   258}, { 2180,   245},
+    { 2194,   230}, { 2208,   215}, { 2221,   200}, { 2233,   183}, { 2245,   166}, { 2256,   149},
+    { 2267,   131}, { 2277,   113}, { 2286,    94}, { 2295,    74}, { 2302,    54}, { 2310,    34},
+    { 2316,    14}, { 2322,    -7}, { 2327,   -28}, { 2331,   -49}, { 2335,   -71}, { 2338,   -92},
+    { 2341,  -114}, { 2342,  -136}, { 2343,  -158}, { 2344,  -180}, { 2343,  -201}, { 2342,  -223},
+    { 2341,  -244}, { 2338,  -266}, { 2335,  -287}, { 2331,  -308}, { 2327,  -328}, { 2322,  -348},
+    { 2316,  -368}, { 2309,  -388}, { 2302,  -407}, { 2294,  -425}, { 2286,  -444}, { 2277,  -461},
+    { 2267,  -478}, { 2256,  -494}, { 2245,  -510}, { 2233,  -525}, { 2221,  -540}, { 2208,  -553},
+    { 2194,  -566}, { 2180,  -578}, { 2165,  -590}, { 2149,  -600}, { 2133,  -610}, { 2116,  -619},
+    { 2099,  -627}, { 2081,  -634}, { 2062,  -640}, { 2043,  -645}, { 2024,  -649}, { 2003,  -652},
+    { 1983,  -655}, { 1961,  -656}, { 1939,  -656}, { 1917,  -655}, { 1894,  -654}, { 1870,  -651},
+    { 1846,  -647}, { 1822,  -643}, { 1797,  -637}, { 1771,  -630}, { 1745,  -622}, { 1719,  -614},
+    { 1692,  -604}, { 1665,  -593}, { 1637,  -581}, { 1609,  -568}, { 1580,  -555}, { 1551,  -540},
+    { 1521,  -524}, { 1491,  -508}, { 1461,  -490}, { 1430,  -472}, { 1399,  -453}, { 1368,  -432},
+    { 1336,  -411}, { 1304,  -389}, { 1271,  -367}, { 1238,  -343}, { 1205,  -319}, { 1172,  -294},
+    { 1138,  -268}, { 1104,  -241}, { 1069,  -214}, { 1035,  -186}, { 1000,  -158}, {  965,  -128},
+    {  929,   -99}, {  893,   -68}, {  858,   -37}, {  821,    -6}, {  785,    26}, {  748,    58},
+    {  712,    91}, {  675,   124}, {  637,   158}, {  600,   192}, {  562,   226}, {  525,   261},
+    {  487,   295}, {  449,   330}, {  411,   366}, {  373,   401}, {  334,   437}, {  296,   472},
+    {  257,   508}, {  219,   544}, {  180,   579}, {  141,   615}, {  103,   651}, {   64,   686},
+    {   25,   722}, {  -14,   757}, {  -53,   792}, {  -92,   827}, { -131,   861}, { -170,   895},
+    { -209,   929}, { -248,   963}, { -287,   996}, { -325,  1029}, { -364,  1061}, { -403,  1093},
+    { -441,  1124}, { -480,  1154}, { -518,  1184}, { -556,  1214}, { -595,  1243}, { -633,  1270},
+    { -671,  1298}, { -708,  1324}, { -746,  1350}, { -783,  1375}, { -821,  1399}, { -858,  1422},
+    { -895,  1444}, { -931,  1465}, { -968,  1485}, {-1004,  1504}, {-1040,  1522}, {-1075,  1539},
+    {-1111,  1555}, {-1146,  1570}, {-1181,  1583}, {-1215,  1595}, {-1250,  1607}, {-1284,  1616},
+    {-1317,  1625}, {-1350,  1632}, {-1383,  1638}, {-1416,  1643}, {-1448,  1646}, {-1480,  1649},
+    {-1511,  1649}, {-1542,  1648}, {-1573,  1646}, {-1603,  1643}, {-1632,  1638}, {-1662,  1631},
+    {-1690,  1624}, {-1719,  1614}, {-1746,  1604}, {-1774,  1592}, {-1800,  1578}, {-1827,  1563},
+    {-1852,  1547}, {-1877,  1529}, {-1902,  1510}, {-1926,  1489}, {-1949,  1467}, {-1972,  1444},
+    {-1995,  1419}, {-2016,  1393}, {-2037,  1366}, {-2058,  1337}, {-2078,  1307}, {-2097,  1276},
+    {-2115,  1243}, {-2133,  1210}, {-2150,  1175}, {-2167,  1139}, {-2182,  1102}, {-2197,  1064},
+    {-2212,  1025}, {-2226,   985}, {-2238,   944}, {-2251,   902}, {-2262,   859}, {-2273,   816},
+    {-2283,   771}, {-2292,   726}, {-2301,   681}, {-2309,   634}, {-2316,   588}, {-2322,   540},
+    {-2327,   492}, {-2332,   444}, {-2336,   395}, {-2339,   347}, {-2341,   297}, {-2343,   248},
+    {-2344,   199}, {-2344,   149}, {-2343,    99}, {-2341,    50}, {-2339,     0}, {-2336,   -49},
+    {-2332,   -98}, {-2327,  -147}, {-2322,  -196}, {-2315,  -244}, {-2308,  -292}, {-2307,  -304},
+};
+
+#define SOLAR_DEG2RAD   0.017453292519943f
+#define SOLAR_RAD2DEG   57.295779513082321f
+
+// doy + frac_day (-0.5 ~ +0.5) 위치에서 선형 보간
+void Solar_GetDayParams(uint16_t doy, float frac_day, float *decl_deg, float *eot_min)
+{
+    if (doy < 1u) {
+        doy = 1u;
+    } else if (doy > 366u) {
+        doy = 366u;
+    }
+
+    int   i0 = (int)doy - 1;
+    float t  = frac_day;
+    if (t < 0.0f) {
+        i0 -= 1;
+        t  += 1.0f;
+    }
+    int i1 = i0 + 1;
+
+    // 연말/연초는 고리로 (366 → 1)
+    if (i0 < 0) {
+        i0 = 365;
+    }
+    if (i1 > 365) {
+        i1 = 0;
+    }
+
+    const solar_day_t *a = &s_solar_days[i0];
+    const solar_day_t *b = &s_solar_days[i1];
+
+    if (decl_deg) {
+        *decl_deg = ((float)a->decl + ((float)(b->decl - a->decl)) * t) * 0.01f;
+    }
+    if (eot_min) {
+        *eot_min = ((float)a->eot + ((float)(b->eot - a->eot)) * t) * 0.01f;
+    }
+}
+
+bool Solar_EventsUtc(uint16_t doy,
+                     float    lat_deg,
+                     float    lon_deg,
+                     float    zenith_deg,
+                     int16_t *rise_min_utc,
+                     int16_t *set_min_utc)
+{
+    // 이 경도의 태양 정오(UTC) 부근 값으로 하루 파라미터를 잡음
+    float noon_guess = 720.0f - 4.0f * lon_deg;
+    float decl, eot;
+    Solar_GetDayParams(doy, (noon_guess - 720.0f) / 1440.0f, &decl, &eot);
+
+    float lat_r  = lat_deg * SOLAR_DEG2RAD;
+    float decl_r = decl * SOLAR_DEG2RAD;
+
+    float cos_h = (cosf(zenith_deg * SOLAR_DEG2RAD) - sinf(lat_r) * sinf(decl_r)) /
+                  (cosf(lat_r) * cosf(decl_r));
+
+    if (cos_h > 1.0f || cos_h < -1.0f) {
+        // 극야 / 백야: 그 날은 뜨거나 지지 않음
+        return false;
+    }
+
+    float h_deg = acosf(cos_h) * SOLAR_RAD2DEG;
+    float noon  = 720.0f - 4.0f * lon_deg - eot;
+
+    float rise = noon - 4.0f * h_deg;
+    float set  = noon + 4.0f * h_deg;
+
+    if (rise_min_utc) {
+        *rise_min_utc = (int16_t)lroundf(rise);
+    }
+    if (set_min_utc) {
+        *set_min_utc = (int16_t)lroundf(set);
+    }
+    return true;
+}
+
+void Solar_StatePrepare(solar_state_t *st, uint16_t doy, float lat_deg, float lon_deg)
+{
+    if (!st) {
+        return;
+    }
+
+    float decl, eot;
+    Solar_GetDayParams(doy, (-4.0f * lon_deg) / 1440.0f, &decl, &eot);
+
+    float lat_r  = lat_deg * SOLAR_DEG2RAD;
+    float decl_r = decl * SOLAR_DEG2RAD;
+
+    st->doy              = doy;
+    st->lat_deg          = lat_deg;
+    st->lon_deg          = lon_deg;
+    st->sin_lat_sin_decl = sinf(lat_r) * sinf(decl_r);
+    st->cos_lat_cos_decl = cosf(lat_r) * cosf(decl_r);
+    st->eot_min          = eot;
+    st->valid            = 1u;
+}
+
+float Solar_ElevationDeg(const solar_state_t *st, uint16_t minute_utc, bool *afternoon)
+{
+    if (!st || !st->valid) {
+        return 0.0f;
+    }
+
+    // 진태양시 [분] → 시간각 [deg] (정오 = 0, 오후 +)
+    float tst = (float)minute_utc + st->eot_min + 4.0f * st->lon_deg;
+    float ha  = tst * 0.25f - 180.0f;
+    while (ha < -180.0f) {
+        ha += 360.0f;
+    }
+    while (ha >= 180.0f) {
+        ha -= 360.0f;
+    }
+
+    if (afternoon) {
+        *afternoon = (ha > 0.0f);
+    }
+
+    float sin_el = st->sin_lat_sin_decl + st->cos_lat_cos_decl * cosf(ha * SOLAR_DEG2RAD);
+    if (sin_el > 1.0f) {
+        sin_el = 1.0f;
+    } else if (sin_el < -1.0f) {
+        sin_el = -1.0f;
+    }
+    return asinf(sin_el) * SOLAR_RAD2DEG;
+}
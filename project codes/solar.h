@@ -0,0 +1,57 @@
+/*
+ * solar.h
+ *
+ *  태양 위치 (일출/일몰) 계산
+ *  - 적위/균시차는 day-of-year 표에서 읽고 (double 삼각함수 없음)
+ *    위치별 계산은 float32 시간각 식 하나로 끝낸다.
+ *  - 결과는 UTC 기준 [분]. 경도에 따라 0 미만 / 1440 이상이 나올 수 있으니
+ *    로컬 시각으로 바꿀 때 호출 측에서 감아준다.
+ */
+
+#ifndef INC_SOLAR_H_
+#define INC_SOLAR_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 천정각 기준 (일출/일몰 = 대기굴절 + 태양 반지름 포함)
+#define SOLAR_ZENITH_OFFICIAL   90.833f
+
+// 하루 파라미터: doy(1~366) + frac_day(-0.5 ~ +0.5, UTC 정오 기준 하루 비율)
+void Solar_GetDayParams(uint16_t doy, float frac_day, float *decl_deg, float *eot_min);
+
+// 일출/일몰 UTC [분]. 그 날 해가 뜨거나 지지 않으면 false
+bool Solar_EventsUtc(uint16_t doy,
+                     float    lat_deg,
+                     float    lon_deg,
+                     float    zenith_deg,
+                     int16_t *rise_min_utc,
+                     int16_t *set_min_utc);
+
+// 위치 + 날짜별로 한 번만 준비해 두는 상태 (분 단위 고도 계산용)
+typedef struct
+{
+    uint8_t  valid;
+    uint16_t doy;
+    float    lat_deg;
+    float    lon_deg;
+    float    sin_lat_sin_decl;
+    float    cos_lat_cos_decl;
+    float    eot_min;
+} solar_state_t;
+
+void Solar_StatePrepare(solar_state_t *st, uint16_t doy, float lat_deg, float lon_deg);
+
+// 태양 고도 [deg] (지평선 0, 시민박명 -6, 항해박명 -12)
+// afternoon: 태양 정오 이후면 true (NULL 가능)
+float Solar_ElevationDeg(const solar_state_t *st, uint16_t minute_utc, bool *afternoon);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_SOLAR_H_ */
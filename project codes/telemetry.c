@@ -0,0 +1,491 @@
+// telemetry.c
+#include "telemetry.h"
+
+#if TELEMETRY_TRANSPORT != TELEMETRY_TRANSPORT_NONE
+
+#include "main.h"
+#include "gps_app.h"
+#include "gps_ubx.h"
+#include "app_display.h"
+#include "trip_store.h"
+#include "sched.h"
+#include "settings_storage.h"
+#include "crc32.h"
+#include <string.h>
+
+#if TELEMETRY_TRANSPORT == TELEMETRY_TRANSPORT_USB_CDC
+#include "usbd_cdc_if.h"
+extern USBD_HandleTypeDef hUsbDeviceFS;
+#endif
+
+// ----------------- 설정 -----------------
+#define TELEM_SYNC1          0xA5u
+#define TELEM_SYNC2          0x5Au
+#define TELEM_HDR_SIZE       6u       // sync 2 + type + seq + len 2
+#define TELEM_CRC_SIZE       2u
+#define TELEM_SLOW_MS        1000u    // TRIP / PARSER / TASKS
+#define TELEM_RATE_MIN_HZ    1u
+#define TELEM_RATE_MAX_HZ    20u
+#define TELEM_RX_SIZE        64u      // 수신 링 (2의 거듭제곱)
+
+typedef enum {
+    TELEM_TX_OK = 0,     // 넘김 (이전에 넘긴 버퍼는 다 나갔음)
+    TELEM_TX_BUSY,       // 아직 이전 버퍼 전송 중
+    TELEM_TX_OFFLINE     // 호스트 연결 없음
+} telem_tx_t;
+
+// ----------------- 상태 -----------------
+static telemetry_stats_t s_stats;
+static uint8_t  s_rate_hz   = 5u;
+static uint8_t  s_mask      = TELEM_MASK_ALL;
+static uint8_t  s_seq       = 0u;
+static uint32_t s_fast_ms   = 0u;
+static uint32_t s_slow_ms   = 0u;
+
+// 송신 이중 버퍼: s_fill 쪽에 쌓고, 반대쪽은 전송 계층이 들고 있음
+static uint8_t  s_buf[2][TELEMETRY_BUF_SIZE];
+static uint16_t s_fill_len  = 0u;
+static uint8_t  s_fill      = 0u;
+
+// 수신 링 (전송 계층 ISR → Process)
+static uint8_t           s_rx[TELEM_RX_SIZE];
+static volatile uint16_t s_rx_head = 0u;
+static uint16_t          s_rx_tail = 0u;
+
+// 수신 프레임 조립
+static uint8_t  s_rx_frame[TELEM_HDR_SIZE + 8u + TELEM_CRC_SIZE];
+static uint8_t  s_rx_pos    = 0u;
+
+// ----------------- 전송 계층 -----------------
+#if TELEMETRY_TRANSPORT == TELEMETRY_TRANSPORT_LOOPBACK
+static uint8_t  s_loop[TELEMETRY_LOOPBACK_SIZE];
+static uint32_t s_loop_head = 0u;
+static uint32_t s_loop_tail = 0u;
+
+static bool telem_link_up(void)
+{
+    return true;
+}
+
+// 링에 자리가 없으면 USB가 바쁠 때처럼 BUSY (이중 버퍼 경로를 그대로 탐)
+static telem_tx_t telem_tx_start(const uint8_t *buf, uint16_t len)
+{
+    uint32_t used = s_loop_head - s_loop_tail;
+
+    if ((TELEMETRY_LOOPBACK_SIZE - used) < len) {
+        return TELEM_TX_BUSY;
+    }
+    for (uint16_t i = 0u; i < len; ++i) {
+        s_loop[(s_loop_head + i) % TELEMETRY_LOOPBACK_SIZE] = buf[i];
+    }
+    s_loop_head += len;
+    return TELEM_TX_OK;
+}
+#else
+static bool telem_link_up(void)
+{
+    return (hUsbDeviceFS.dev_state == USBD_STATE_CONFIGURED);
+}
+
+// CDC_Transmit_FS는 비동기: 받아 주면 그 버퍼는 전송이 끝날 때까지 건드리면 안 됨.
+// 다음 호출이 USBD_OK면 앞 전송이 끝난 것 (TxState == 0)
+static telem_tx_t telem_tx_start(const uint8_t *buf, uint16_t len)
+{
+    // 연결 전에는 CDC 클래스 데이터가 없어서 CDC_Transmit_FS를 부르면 안 됨
+    if (!telem_link_up()) {
+        return TELEM_TX_OFFLINE;
+    }
+    return (CDC_Transmit_FS((uint8_t *)buf, len) == USBD_OK) ? TELEM_TX_OK : TELEM_TX_BUSY;
+}
+#endif
+
+// ----------------- 프레임 -----------------
+static uint8_t *telem_put_u8(uint8_t *p, uint8_t v)
+{
+    *p++ = v;
+    return p;
+}
+
+static uint8_t *telem_put_u16(uint8_t *p, uint16_t v)
+{
+    *p++ = (uint8_t)v;
+    *p++ = (uint8_t)(v >> 8);
+    return p;
+}
+
+static uint8_t *telem_put_u32(uint8_t *p, uint32_t v)
+{
+    *p++ = (uint8_t)v;
+    *p++ = (uint8_t)(v >> 8);
+    *p++ = (uint8_t)(v >> 16);
+    *p++ = (uint8_t)(v >> 24);
+    return p;
+}
+
+static uint16_t telem_sat_u16(uint32_t v)
+{
+    return (v > 0xFFFFu) ? 0xFFFFu : (uint16_t)v;
+}
+
+static int32_t telem_round(double v)
+{
+    return (int32_t)((v >= 0.0) ? (v + 0.5) : (v - 0.5));
+}
+
+// 프레임 하나를 채우는 버퍼에 (자리가 없으면 버림)
+static void telem_emit(uint8_t type, const uint8_t *payload, uint16_t len)
+{
+    uint16_t size = TELEM_HDR_SIZE + len + TELEM_CRC_SIZE;
+
+    if ((s_fill_len + size) > TELEMETRY_BUF_SIZE) {
+        s_stats.dropped++;
+        return;
+    }
+
+    uint8_t *f = &s_buf[s_fill][s_fill_len];
+    f[0] = TELEM_SYNC1;
+    f[1] = TELEM_SYNC2;
+    f[2] = type;
+    f[3] = s_seq++;
+    (void)telem_put_u16(&f[4], len);
+    memcpy(&f[TELEM_HDR_SIZE], payload, len);
+
+    uint16_t crc = (uint16_t)Crc32_Calc(&f[2], 4u + len);
+    (void)telem_put_u16(&f[TELEM_HDR_SIZE + len], crc);
+
+    s_fill_len = (uint16_t)(s_fill_len + size);
+    s_stats.frames++;
+}
+
+// ----------------- 메시지 -----------------
+static void telem_send_fix(const app_gps_state_t *gps)
+{
+    uint8_t  pl[24];
+    uint8_t *p = pl;
+
+    p = telem_put_u32(p, APP_GPS_UtcSeconds(gps));
+    p = telem_put_u16(p, (uint16_t)(gps->tow_ms % 1000u));
+    p = telem_put_u32(p, (uint32_t)telem_round(gps->lat_deg * 1e7));
+    p = telem_put_u32(p, (uint32_t)telem_round(gps->lon_deg * 1e7));
+    p = telem_put_u32(p, (uint32_t)telem_round(gps->hmsl_m * 100.0));
+    p = telem_put_u8(p, gps->fixType);
+    p = telem_put_u8(p, gps->numSV_used);
+    p = telem_put_u8(p, gps->numSV_visible);
+    p = telem_put_u8(p, (uint8_t)((gps->valid ? 0x01u : 0u) | (gps->fixOk ? 0x02u : 0u)));
+    telem_emit(TELEM_MSG_FIX, pl, (uint16_t)(p - pl));
+}
+
+static void telem_send_motion(const app_gps_state_t *gps)
+{
+    uint8_t  pl[16];
+    uint8_t *p = pl;
+
+    p = telem_put_u16(p, telem_sat_u16((uint32_t)telem_round(gps->speed_mps * 100.0)));
+    p = telem_put_u16(p, (uint16_t)telem_round(gps->heading_deg * 10.0));
+    p = telem_put_u8(p, gps->heading_valid ? 1u : 0u);
+    p = telem_put_u16(p, (uint16_t)(int16_t)telem_round(APP_Display_GetGrade() * 10.0));
+    p = telem_put_u16(p, telem_sat_u16((uint32_t)telem_round(gps->raw_speed_mps * 100.0)));
+    p = telem_put_u16(p, (uint16_t)telem_round(gps->raw_heading_deg * 10.0));
+    telem_emit(TELEM_MSG_MOTION, pl, (uint16_t)(p - pl));
+}
+
+static void telem_send_trip(void)
+{
+    uint8_t  pl[TRIP_COUNT * 12u];
+    uint8_t *p = pl;
+
+    for (uint8_t id = 0u; id < TRIP_COUNT; ++id) {
+        const trip_stats_t *t = TripStore_Get((trip_id_t)id);
+
+        p = telem_put_u32(p, t->distance_m);
+        p = telem_put_u32(p, t->time_ms / 1000u);
+        p = telem_put_u16(p, telem_sat_u16((uint32_t)telem_round(t->top_speed_kmh * 10.0)));
+        p = telem_put_u16(p, telem_sat_u16((uint32_t)telem_round(t->avg_speed_kmh * 10.0)));
+    }
+    telem_emit(TELEM_MSG_TRIP, pl, (uint16_t)(p - pl));
+}
+
+static void telem_send_parser(void)
+{
+    const gps_ubx_stats_t *g = GPS_UBX_GetStats();
+    uint8_t  pl[24];
+    uint8_t *p = pl;
+
+    p = telem_put_u32(p, g->rx_bytes);
+    p = telem_put_u32(p, g->frames_ok);
+    p = telem_put_u32(p, g->ck_errors);
+    p = telem_put_u32(p, g->len_errors);
+    p = telem_put_u32(p, g->uart_errors);
+    p = telem_put_u32(p, s_stats.dropped);
+    telem_emit(TELEM_MSG_PARSER, pl, (uint16_t)(p - pl));
+}
+
+static void telem_send_tasks(uint8_t tasks)
+{
+    uint8_t  pl[1u + (SCHED_MAX_TASKS * 12u) + 2u];
+    uint8_t *p = pl;
+
+    if (tasks > SCHED_MAX_TASKS) {
+        tasks = SCHED_MAX_TASKS;
+    }
+    p = telem_put_u8(p, tasks);
+    for (uint8_t i = 0u; i < tasks; ++i) {
+        const sched_task_stats_t *st = Sched_GetStats(i);
+
+        p = telem_put_u32(p, st->runs);
+        p = telem_put_u32(p, st->overruns);
+        p = telem_put_u16(p, telem_sat_u16(st->last_us));
+        p = telem_put_u16(p, telem_sat_u16(st->max_us));
+    }
+    p = telem_put_u16(p, ClockProfile_GetUtil(ClockProfile_Get())->util_permille);
+    telem_emit(TELEM_MSG_TASKS, pl, (uint16_t)(p - pl));
+}
+
+static void telem_send_zto100(void)
+{
+    float    time_s, uncert_s;
+    uint8_t  pl[5];
+    uint8_t *p = pl;
+
+    p = telem_put_u8(p, APP_Display_GetZeroTo100(&time_s, &uncert_s));
+    p = telem_put_u16(p, telem_sat_u16((uint32_t)telem_round(time_s * 1000.0)));
+    p = telem_put_u16(p, telem_sat_u16((uint32_t)telem_round(uncert_s * 1000.0)));
+    telem_emit(TELEM_MSG_ZTO100, pl, (uint16_t)(p - pl));
+}
+
+static void telem_send_config_ack(void)
+{
+    uint8_t pl[2] = { s_rate_hz, s_mask };
+    telem_emit(TELEM_MSG_CONFIG_ACK, pl, sizeof(pl));
+}
+
+// ----------------- 수신 -----------------
+// 받은 바이트로 프레임 조립 (sync 찾기 → 헤더 → payload/crc), 완성되면 명령 처리
+static void telem_rx_byte(uint8_t b)
+{
+    s_rx_frame[s_rx_pos++] = b;
+
+    if (s_rx_pos == 1u && b != TELEM_SYNC1) {
+        s_rx_pos = 0u;
+        s_stats.rx_errors++;
+        return;
+    }
+    if (s_rx_pos == 2u && b != TELEM_SYNC2) {
+        s_rx_pos = (b == TELEM_SYNC1) ? 1u : 0u;
+        s_stats.rx_errors++;
+        return;
+    }
+    if (s_rx_pos < TELEM_HDR_SIZE) {
+        return;
+    }
+
+    uint16_t len = (uint16_t)(s_rx_frame[4] | ((uint16_t)s_rx_frame[5] << 8));
+    if ((TELEM_HDR_SIZE + len + TELEM_CRC_SIZE) > sizeof(s_rx_frame)) {
+        s_rx_pos = 0u;
+        s_stats.rx_errors++;
+        return;
+    }
+    if (s_rx_pos < (TELEM_HDR_SIZE + len + TELEM_CRC_SIZE)) {
+        return;
+    }
+    s_rx_pos = 0u;
+
+    const uint8_t *pl  = &s_rx_frame[TELEM_HDR_SIZE];
+    uint16_t       crc = (uint16_t)(pl[len] | ((uint16_t)pl[len + 1u] << 8));
+    if (crc != (uint16_t)Crc32_Calc(&s_rx_frame[2], 4u + len)) {
+        s_stats.rx_errors++;
+        return;
+    }
+    s_stats.rx_frames++;
+
+    if (s_rx_frame[2] == TELEM_MSG_CONFIG && len >= 2u) {
+        Telemetry_SetConfig(pl[0], pl[1]);
+        telem_send_config_ack();
+    }
+}
+
+// ----------------- API -----------------
+bool Telemetry_Init(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_fill_len = 0u;
+    s_fill     = 0u;
+    s_rx_pos   = 0u;
+    s_rx_tail  = s_rx_head;
+
+    s_rate_hz = (uint8_t)Settings_Get(SETTINGS_KEY_TELEM_RATE_HZ);
+    s_mask    = (uint8_t)Settings_Get(SETTINGS_KEY_TELEM_MASK);
+    s_fast_ms = HAL_GetTick();
+    s_slow_ms = s_fast_ms;
+    return true;
+}
+
+void Telemetry_Process(uint32_t now_ms, uint8_t tasks)
+{
+    while (s_rx_tail != s_rx_head) {
+        telem_rx_byte(s_rx[s_rx_tail]);
+        s_rx_tail = (uint16_t)((s_rx_tail + 1u) & (TELEM_RX_SIZE - 1u));
+    }
+
+    if (!telem_link_up()) {
+        s_fill_len = 0u;   // 아무도 안 듣는 동안은 쌓지 않음
+        return;
+    }
+
+    if ((now_ms - s_fast_ms) >= (1000u / s_rate_hz)) {
+        s_fast_ms = now_ms;
+
+        app_gps_state_t gps;
+        (void)APP_GPS_GetState(&gps);
+        if (s_mask & TELEM_MASK_FIX) {
+            telem_send_fix(&gps);
+        }
+        if (s_mask & TELEM_MASK_MOTION) {
+            telem_send_motion(&gps);
+        }
+    }
+
+    if ((now_ms - s_slow_ms) >= TELEM_SLOW_MS) {
+        s_slow_ms = now_ms;
+
+        if (s_mask & TELEM_MASK_TRIP) {
+            telem_send_trip();
+        }
+        if (s_mask & TELEM_MASK_PARSER) {
+            telem_send_parser();
+        }
+        if (s_mask & TELEM_MASK_TASKS) {
+            telem_send_tasks(tasks);
+        }
+        if (s_mask & TELEM_MASK_ZTO100) {
+            telem_send_zto100();
+        }
+    }
+
+    // 쌓인 게 있으면 넘기고 반대쪽 버퍼로 (바쁘면 다음 번에)
+    if (s_fill_len != 0u) {
+        telem_tx_t r = telem_tx_start(s_buf[s_fill], s_fill_len);
+
+        if (r == TELEM_TX_OK) {
+            s_stats.tx_chunks++;
+            s_fill    ^= 1u;
+            s_fill_len = 0u;
+        } else if (r == TELEM_TX_BUSY) {
+            s_stats.tx_busy++;
+        } else {
+            s_fill_len = 0u;
+        }
+    }
+}
+
+void Telemetry_SetConfig(uint8_t rate_hz, uint8_t mask)
+{
+    if (rate_hz < TELEM_RATE_MIN_HZ) {
+        rate_hz = TELEM_RATE_MIN_HZ;
+    } else if (rate_hz > TELEM_RATE_MAX_HZ) {
+        rate_hz = TELEM_RATE_MAX_HZ;
+    }
+    s_rate_hz = rate_hz;
+    s_mask    = (uint8_t)(mask & TELEM_MASK_ALL);
+
+    Settings_Set(SETTINGS_KEY_TELEM_RATE_HZ, s_rate_hz);
+    Settings_Set(SETTINGS_KEY_TELEM_MASK, s_mask);
+}
+
+uint8_t Telemetry_GetRate(void)
+{
+    return s_rate_hz;
+}
+
+uint8_t Telemetry_GetMask(void)
+{
+    return s_mask;
+}
+
+void Telemetry_OnRx(const uint8_t *data, uint32_t len)
+{
+    uint16_t head = s_rx_head;
+
+    for (uint32_t i = 0u; i < len; ++i) {
+        uint16_t next = (uint16_t)((head + 1u) & (TELEM_RX_SIZE - 1u));
+        if (next == s_rx_tail) {
+            break;   // 꽉 참: 나머지는 버림 (명령 프레임은 작고 드묾)
+        }
+        s_rx[head] = data[i];
+        head = next;
+    }
+    s_rx_head = head;
+}
+
+uint32_t Telemetry_LoopbackRead(uint8_t *out, uint32_t max)
+{
+#if TELEMETRY_TRANSPORT == TELEMETRY_TRANSPORT_LOOPBACK
+    uint32_t n = 0u;
+
+    while (n < max && s_loop_tail != s_loop_head) {
+        out[n++] = s_loop[s_loop_tail % TELEMETRY_LOOPBACK_SIZE];
+        s_loop_tail++;
+    }
+    return n;
+#else
+    (void)out;
+    (void)max;
+    return 0u;
+#endif
+}
+
+const telemetry_stats_t *Telemetry_GetStats(void)
+{
+    return &s_stats;
+}
+
+#else  // TELEMETRY_TRANSPORT_NONE
+
+static telemetry_stats_t s_stats;
+
+bool Telemetry_Init(void)
+{
+    return false;
+}
+
+void Telemetry_Process(uint32_t now_ms, uint8_t tasks)
+{
+    (void)now_ms;
+    (void)tasks;
+}
+
+void Telemetry_SetConfig(uint8_t rate_hz, uint8_t mask)
+{
+    (void)rate_hz;
+    (void)mask;
+}
+
+uint8_t Telemetry_GetRate(void)
+{
+    return 0u;
+}
+
+uint8_t Telemetry_GetMask(void)
+{
+    return 0u;
+}
+
+void Telemetry_OnRx(const uint8_t *data, uint32_t len)
+{
+    (void)data;
+    (void)len;
+}
+
+uint32_t Telemetry_LoopbackRead(uint8_t *out, uint32_t max)
+{
+    (void)out;
+    (void)max;
+    return 0u;
+}
+
+const telemetry_stats_t *Telemetry_GetStats(void)
+{
+    return &s_stats;
+}
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ * telemetry.h
+ *
+ *  바이너리 텔레메트리 스트림 (호스트 PC로 fix / 파생 값 / 트립 / 파서 상태 / 태스크 시간)
+ *  - 프레임을 RAM 송신 버퍼 두 개에 번갈아 쌓고, 한쪽을 전송 계층에 넘기는 동안 다른 쪽에 계속 쌓음
+ *    → 메인 루프는 전송을 기다리지 않음 (전송 계층이 바쁘면 버퍼가 찰 때까지 쌓고, 넘치면 버림)
+ *  - 빠른 메시지(FIX, MOTION)는 SETTINGS_KEY_TELEM_RATE_HZ 주기, 나머지는 1 Hz
+ *  - 보낼 메시지는 SETTINGS_KEY_TELEM_MASK 비트. 호스트가 CONFIG 프레임으로 바꿀 수 있음 (설정에 저장)
+ *
+ *  전송 계층 (TELEMETRY_TRANSPORT)
+ *  - NONE    : 빌드에서 빠짐 (기본)
+ *  - LOOPBACK: 보낸 바이트를 RAM 링에 쌓음 (Telemetry_LoopbackRead / 디버거로 s_loop 덤프).
+ *              Telemetry_OnRx로 호스트 명령도 흉내 낼 수 있어서 보드 없이 프로토콜 확인용
+ *              (호스트에서는 test/build/test_telemetry --loop 가 이 빌드를 stdin/stdout에 붙임)
+ *  - USB_CDC : USB OTG FS 가상 COM 포트. CubeMX에서 USB_OTG_FS(Device only) +
+ *              USB_DEVICE(CDC) 미들웨어를 생성하고, CLOCK_USB_48MHZ 1로 빌드.
+ *              usbd_cdc_if.c 의 CDC_Receive_FS USER CODE에서 Telemetry_OnRx(Buf, *Len) 호출.
+ *              빌드 옵션은 -DTELEMETRY_TRANSPORT=2 -DCLOCK_USB_48MHZ=1 (hal_conf가 이걸 보고 PCD 모듈을 켬).
+ *              MX_USB_DEVICE_Init 호출(main.c)과 OTG_FS_IRQHandler(stm32f4xx_it.c)는 USER CODE 안에
+ *              가드로 들어 있음 → CubeMX가 main/it를 USB 포함으로 다시 만들면 겹치므로 그쪽을 지움.
+ *              ※ 미들웨어가 이 트리에 없어서 이 경로는 실제 미들웨어/HAL PCD와 아직 한 번도 빌드해 보지 않았음
+ *              USB 클럭이 PLL에서 나오므로 주차 절전(LOW/STOP) 동안은 끊김
+ *              (FULL↔MID 전환은 PLL을 그대로 두므로 부팅 / 설정 erase / 셀프 테스트 중에도 유지)
+ *
+ *  프레임 (리틀 엔디안)
+ *      0xA5 0x5A | type u8 | seq u8 | len u16 | payload[len] | crc u16
+ *      crc = CRC-32(type ~ payload) 하위 16비트 (설정 레코드와 같은 방식), seq는 프레임마다 +1
+ *
+ *  장치 → 호스트 payload
+ *  - FIX    (0x01) u32 utc_s, u16 ms, i32 lat(1e-7 deg), i32 lon, i32 hmsl_cm,
+ *                  u8 fix_type, u8 sv_used, u8 sv_visible, u8 flags(bit0 valid, bit1 fixOk)
+ *  - MOTION (0x02) u16 speed_cms, u16 heading_ddeg, u8 heading_valid, i16 grade(0.1 %),
+ *                  u16 raw_speed_cms, u16 raw_heading_ddeg
+ *  - TRIP   (0x03) TRIP_A, TRIP_B, TRIP_ODO 순서로 각각 u32 dist_m, u32 time_s, u16 top(0.1 km/h), u16 avg
+ *  - PARSER (0x04) u32 rx_bytes, u32 frames_ok, u32 ck_errors, u32 len_errors, u32 uart_errors,
+ *                  u32 telem_dropped(이 스트림에서 버린 프레임)
+ *  - TASKS  (0x05) u8 n, 태스크마다 u32 runs, u32 overruns, u16 last_us, u16 max_us
+ *                  (u16은 65535에서 포화), 뒤에 u16 cpu(0.1 %, 현재 클럭 프로파일 평균)
+ *  - ZTO100 (0x06) u8 state(APP_DISPLAY_ZTO_x), u16 time_ms, u16 uncert_ms (state DONE일 때 유효)
+ *  - CONFIG_ACK (0x81) u8 rate_hz, u8 mask
+ *
+ *  호스트 → 장치
+ *  - CONFIG (0x80) u8 rate_hz(1~20), u8 mask  → 적용/저장하고 CONFIG_ACK
+ *
+ *  호스트 쪽 디코더: tools/telem_decode.py (--port / --exec / 캡처 파일, --config RATE MASK)
+ */
+
+#ifndef INC_TELEMETRY_H_
+#define INC_TELEMETRY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "clock_profile.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TELEMETRY_TRANSPORT_NONE      0
+#define TELEMETRY_TRANSPORT_LOOPBACK  1
+#define TELEMETRY_TRANSPORT_USB_CDC   2
+
+#ifndef TELEMETRY_TRANSPORT
+#define TELEMETRY_TRANSPORT   TELEMETRY_TRANSPORT_NONE
+#endif
+
+#if (TELEMETRY_TRANSPORT == TELEMETRY_TRANSPORT_USB_CDC) && !CLOCK_USB_48MHZ
+#error "USB CDC telemetry needs CLOCK_USB_48MHZ 1 (48 MHz USB clock)"
+#endif
+
+#define TELEMETRY_BUF_SIZE        512u    // 송신 버퍼 하나 (두 개)
+#define TELEMETRY_LOOPBACK_SIZE   2048u   // LOOPBACK 링
+
+// 메시지 종류
+#define TELEM_MSG_FIX         0x01u
+#define TELEM_MSG_MOTION      0x02u
+#define TELEM_MSG_TRIP        0x03u
+#define TELEM_MSG_PARSER      0x04u
+#define TELEM_MSG_TASKS       0x05u
+#define TELEM_MSG_ZTO100      0x06u
+#define TELEM_MSG_CONFIG      0x80u
+#define TELEM_MSG_CONFIG_ACK  0x81u
+
+// 메시지 마스크 비트 = 1 << (type - 1)
+#define TELEM_MASK_FIX        (1u << (TELEM_MSG_FIX - 1u))
+#define TELEM_MASK_MOTION     (1u << (TELEM_MSG_MOTION - 1u))
+#define TELEM_MASK_TRIP       (1u << (TELEM_MSG_TRIP - 1u))
+#define TELEM_MASK_PARSER     (1u << (TELEM_MSG_PARSER - 1u))
+#define TELEM_MASK_TASKS      (1u << (TELEM_MSG_TASKS - 1u))
+#define TELEM_MASK_ZTO100     (1u << (TELEM_MSG_ZTO100 - 1u))
+#define TELEM_MASK_ALL        0x3Fu
+
+typedef struct
+{
+    uint32_t frames;           // 버퍼에 쌓은 프레임
+    uint32_t dropped;          // 버퍼가 꽉 차서 버린 프레임
+    uint32_t tx_chunks;        // 전송 계층에 넘긴 버퍼 수
+    uint32_t tx_busy;          // 넘기려 했는데 아직 바빴던 횟수
+    uint32_t rx_frames;        // 받은 명령 프레임 (CRC 맞은 것)
+    uint32_t rx_errors;        // 받은 바이트 중 버린 것 (CRC/길이)
+} telemetry_stats_t;
+
+// 설정 로드 뒤 1회. 전송 계층이 없는 빌드면 false (→ 태스크 꺼 둠)
+bool Telemetry_Init(void);
+
+// 주기적으로 호출 (TASK_TELEM): 때가 된 메시지를 쌓고, 받은 명령 처리, 버퍼 전송
+//  tasks: 태스크 표 크기 (TASKS 메시지용)
+void Telemetry_Process(uint32_t now_ms, uint8_t tasks);
+
+void    Telemetry_SetConfig(uint8_t rate_hz, uint8_t mask);
+uint8_t Telemetry_GetRate(void);
+uint8_t Telemetry_GetMask(void);
+
+// 전송 계층 수신 콜백 (USB 인터럽트에서 불려도 됨: 링에 복사만)
+void Telemetry_OnRx(const uint8_t *data, uint32_t len);
+
+// LOOPBACK: 쌓인 바이트를 꺼냄 (꺼낸 바이트 수)
+uint32_t Telemetry_LoopbackRead(uint8_t *out, uint32_t max);
+
+const telemetry_stats_t *Telemetry_GetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_TELEMETRY_H_ */
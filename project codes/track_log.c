@@ -0,0 +1,484 @@
+// track_log.c
+#include "track_log.h"
+#include "main.h"
+#include "crc32.h"
+#include "track_simplify.h"
+#include "power_fail.h"
+#include <string.h>
+#include <stddef.h>
+
+// ----------------- 설정 -----------------
+#define TRACK_SECTOR_BASE      (0x08060000u)
+#define TRACK_SECTOR_SIZE      (0x20000u)       // 128KB
+#define TRACK_SECTOR_ID        FLASH_SECTOR_7
+
+#define TRACK_MAGIC            (0x314B5254u)    // 'T','R','K','1' : 섹터 헤더
+#define TRACK_BLOCK_MAGIC      (0x4254u)        // 'T','B'         : 블록 헤더
+#define TRACK_BLOCK_VERSION    (1u)
+
+#define TRACK_BLOCK_SIZE       (256u)
+#define TRACK_REC_MAX          (32u)            // 레코드 하나 최대 (varint 7개, 넉넉히)
+#define TRACK_WORDS_PER_CALL   (16u)            // TrackLog_Process 한 번에 쓰는 워드 (~0.3 ms)
+
+// ----------------- 포맷 -----------------
+typedef struct {
+    uint32_t magic;
+    uint32_t gen;          // 지울 때마다 +1
+    uint32_t gen_inv;      // ~gen : 지우다 만 헤더 걸러내기
+    uint32_t first_seq;    // 이 섹터 첫 블록의 seq
+} track_sector_hdr_t;
+
+typedef struct {
+    uint16_t magic;
+    uint16_t len;          // payload 바이트 수
+    uint32_t seq;
+    uint8_t  count;        // 레코드 수
+    uint8_t  version;
+    uint16_t reserved;     // 0xFFFF
+    uint32_t crc;          // 이 자리를 0xFFFFFFFF로 두고 헤더 + payload[len]
+} track_block_hdr_t;
+
+#define TRACK_HDR_SIZE         (sizeof(track_sector_hdr_t))
+#define TRACK_BLOCK_COUNT      ((TRACK_SECTOR_SIZE - TRACK_HDR_SIZE) / TRACK_BLOCK_SIZE)
+#define TRACK_PAYLOAD_MAX      (TRACK_BLOCK_SIZE - sizeof(track_block_hdr_t))
+#define TRACK_CRC_WORD         (offsetof(track_block_hdr_t, crc) / 4u)
+
+typedef struct {
+    track_block_hdr_t hdr;
+    uint8_t           payload[TRACK_PAYLOAD_MAX];
+} track_block_t;
+
+typedef enum {
+    TRACK_STATE_OFF = 0,     // Init 전
+    TRACK_STATE_NEED_ERASE,  // 헤더가 없고 빈 섹터도 아님 (예전 설정 로그 등) → 주차 때 erase
+    TRACK_STATE_READY,
+    TRACK_STATE_FULL
+} track_state_t;
+
+// ----------------- 상태 -----------------
+static track_state_t     s_state       = TRACK_STATE_OFF;
+static track_log_stats_t s_stats;
+
+static track_block_t     s_block[2];          // 채우는 버퍼 / 쓰는 버퍼
+static uint8_t           s_fill        = 0u;  // 지금 채우는 버퍼 번호
+static uint8_t           s_pending     = 0u;  // 반대쪽 버퍼가 닫혀서 쓰기 대기 중
+static uint32_t          s_write_word  = 0u;  // 쓰는 버퍼에서 몇 워드째까지 썼는지
+static uint32_t          s_next_block  = 0u;  // 섹터 안 다음 빈 블록
+static uint32_t          s_seq         = 0u;
+
+static track_point_t     s_prev;              // 채우는 블록의 마지막 점
+static uint32_t          s_last_log_ms = 0u;
+static uint8_t           s_has_last    = 0u;
+static uint8_t           s_was_moving  = 1u;  // 부팅 직후 서 있어도 그 자리 한 번은 찍음
+
+// ----------------- varint -----------------
+static uint8_t track_put_varint(uint8_t *p, uint32_t v)
+{
+    uint8_t n = 0u;
+
+    while (v >= 0x80u) {
+        p[n++] = (uint8_t)(v | 0x80u);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+static uint8_t track_put_svarint(uint8_t *p, int32_t v)
+{
+    // zigzag: 0, -1, 1, -2, ... → 0, 1, 2, 3, ...
+    return track_put_varint(p, ((uint32_t)v << 1) ^ (uint32_t)(v >> 31));
+}
+
+// ----------------- 블록 버퍼 -----------------
+static void track_block_reset(track_block_t *b)
+{
+    memset(b, 0xFF, sizeof(*b));
+    b->hdr.magic   = TRACK_BLOCK_MAGIC;
+    b->hdr.len     = 0u;
+    b->hdr.count   = 0u;
+    b->hdr.version = TRACK_BLOCK_VERSION;
+}
+
+// 채우던 블록을 닫아서 쓰기 대기열로 (반대쪽이 아직 안 써졌으면 버림)
+static void track_close_fill(void)
+{
+    track_block_t *b = &s_block[s_fill];
+
+    if (b->hdr.count == 0u) {
+        return;
+    }
+    if (s_pending) {
+        s_stats.blocks_dropped++;
+        track_block_reset(b);
+        return;
+    }
+
+    b->hdr.seq = s_seq++;
+    b->hdr.crc = 0xFFFFFFFFu;
+    b->hdr.crc = Crc32_Calc(b, sizeof(b->hdr) + b->hdr.len);
+
+    s_pending    = 1u;
+    s_write_word = 0u;
+    s_fill      ^= 1u;
+    track_block_reset(&s_block[s_fill]);
+}
+
+// ----------------- 플래시 -----------------
+static uint32_t track_block_addr(uint32_t block)
+{
+    return TRACK_SECTOR_BASE + TRACK_HDR_SIZE + (block * TRACK_BLOCK_SIZE);
+}
+
+static bool track_addr_blank(uint32_t addr)
+{
+    return (*(const uint32_t *)addr == 0xFFFFFFFFu);
+}
+
+// 블록은 앞에서부터 순서대로만 쓰므로 "쓰인 블록 → 빈 블록" 경계가 하나뿐
+static uint32_t track_find_boundary(void)
+{
+    uint32_t lo = 0u;                  // [0, lo) 는 쓰인 블록
+    uint32_t hi = TRACK_BLOCK_COUNT;   // [hi, N) 는 빈 블록
+
+    while (lo < hi) {
+        uint32_t mid = lo + ((hi - lo) / 2u);
+        if (track_addr_blank(track_block_addr(mid))) {
+            hi = mid;
+        } else {
+            lo = mid + 1u;
+        }
+    }
+    return lo;
+}
+
+static bool track_sector_blank(void)
+{
+    const uint32_t *p   = (const uint32_t *)TRACK_SECTOR_BASE;
+    const uint32_t *end = p + (TRACK_SECTOR_SIZE / 4u);
+
+    for (; p < end; ++p) {
+        if (*p != 0xFFFFFFFFu) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 쓰는 순서: 헤더 앞 3워드 → payload → crc 워드
+// (첫 워드가 써지는 순간 "쓰인 블록", crc가 마지막이라 중간에 끊기면 CRC 불일치)
+static uint32_t track_word_order(uint32_t i, uint32_t total)
+{
+    if (i < TRACK_CRC_WORD) {
+        return i;
+    }
+    if (i == (total - 1u)) {
+        return TRACK_CRC_WORD;
+    }
+    return i + 1u;
+}
+
+// 쓰는 버퍼를 최대 max_words 워드만큼 이어서 씀, 블록을 다 썼으면 true
+static bool track_write_step(uint32_t max_words)
+{
+    const track_block_t *b     = &s_block[s_fill ^ 1u];
+    const uint32_t      *w     = (const uint32_t *)b;
+    uint32_t             base  = track_block_addr(s_next_block);
+    uint32_t             total = (sizeof(b->hdr) + b->hdr.len + 3u) / 4u;   // 뒤쪽 0xFF 워드는 안 씀
+    bool                 ok    = true;
+
+    HAL_FLASH_Unlock();
+    for (uint32_t n = 0u; n < max_words && s_write_word < total; ++n) {
+        uint32_t idx  = track_word_order(s_write_word, total);
+        uint32_t addr = base + (idx * 4u);
+
+        // ISR이 쓰던 블록을 이어 쓸 때 이미 써진 워드는 건너뜀
+        if (*(const uint32_t *)addr != w[idx] &&
+            HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr, w[idx]) != HAL_OK) {
+            ok = false;
+            break;
+        }
+        s_write_word++;
+    }
+    HAL_FLASH_Lock();
+
+    if (ok && s_write_word < total) {
+        return false;
+    }
+
+    // 다 썼거나 실패 (실패한 블록은 CRC가 안 맞으니 읽을 때 버려짐, 자리만 넘김)
+    if (ok) {
+        s_stats.blocks_written++;
+    } else {
+        s_stats.blocks_dropped++;
+    }
+    s_next_block++;
+    s_pending    = 0u;
+    s_write_word = 0u;
+    s_stats.used_bytes = TRACK_HDR_SIZE + (s_next_block * TRACK_BLOCK_SIZE);
+
+    if (s_next_block >= TRACK_BLOCK_COUNT) {
+        s_state = TRACK_STATE_FULL;
+    }
+    return true;
+}
+
+// 섹터 헤더를 써서 이 섹터를 궤적 로그로 씀 (빈 섹터여야 함)
+static bool track_claim(uint32_t gen)
+{
+    track_sector_hdr_t hdr;
+    const uint32_t    *w = (const uint32_t *)&hdr;
+    bool               ok = true;
+
+    hdr.magic     = TRACK_MAGIC;
+    hdr.gen       = gen;
+    hdr.gen_inv   = ~gen;
+    hdr.first_seq = s_seq;
+
+    HAL_FLASH_Unlock();
+    for (uint32_t i = 0u; i < (TRACK_HDR_SIZE / 4u) && ok; ++i) {
+        ok = (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, TRACK_SECTOR_BASE + (i * 4u), w[i]) == HAL_OK);
+    }
+    HAL_FLASH_Lock();
+
+    if (!ok) {
+        s_state = TRACK_STATE_NEED_ERASE;
+        return false;
+    }
+
+    s_state            = TRACK_STATE_READY;
+    s_stats.gen        = gen;
+    s_next_block       = 0u;
+    s_stats.used_bytes = TRACK_HDR_SIZE;
+    return true;
+}
+
+// 섹터 지우고 다시 시작 (128KB: 1~2초, 그동안 플래시에서 도는 코드/인터럽트 전부 멈춤)
+static void track_erase_and_claim(void)
+{
+    FLASH_EraseInitTypeDef erase;
+    uint32_t sector_error = 0u;
+    uint32_t gen = s_stats.gen + 1u;
+
+    erase.TypeErase    = FLASH_TYPEERASE_SECTORS;
+    erase.Sector       = TRACK_SECTOR_ID;
+    erase.NbSectors    = 1u;
+    erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+
+    HAL_FLASH_Unlock();
+    PowerFail_EraseBegin();
+    bool ok = (HAL_FLASHEx_Erase(&erase, &sector_error) == HAL_OK);
+    PowerFail_EraseEnd();
+    HAL_FLASH_Lock();
+
+    if (ok) {
+        (void)track_claim(gen);
+    }
+}
+
+// ----------------- 기록 -----------------
+static int32_t track_round(double v)
+{
+    return (int32_t)((v >= 0.0) ? (v + 0.5) : (v - 0.5));
+}
+
+static void track_make_point(const app_gps_state_t *gps, uint32_t utc_s, track_point_t *pt)
+{
+    pt->utc_s     = utc_s;
+    pt->ms        = gps->tow_ms % 1000u;
+    pt->lat       = track_round(gps->lat_deg * 1e7);
+    pt->lon       = track_round(gps->lon_deg * 1e7);
+    pt->alt_dm    = track_round((double)gps->hmsl_m * 10.0);
+    pt->speed_cms = track_round((double)gps->speed_mps * 100.0);
+    pt->heading   = track_round((double)gps->heading_deg * 10.0) % 3600;
+    if (pt->heading < 0) {
+        pt->heading += 3600;
+    }
+}
+
+// 블록 첫 레코드는 절대값, 나머지는 앞 점과의 차이. 인코딩한 바이트 수 (0 = 델타로 못 씀)
+static uint8_t track_encode(const track_point_t *pt, bool key, uint8_t *out)
+{
+    uint8_t n = 0u;
+
+    if (key) {
+        n += track_put_varint(&out[n], pt->utc_s);
+        n += track_put_varint(&out[n], pt->ms);
+        n += track_put_svarint(&out[n], pt->lat);
+        n += track_put_svarint(&out[n], pt->lon);
+        n += track_put_svarint(&out[n], pt->alt_dm);
+        n += track_put_varint(&out[n], (uint32_t)pt->speed_cms);
+        n += track_put_varint(&out[n], (uint32_t)pt->heading);
+        return n;
+    }
+
+    // 시간이 거꾸로 가거나 너무 멀면 새 블록에서 절대값으로
+    if (pt->utc_s < s_prev.utc_s || (pt->utc_s - s_prev.utc_s) > 86400u) {
+        return 0u;
+    }
+    int32_t dt_ms = (int32_t)((pt->utc_s - s_prev.utc_s) * 1000u) + (int32_t)pt->ms - (int32_t)s_prev.ms;
+    if (dt_ms < 0) {
+        return 0u;
+    }
+
+    int32_t dh = pt->heading - s_prev.heading;
+    if (dh >= 1800) {
+        dh -= 3600;
+    } else if (dh < -1800) {
+        dh += 3600;
+    }
+
+    n += track_put_varint(&out[n], (uint32_t)dt_ms);
+    n += track_put_svarint(&out[n], pt->lat - s_prev.lat);
+    n += track_put_svarint(&out[n], pt->lon - s_prev.lon);
+    n += track_put_svarint(&out[n], pt->alt_dm - s_prev.alt_dm);
+    n += track_put_svarint(&out[n], pt->speed_cms - s_prev.speed_cms);
+    n += track_put_svarint(&out[n], dh);
+    return n;
+}
+
+static void track_append(const track_point_t *pt)
+{
+    uint8_t        rec[TRACK_REC_MAX];
+    track_block_t *b = &s_block[s_fill];
+    uint8_t        n = (b->hdr.count != 0u) ? track_encode(pt, false, rec) : 0u;
+
+    // 델타로 못 쓰거나 자리가 없으면 블록을 닫고 새 블록 첫 레코드로
+    if (b->hdr.count != 0u &&
+        (n == 0u || (b->hdr.len + n) > TRACK_PAYLOAD_MAX || b->hdr.count == 0xFFu)) {
+        track_close_fill();
+        b = &s_block[s_fill];
+    }
+    if (b->hdr.count == 0u) {
+        n = track_encode(pt, true, rec);
+    }
+
+    memcpy(&b->payload[b->hdr.len], rec, n);
+    b->hdr.len = (uint16_t)(b->hdr.len + n);
+    b->hdr.count++;
+    s_prev = *pt;
+    s_stats.records++;
+}
+
+// 솎아내기를 거쳐 남은 점만 블록에
+static void track_push(const track_point_t *pt, bool force)
+{
+    track_point_t keep[2];
+    uint8_t       n = TrackSimplify_Push(pt, force, keep);
+
+    for (uint8_t i = 0u; i < n; ++i) {
+        track_append(&keep[i]);
+    }
+}
+
+// 솎아내기가 들고 있던 마지막 점까지 넣고 채우던 블록을 닫음
+static void track_flush_points(void)
+{
+    track_point_t last;
+
+    if (TrackSimplify_Flush(&last) != 0u) {
+        track_append(&last);
+    }
+    track_close_fill();
+}
+
+// ----------------- API -----------------
+void TrackLog_Init(void)
+{
+    const track_sector_hdr_t *h = (const track_sector_hdr_t *)TRACK_SECTOR_BASE;
+
+    memset(&s_stats, 0, sizeof(s_stats));
+    track_block_reset(&s_block[0]);
+    track_block_reset(&s_block[1]);
+    s_fill       = 0u;
+    s_pending    = 0u;
+    s_write_word = 0u;
+    s_has_last   = 0u;
+    s_was_moving = 1u;
+    s_seq        = 0u;
+    TrackSimplify_Reset();
+
+    if (h->magic == TRACK_MAGIC && h->gen_inv == ~h->gen) {
+        s_stats.gen  = h->gen;
+        s_next_block = track_find_boundary();
+        s_seq        = h->first_seq + s_next_block;
+        s_stats.used_bytes = TRACK_HDR_SIZE + (s_next_block * TRACK_BLOCK_SIZE);
+        s_state = (s_next_block >= TRACK_BLOCK_COUNT) ? TRACK_STATE_FULL : TRACK_STATE_READY;
+    } else if (track_sector_blank()) {
+        (void)track_claim(1u);
+    } else {
+        // 예전 펌웨어의 설정 로그(5,6,7 통짜)가 남아 있을 수 있음 → 주차 때 지우고 씀
+        s_state = TRACK_STATE_NEED_ERASE;
+    }
+}
+
+void TrackLog_OnFix(const app_gps_state_t *gps)
+{
+    if (s_state == TRACK_STATE_OFF || !gps->valid) {
+        return;
+    }
+
+    uint32_t utc_s = APP_GPS_UtcSeconds(gps);
+    if (utc_s == 0u) {
+        return;
+    }
+    if (s_has_last && (gps->host_time_ms - s_last_log_ms) < TRACK_LOG_INTERVAL_MS) {
+        return;
+    }
+
+    // 서 있으면 멈춘 지점 한 번만 (솎아내기에서 빠지지 않게 강제로 남김)
+    bool moving = (gps->speed_kmh >= TRACK_LOG_MOVE_KMH);
+    if (!moving && !s_was_moving) {
+        return;
+    }
+    bool stopped  = (!moving && s_was_moving);
+    s_was_moving  = moving ? 1u : 0u;
+    s_last_log_ms = gps->host_time_ms;
+    s_has_last    = 1u;
+
+    track_point_t pt;
+    track_make_point(gps, utc_s, &pt);
+    s_stats.candidates++;
+    track_push(&pt, stopped);
+}
+
+void TrackLog_Process(bool idle)
+{
+    if (s_state == TRACK_STATE_NEED_ERASE ||
+        (s_state == TRACK_STATE_FULL && TRACK_LOG_WRAP)) {
+        if (idle) {
+            track_erase_and_claim();
+        }
+        return;
+    }
+
+    if (s_state == TRACK_STATE_READY && s_pending) {
+        (void)track_write_step(TRACK_WORDS_PER_CALL);
+    }
+}
+
+void TrackLog_Flush(void)
+{
+    track_flush_points();
+}
+
+void TrackLog_FlushFromISR(void)
+{
+    if (s_state != TRACK_STATE_READY) {
+        return;
+    }
+
+    // 쓰던 블록 마저 → 채우던 블록 닫아서 바로 씀
+    if (s_pending) {
+        (void)track_write_step(TRACK_BLOCK_SIZE / 4u);
+    }
+    track_flush_points();
+    if (s_pending && s_state == TRACK_STATE_READY) {
+        (void)track_write_step(TRACK_BLOCK_SIZE / 4u);
+    }
+}
+
+const track_log_stats_t *TrackLog_GetStats(void)
+{
+    return &s_stats;
+}
@@ -0,0 +1,81 @@
+/*
+ * track_log.h
+ *
+ *  GPS 주행 궤적 기록 (내부 플래시 Sector 7, 0x08060000 ~ 0x0807FFFF)
+ *  - 1 Hz 후보 점(위도/경도/고도/속도/헤딩)을 track_simplify로 솎아서 모양이 바뀌는 점만 기록
+ *    (직선 구간은 최대 TRACK_SIMPLIFY_MAX_GAP_S 간격). 서 있으면 멈춘 지점 한 번만 찍고 쉼
+ *  - RAM 블록 버퍼(256바이트) 두 개: 하나를 채우는 동안 다른 하나를
+ *    TrackLog_Process에서 몇 워드씩만 프로그래밍 → 화면 루프가 플래시 쓰기로 오래 멈추지 않음
+ *  - 섹터를 다 채우면 다음 주차 때 지우고 처음부터 (TRACK_LOG_WRAP 0이면 멈춤)
+ *  - 섹터 erase(1~2초)는 주차 중에만. 예전 펌웨어 설정 로그가 남아 있던 섹터도 이때 정리
+ *
+ *  플래시 포맷 (읽어 올 때: ST-Link로 0x08060000부터 128KB 덤프 → tools/track_decode.py 로 CSV / GPX)
+ *  - 섹터 헤더 16바이트: magic 'TRK1', gen(지울 때마다 +1), ~gen, 첫 블록 seq
+ *  - 그 뒤로 256바이트 블록이 빈틈없이 이어짐 (첫 워드가 0xFFFFFFFF인 블록부터 끝까지 빈 곳)
+ *      u16 magic 'TB' (0x4254), u16 len   : payload 바이트 수
+ *      u32 seq                             : 블록 번호 (섹터를 지워도 이어짐)
+ *      u8  count, u8 version(1), u16 0xFFFF : 레코드 수
+ *      u32 crc                             : CRC-32(crc 자리를 0xFFFFFFFF로 둔 헤더 16 + payload len)
+ *      payload[len]                        : 레코드들, 나머지는 0xFF
+ *    헤더 첫 워드를 제일 먼저, crc를 제일 마지막에 씀 → 쓰다 만 블록은 CRC가 안 맞아서 버림
+ *  - 레코드 = 필드를 차례로 LEB128 varint (부호 있는 값은 zigzag)
+ *      블록 첫 레코드(절대값): utc_s, ms(0~999), lat, lon, alt_dm, speed_cms, heading_ddeg
+ *      나머지 레코드(앞 레코드와의 차이): dt_ms, dlat, dlon, dalt_dm, dspeed_cms, dheading_ddeg
+ *    utc_s  : 2000-01-01 00:00:00 UTC 기준 초 (부호 없음)
+ *    lat/lon: 1e-7 deg, alt_dm: 해발 고도 0.1 m, speed_cms: cm/s (부호 없음, 차이는 부호 있음)
+ *    heading_ddeg: 0.1 deg 0~3599 (차이는 -1800~1799로 감음)
+ *    → 블록 하나만 있어도 혼자 디코딩 가능 (블록 사이 시간이 비면 그동안 전원/기록이 꺼져 있었던 것)
+ */
+
+#ifndef INC_TRACK_LOG_H_
+#define INC_TRACK_LOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "gps_app.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef TRACK_LOG_WRAP
+#define TRACK_LOG_WRAP          1       // 꽉 차면 다음 주차 때 지우고 다시 (0 = 덤프할 때까지 멈춤)
+#endif
+
+#define TRACK_LOG_INTERVAL_MS   1000u   // 후보 점 간격
+#define TRACK_LOG_MOVE_KMH      3.0f    // 이 아래로 내려가면 한 번 찍고 다시 움직일 때까지 쉼
+
+typedef struct
+{
+    uint32_t candidates;       // 이번 전원에서 솎아내기에 들어간 1 Hz 점 수
+    uint32_t records;          // 그중 기록한 레코드 수 (candidates / records = 압축률)
+    uint32_t blocks_written;   // 이번 전원에서 플래시에 쓴 블록 수
+    uint32_t blocks_dropped;   // 쓸 곳이 없어서 버린 블록 수 (섹터 정리 대기/꽉 참/쓰기 실패)
+    uint32_t used_bytes;       // 섹터에서 쓰인 바이트 (헤더 포함)
+    uint32_t gen;              // 섹터 지운 횟수 + 1 (0 = 아직 준비 안 됨)
+} track_log_stats_t;
+
+// 설정 로드(Settings_Load) 뒤 1회: 섹터를 훑어서 이어 쓸 위치를 찾음
+void TrackLog_Init(void);
+
+// 새 GPS epoch마다 (Task_GPS)
+void TrackLog_OnFix(const app_gps_state_t *gps);
+
+// 주기적으로 호출 (Task_Power, 10 ms)
+//  - 닫힌 블록을 한 번에 몇 워드씩 프로그래밍
+//  - idle(주차 중)이면 섹터 정리/재사용 erase
+void TrackLog_Process(bool idle);
+
+// 채우던 블록을 닫아서 쓰기 대기열로 (주차 진입 때)
+void TrackLog_Flush(void);
+
+// 전원 저하 ISR에서: 쓰던 블록 + 채우던 블록을 그 자리에서 끝까지 씀 (erase 없음)
+void TrackLog_FlushFromISR(void);
+
+const track_log_stats_t *TrackLog_GetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_TRACK_LOG_H_ */
@@ -0,0 +1,138 @@
+// track_simplify.c
+#include "track_simplify.h"
+#include <math.h>
+
+// ----------------- 설정 -----------------
+#define TRACK_M_PER_E7_LAT   0.0111320f   // 1e-7 deg 위도 = 1.1132 cm
+#define TRACK_DEG_TO_RAD     0.017453293f
+
+// ----------------- 상태 -----------------
+static track_point_t s_anchor;                           // 마지막으로 저장한 점
+static uint8_t       s_has_anchor = 0u;
+static track_point_t s_last;                             // 마지막 후보 (아직 저장 안 함)
+static float         s_x[TRACK_SIMPLIFY_WINDOW];         // 앵커 기준 동쪽 [m]
+static float         s_y[TRACK_SIMPLIFY_WINDOW];         // 앵커 기준 북쪽 [m]
+static uint8_t       s_count      = 0u;                  // 들고 있는 후보 수
+static float         s_m_per_e7_lon = TRACK_M_PER_E7_LAT;
+
+// ----------------- 헬퍼 -----------------
+static void track_set_anchor(const track_point_t *pt)
+{
+    s_anchor     = *pt;
+    s_has_anchor = 1u;
+    s_count      = 0u;
+    // 경도 1e-7 deg 길이는 앵커 위도에서 한 번만
+    s_m_per_e7_lon = TRACK_M_PER_E7_LAT * cosf((float)pt->lat * 1e-7f * TRACK_DEG_TO_RAD);
+}
+
+static void track_to_xy(const track_point_t *pt, float *x, float *y)
+{
+    *x = (float)(pt->lon - s_anchor.lon) * s_m_per_e7_lon;
+    *y = (float)(pt->lat - s_anchor.lat) * TRACK_M_PER_E7_LAT;
+}
+
+static int32_t track_heading_diff(int32_t a, int32_t b)
+{
+    int32_t d = a - b;
+    if (d >= 1800) {
+        d -= 3600;
+    } else if (d < -1800) {
+        d += 3600;
+    }
+    return (d < 0) ? -d : d;
+}
+
+// 후보들이 "앵커 → (px, py)" 선분에서 허용치 안에 있는지
+static bool track_segment_fits(float px, float py)
+{
+    float len2 = (px * px) + (py * py);
+    float tol2 = TRACK_SIMPLIFY_TOL_M * TRACK_SIMPLIFY_TOL_M;
+
+    for (uint8_t i = 0u; i < s_count; ++i) {
+        float t = 0.0f;
+        if (len2 > 0.01f) {
+            t = ((s_x[i] * px) + (s_y[i] * py)) / len2;
+            t = (t < 0.0f) ? 0.0f : ((t > 1.0f) ? 1.0f : t);
+        }
+        float dx = s_x[i] - (t * px);
+        float dy = s_y[i] - (t * py);
+        if (((dx * dx) + (dy * dy)) > tol2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 앵커에서 너무 멀어졌거나(시간/속도/헤딩/모양) 후보 창이 꽉 찼는지
+static bool track_needs_break(const track_point_t *pt, float px, float py)
+{
+    if (s_count >= TRACK_SIMPLIFY_WINDOW ||
+        (pt->utc_s - s_anchor.utc_s) > TRACK_SIMPLIFY_MAX_GAP_S) {
+        return true;
+    }
+
+    int32_t dv = pt->speed_cms - s_anchor.speed_cms;
+    if (dv > TRACK_SIMPLIFY_SPEED_CMS || dv < -TRACK_SIMPLIFY_SPEED_CMS ||
+        track_heading_diff(pt->heading, s_anchor.heading) > TRACK_SIMPLIFY_HEADING_DDEG) {
+        return true;
+    }
+
+    return !track_segment_fits(px, py);
+}
+
+// ----------------- API -----------------
+void TrackSimplify_Reset(void)
+{
+    s_has_anchor = 0u;
+    s_count      = 0u;
+}
+
+uint8_t TrackSimplify_Push(const track_point_t *pt, bool force, track_point_t out[2])
+{
+    uint8_t n = 0u;
+
+    // 첫 점, 시간이 거꾸로 간 점은 그대로 남기고 새로 시작
+    if (!s_has_anchor || pt->utc_s < s_anchor.utc_s) {
+        out[n++] = *pt;
+        track_set_anchor(pt);
+        return n;
+    }
+
+    float px, py;
+    track_to_xy(pt, &px, &py);
+
+    if (force || track_needs_break(pt, px, py)) {
+        if (s_count == 0u) {
+            // 후보가 없으면 (긴 공백 뒤 등) 이 점이 바로 새 앵커
+            out[n++] = *pt;
+            track_set_anchor(pt);
+            return n;
+        }
+
+        // 바로 앞 후보까지는 허용치 안이었으므로 그 점을 남기고 새 앵커로
+        out[n++] = s_last;
+        track_set_anchor(&s_last);
+        if (force) {
+            out[n++] = *pt;
+            track_set_anchor(pt);
+            return n;
+        }
+        track_to_xy(pt, &px, &py);
+    }
+
+    s_x[s_count] = px;
+    s_y[s_count] = py;
+    s_count++;
+    s_last = *pt;
+    return n;
+}
+
+uint8_t TrackSimplify_Flush(track_point_t *out)
+{
+    if (!s_has_anchor || s_count == 0u) {
+        return 0u;
+    }
+    *out = s_last;
+    track_set_anchor(&s_last);
+    return 1u;
+}
@@ -0,0 +1,54 @@
+/*
+ * track_simplify.h
+ *
+ *  궤적 점 솎아내기 (스트리밍 Douglas-Peucker, 메모리 고정)
+ *  - 마지막으로 저장한 점(앵커) 뒤로 들어온 후보 점을 최대 TRACK_SIMPLIFY_WINDOW 개까지 들고 있다가
+ *    새 점이 오면 "앵커 → 새 점" 선분에서 들고 있던 점들이 TRACK_SIMPLIFY_TOL_M 넘게 벗어나는지 본다.
+ *    벗어나면 바로 앞 후보를 저장하고 그 점이 새 앵커 (직선 고속도로에서는 거의 안 남음)
+ *  - 앵커보다 속도가 TRACK_SIMPLIFY_SPEED_CMS, 헤딩이 TRACK_SIMPLIFY_HEADING_DDEG 넘게 바뀌어도 저장
+ *  - 저장한 점 사이 간격은 TRACK_SIMPLIFY_MAX_GAP_S 를 넘지 않음 (후보가 그 간격 안에 있을 때)
+ *  - 평면 근사: 앵커 기준 동/북 [m] (앵커 사이 거리가 짧아서 충분)
+ *  - 압축률 / 오차 측정: test/test_track_simplify.c (합성 주행, 또는 1 Hz로 남긴 CSV 기록을 인자로)
+ */
+
+#ifndef INC_TRACK_SIMPLIFY_H_
+#define INC_TRACK_SIMPLIFY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRACK_SIMPLIFY_WINDOW        32u     // 들고 있는 후보 점 최대 수 (넘으면 저장)
+#define TRACK_SIMPLIFY_TOL_M         4.0f    // 선분에서 이만큼 벗어나면 저장
+#define TRACK_SIMPLIFY_SPEED_CMS     300     // 앵커 대비 속도 변화 (~11 km/h)
+#define TRACK_SIMPLIFY_HEADING_DDEG  200     // 앵커 대비 헤딩 변화 (20 deg)
+#define TRACK_SIMPLIFY_MAX_GAP_S     30u     // 저장한 점 사이 최대 간격
+
+// 궤적 점 (플래시 단위로 반올림한 값)
+typedef struct {
+    uint32_t utc_s;        // 2000-01-01 기준 초
+    uint32_t ms;           // 0~999
+    int32_t  lat;          // 1e-7 deg
+    int32_t  lon;
+    int32_t  alt_dm;       // 해발 0.1 m
+    int32_t  speed_cms;    // cm/s
+    int32_t  heading;      // 0.1 deg, 0~3599
+} track_point_t;
+
+void TrackSimplify_Reset(void);
+
+// 후보 점 하나. 저장할 점을 out에 시간 순서대로 채우고 그 개수 (0~2)
+//  - force: 이 점은 꼭 남김 (정차 지점 등)
+uint8_t TrackSimplify_Push(const track_point_t *pt, bool force, track_point_t out[2]);
+
+// 들고 있던 마지막 후보를 저장할 점으로 (주차/전원 저하 직전, 궤적 끝이 잘리지 않게). 개수 (0~1)
+uint8_t TrackSimplify_Flush(track_point_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_TRACK_SIMPLIFY_H_ */
@@ -0,0 +1,134 @@
+// trip_store.c
+#include "trip_store.h"
+#include "settings_storage.h"
+#include <string.h>
+
+// ----------------- 설정 -----------------
+#define TRIP_KEYS_PER_TRIP    3u         // 거리, 시간, 최고 속도
+#define TRIP_A_AUTO_RESET_S   (TRIP_A_AUTO_RESET_H * 3600u)
+
+// ----------------- 상태 -----------------
+static trip_stats_t s_trip[TRIP_COUNT];
+static float        s_frac_m        = 0.0f;  // 1 m 미만 나머지 (모든 트립 공통)
+static uint32_t     s_saved_odo_m   = 0u;    // 마지막 체크포인트 때 적산 거리
+static uint32_t     s_utc_s         = 0u;    // 최근 GPS 시각 (2000-01-01 기준 초), 0 = 모름
+static uint8_t      s_utc_checked   = 0u;    // 부팅 후 자동 리셋 판단 끝
+
+// ----------------- 헬퍼 -----------------
+static settings_key_t trip_key(trip_id_t id, uint8_t field)
+{
+    return (settings_key_t)(SETTINGS_KEY_TRIP_A_DIST_M + (id * TRIP_KEYS_PER_TRIP) + field);
+}
+
+static void trip_update_avg(trip_stats_t *t)
+{
+    if (t->time_ms > 1000u) {
+        float hours = (float)t->time_ms / 3600000.0f;
+        t->avg_speed_kmh = ((float)t->distance_m / 1000.0f) / hours;
+    } else {
+        t->avg_speed_kmh = 0.0f;
+    }
+}
+
+static void trip_persist(void)
+{
+    for (uint8_t id = 0u; id < TRIP_COUNT; ++id) {
+        const trip_stats_t *t = &s_trip[id];
+
+        // 값이 같으면 Settings_Set이 안 씀 → 바뀐 키만 append
+        Settings_Set(trip_key((trip_id_t)id, 0u), (int32_t)t->distance_m);
+        Settings_Set(trip_key((trip_id_t)id, 1u), (int32_t)(t->time_ms / 1000u));
+        Settings_Set(trip_key((trip_id_t)id, 2u), (int32_t)(t->top_speed_kmh * 10.0f));
+    }
+    if (s_utc_s != 0u) {
+        Settings_Set(SETTINGS_KEY_TRIP_LAST_UTC_S, (int32_t)s_utc_s);
+    }
+    s_saved_odo_m = s_trip[TRIP_ODO].distance_m;
+}
+
+// ----------------- API -----------------
+void TripStore_Init(void)
+{
+    memset(s_trip, 0, sizeof(s_trip));
+
+    for (uint8_t id = 0u; id < TRIP_COUNT; ++id) {
+        trip_stats_t *t = &s_trip[id];
+
+        t->distance_m    = (uint32_t)Settings_Get(trip_key((trip_id_t)id, 0u));
+        t->time_ms       = (uint32_t)Settings_Get(trip_key((trip_id_t)id, 1u)) * 1000u;
+        t->top_speed_kmh = (float)Settings_Get(trip_key((trip_id_t)id, 2u)) * 0.1f;
+        trip_update_avg(t);
+    }
+
+    s_frac_m      = 0.0f;
+    s_saved_odo_m = s_trip[TRIP_ODO].distance_m;
+    s_utc_s       = 0u;
+    s_utc_checked = 0u;
+}
+
+void TripStore_OnFix(const app_gps_state_t *gps)
+{
+    uint32_t utc_s = APP_GPS_UtcSeconds(gps);
+
+    if (gps->valid && utc_s != 0u) {
+        s_utc_s = utc_s;
+
+        // 부팅 후 첫 GPS 시각: 오래 꺼져 있었으면 새 주행으로 보고 TRIP_A 리셋
+        if (!s_utc_checked) {
+            uint32_t last = (uint32_t)Settings_Get(SETTINGS_KEY_TRIP_LAST_UTC_S);
+
+            s_utc_checked = 1u;
+            if (last != 0u && s_utc_s > last && (s_utc_s - last) > TRIP_A_AUTO_RESET_S) {
+                TripStore_Reset(TRIP_A);
+            }
+        }
+    }
+
+    if ((s_trip[TRIP_ODO].distance_m - s_saved_odo_m) >= TRIP_CHECKPOINT_M) {
+        trip_persist();
+    }
+}
+
+void TripStore_Add(float dist_m, uint32_t dt_ms, float speed_kmh)
+{
+    uint32_t whole = 0u;
+
+    if (dist_m > 0.0f) {
+        s_frac_m += dist_m;
+        whole     = (uint32_t)s_frac_m;
+        s_frac_m -= (float)whole;
+    }
+
+    for (uint8_t id = 0u; id < TRIP_COUNT; ++id) {
+        trip_stats_t *t = &s_trip[id];
+
+        t->distance_m += whole;
+        t->time_ms    += dt_ms;
+        if (speed_kmh > t->top_speed_kmh) {
+            t->top_speed_kmh = speed_kmh;
+        }
+        trip_update_avg(t);
+    }
+}
+
+void TripStore_Flush(void)
+{
+    trip_persist();
+}
+
+void TripStore_Reset(trip_id_t id)
+{
+    if (id >= TRIP_COUNT) {
+        return;
+    }
+    memset(&s_trip[id], 0, sizeof(s_trip[id]));
+    trip_persist();
+}
+
+const trip_stats_t *TripStore_Get(trip_id_t id)
+{
+    if (id >= TRIP_COUNT) {
+        return &s_trip[TRIP_A];
+    }
+    return &s_trip[id];
+}
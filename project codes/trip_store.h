@@ -0,0 +1,61 @@
+/*
+ * trip_store.h
+ *
+ *  트립/적산 거리 보존 (전원이 꺼져도 유지)
+ *  - TRIP_A  : 주행 트립. 마지막 저장 뒤 TRIP_A_AUTO_RESET_H 시간 넘게 꺼져 있었으면
+ *              다음 부팅 첫 GPS 시각에서 자동 리셋 (화면의 거리/시간/최고/평균 속도)
+ *  - TRIP_B  : 수동 트립. TripStore_Reset(TRIP_B)로만 리셋
+ *  - TRIP_ODO: 적산 거리, 리셋 없음
+ *  - 저장은 설정 키-값 로그(settings_storage)에 키별로: 거리가 TRIP_CHECKPOINT_M 늘 때마다
+ *    바뀐 키만 append (체크포인트당 ~50바이트). 주차 진입 / 전원 저하 때는 TripStore_Flush
+ */
+
+#ifndef INC_TRIP_STORE_H_
+#define INC_TRIP_STORE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "gps_app.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRIP_CHECKPOINT_M      200u    // 전원이 그냥 끊기면 최대 이만큼 잃음
+#define TRIP_A_AUTO_RESET_H    4u
+
+typedef enum {
+    TRIP_A = 0,
+    TRIP_B,
+    TRIP_ODO,
+    TRIP_COUNT
+} trip_id_t;
+
+typedef struct {
+    uint32_t distance_m;
+    uint32_t time_ms;          // fix가 들어온 전체 시간 (정차 포함)
+    float    top_speed_kmh;
+    float    avg_speed_kmh;    // 거리 / 시간
+} trip_stats_t;
+
+// 설정 로드(Settings_Load) 뒤 1회: 저장된 트립 값 복원
+void TripStore_Init(void);
+
+// 새 GPS epoch마다: 부팅 후 첫 UTC로 TRIP_A 자동 리셋 판단, 체크포인트 저장
+void TripStore_OnFix(const app_gps_state_t *gps);
+
+// 적분 결과 반영 (app_display의 트립 계산에서, 유효 fix일 때만)
+void TripStore_Add(float dist_m, uint32_t dt_ms, float speed_kmh);
+
+// 바뀐 값을 지금 전부 저장
+void TripStore_Flush(void);
+
+void TripStore_Reset(trip_id_t id);
+
+const trip_stats_t *TripStore_Get(trip_id_t id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_TRIP_STORE_H_ */
@@ -0,0 +1,486 @@
+// hal_shim.c (호스트 테스트용 HAL 흉내)
+#include "hal_shim.h"
+#include <sys/mman.h>
+#include <stdlib.h>
+
+// ----------------- 주변장치 인스턴스 -----------------
+static GPIO_TypeDef  s_gpio[4];
+static SPI_TypeDef   s_spi1;
+static TIM_TypeDef   s_tim[4];
+static USART_TypeDef s_usart1;
+static CRC_TypeDef   s_crc;
+static EXTI_TypeDef  s_exti;
+static RCC_TypeDef   s_rcc;
+static PWR_TypeDef   s_pwr;
+static CoreDebug_Type s_coredebug;
+static DWT_Type      s_dwt;
+static FLASH_TypeDef s_flash_regs;
+static SCB_Type      s_scb;
+static SysTick_Type  s_systick;
+static uint32_t      s_dummy[8];
+
+GPIO_TypeDef  *GPIOA = &s_gpio[0], *GPIOB = &s_gpio[1], *GPIOC = &s_gpio[2], *GPIOE = &s_gpio[3];
+SPI_TypeDef   *SPI1  = &s_spi1;
+TIM_TypeDef   *TIM2  = &s_tim[0], *TIM3 = &s_tim[1], *TIM4 = &s_tim[2], *TIM5 = &s_tim[3];
+USART_TypeDef *USART1 = &s_usart1;
+EXTI_TypeDef  *EXTI = &s_exti;
+RCC_TypeDef   *RCC  = &s_rcc;
+PWR_TypeDef   *PWR  = &s_pwr;
+CoreDebug_Type *CoreDebug = &s_coredebug;
+DWT_Type      *DWT  = &s_dwt;
+FLASH_TypeDef *FLASH = &s_flash_regs;
+SCB_Type      *SCB  = &s_scb;
+SysTick_Type  *SysTick = &s_systick;
+void *DMA2_Stream0 = &s_dummy[0], *DMA2_Stream2 = &s_dummy[1],
+     *DMA2_Stream3 = &s_dummy[2], *DMA2_Stream5 = &s_dummy[3];
+void *RTC  = &s_dummy[4];
+void *ADC1 = &s_dummy[5];
+
+FLASH_ProcessTypeDef pFlash;
+volatile uint32_t uwTick = 0u;
+uint32_t uwTickPrio = 0u;
+uint32_t SystemCoreClock = 100000000u;
+
+// main.c(CubeMX)가 만드는 핸들 (weak: main.c까지 같이 빌드하면 main.c 쪽이 쓰임)
+__weak UART_HandleTypeDef huart1 = { .Instance = &s_usart1 };
+__weak SPI_HandleTypeDef  hspi1  = { .Instance = &s_spi1 };
+__weak TIM_HandleTypeDef  htim3  = { .Instance = &s_tim[1] };
+__weak TIM_HandleTypeDef  htim4  = { .Instance = &s_tim[2] };
+__weak TIM_HandleTypeDef  htim5  = { .Instance = &s_tim[3] };
+__weak RTC_HandleTypeDef  hrtc;
+__weak ADC_HandleTypeDef  hadc1;
+__weak DMA_HandleTypeDef  hdma_spi1_tx;
+__weak DMA_HandleTypeDef  hdma_adc1;
+
+// ----------------- 공통 -----------------
+void (*shim_on_stop)(void)  = NULL;
+void (*shim_on_wfi)(void)   = NULL;
+void (*shim_on_reset)(void) = NULL;
+static uint32_t s_stop_count = 0u;
+static bool     s_rtc_armed  = false;
+static uint32_t s_rtc_counts = 0u;
+
+void Shim_Reset(void)
+{
+    uwTick = 0u;
+    for (unsigned i = 0u; i < 4u; ++i) {
+        s_gpio[i].IDR = 0xFFFFu;
+    }
+    shim_on_stop   = NULL;
+    shim_on_wfi    = NULL;
+    shim_on_reset  = NULL;
+    for (unsigned i = 0u; i < 4u; ++i) {
+        s_tim[i].CR1 = 0u;
+    }
+    s_stop_count   = 0u;
+    s_rtc_armed    = false;
+    s_rtc_counts   = 0u;
+    pFlash.Lock    = HAL_UNLOCKED;
+    s_flash_regs.SR = 0u;
+    s_spi1.SR      = SPI_SR_TXE;   // 레지스터 직접 전송은 바로 비는 것으로
+    hspi1.Lock     = HAL_UNLOCKED;
+}
+
+void Shim_SetTick(uint32_t ms) { uwTick = ms; }
+void Shim_Advance(uint32_t ms) { uwTick += ms; }
+
+uint32_t HAL_GetTick(void)          { return uwTick; }
+void     HAL_Delay(uint32_t ms)     { uwTick += ms; }
+void     HAL_Init(void)             { }
+void     HAL_IncTick(void)          { uwTick++; }
+HAL_StatusTypeDef HAL_InitTick(uint32_t prio) { (void)prio; return HAL_OK; }
+void     HAL_SuspendTick(void)      { }
+void     HAL_ResumeTick(void)       { }
+
+// ----------------- GPIO -----------------
+void HAL_GPIO_WritePin(GPIO_TypeDef *g, uint16_t pin, GPIO_PinState st)
+{
+    if (st == GPIO_PIN_SET) {
+        g->ODR |= pin;
+    } else {
+        g->ODR &= ~(uint32_t)pin;
+    }
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *g, uint16_t pin)
+{
+    return (g->IDR & pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *g, uint16_t pin)      { g->ODR ^= pin; }
+void HAL_GPIO_Init(GPIO_TypeDef *g, GPIO_InitTypeDef *i)    { (void)g; (void)i; }
+void HAL_GPIO_DeInit(GPIO_TypeDef *g, uint32_t pin)         { (void)g; (void)pin; }
+void HAL_GPIO_EXTI_IRQHandler(uint16_t pin)                 { HAL_GPIO_EXTI_Callback(pin); }
+__weak void HAL_GPIO_EXTI_Callback(uint16_t pin)            { (void)pin; }
+
+// ----------------- 플래시 -----------------
+static uint8_t *s_flash      = NULL;
+static int32_t  s_cut_after  = -1;
+static uint32_t s_flash_ops  = 0u;
+static uint32_t s_flash_erases = 0u;
+jmp_buf shim_cut_env;
+
+static const uint32_t s_sector_addr[9] = {
+    0x08000000u, 0x08004000u, 0x08008000u, 0x0800C000u,
+    0x08010000u, 0x08020000u, 0x08040000u, 0x08060000u, 0x08080000u
+};
+
+void Shim_FlashInit(void)
+{
+    if (s_flash == NULL) {
+        // 펌웨어는 플래시를 주소로 직접 읽으므로 같은 주소에 붙여야 함
+        void *p = mmap((void *)(uintptr_t)SHIM_FLASH_BASE, SHIM_FLASH_SIZE,
+                       PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+                       -1, 0);
+        if (p != (void *)(uintptr_t)SHIM_FLASH_BASE) {
+            fprintf(stderr, "shim: cannot map flash at 0x%08X\n", SHIM_FLASH_BASE);
+            exit(2);
+        }
+        s_flash = (uint8_t *)p;
+    }
+    Shim_FlashEraseAll();
+}
+
+void Shim_FlashEraseAll(void)
+{
+    memset(s_flash, 0xFF, SHIM_FLASH_SIZE);
+}
+
+uint8_t *Shim_FlashPtr(uint32_t addr)
+{
+    return s_flash + (addr - SHIM_FLASH_BASE);
+}
+
+void Shim_FlashCutAfter(int32_t n)
+{
+    s_cut_after = n;
+}
+
+uint32_t Shim_FlashOps(void)    { return s_flash_ops; }
+uint32_t Shim_FlashErases(void) { return s_flash_erases; }
+
+// true면 이 동작 직전에 전원 차단
+static bool shim_flash_cut_now(void)
+{
+    s_flash_ops++;
+    if (s_cut_after < 0) {
+        return false;
+    }
+    if (s_cut_after == 0) {
+        s_cut_after = -1;
+        return true;
+    }
+    s_cut_after--;
+    return false;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void) { return HAL_OK; }
+HAL_StatusTypeDef HAL_FLASH_Lock(void)   { return HAL_OK; }
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t type, uint32_t addr, uint64_t data)
+{
+    uint32_t n = (type == FLASH_TYPEPROGRAM_WORD) ? 4u : (type == FLASH_TYPEPROGRAM_HALFWORD) ? 2u : 1u;
+
+    if (addr < SHIM_FLASH_BASE || (addr + n) > (SHIM_FLASH_BASE + SHIM_FLASH_SIZE) || (addr % n) != 0u) {
+        return HAL_ERROR;
+    }
+    if (shim_flash_cut_now()) {
+        longjmp(shim_cut_env, 1);
+    }
+    // NOR 플래시: 0으로만 바꿀 수 있음 (덮어쓰기는 AND)
+    uint8_t *p = Shim_FlashPtr(addr);
+    for (uint32_t i = 0u; i < n; ++i) {
+        p[i] &= (uint8_t)(data >> (8u * i));
+    }
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef shim_erase_sector(uint32_t sector)
+{
+    if (sector >= 8u) {
+        return HAL_ERROR;
+    }
+    uint32_t len = s_sector_addr[sector + 1u] - s_sector_addr[sector];
+    uint8_t *p   = Shim_FlashPtr(s_sector_addr[sector]);
+
+    s_flash_erases++;
+    if (shim_flash_cut_now()) {
+        memset(p, 0xFF, len / 2u);   // 지우다 만 섹터
+        longjmp(shim_cut_env, 1);
+    }
+    memset(p, 0xFF, len);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *e, uint32_t *err)
+{
+    *err = 0xFFFFFFFFu;
+    for (uint32_t i = 0u; i < e->NbSectors; ++i) {
+        if (shim_erase_sector(e->Sector + i) != HAL_OK) {
+            *err = e->Sector + i;
+            return HAL_ERROR;
+        }
+    }
+    return HAL_OK;
+}
+
+// 인터럽트 erase도 호스트에서는 바로 끝내고 완료 콜백
+HAL_StatusTypeDef HAL_FLASHEx_Erase_IT(FLASH_EraseInitTypeDef *e)
+{
+    for (uint32_t i = 0u; i < e->NbSectors; ++i) {
+        if (shim_erase_sector(e->Sector + i) != HAL_OK) {
+            HAL_FLASH_OperationErrorCallback(e->Sector + i);
+            return HAL_ERROR;
+        }
+        HAL_FLASH_EndOfOperationCallback(e->Sector + i);
+    }
+    return HAL_OK;
+}
+
+void FLASH_Erase_Sector(uint32_t sector, uint8_t range)
+{
+    (void)range;
+    (void)shim_erase_sector(sector);
+}
+
+void HAL_FLASH_IRQHandler(void) { }
+__weak void HAL_FLASH_EndOfOperationCallback(uint32_t v) { (void)v; }
+__weak void HAL_FLASH_OperationErrorCallback(uint32_t v) { (void)v; }
+
+// ----------------- CRC 유닛 -----------------
+// C에서는 레지스터 쓰기를 가로챌 수 없어서, CRC 매크로가 부를 때마다 직전 접근을 반영:
+//  - CR에 RESET이 써 있으면 초기값으로
+//  - DR이 지난번에 남겨 둔 값과 다르면 그 값이 새로 쓰인 데이터 워드
+//  - 그 뒤 DR에 현재 결과를 남겨 둠 (읽기는 이 값을 봄)
+// 데이터 워드가 우연히 현재 결과와 같으면 놓치지만 (2^-32) 테스트 데이터에서는 무시
+static uint32_t s_crc_state = 0xFFFFFFFFu;
+static uint32_t s_crc_left  = 0xFFFFFFFFu;
+
+static uint32_t shim_crc_feed(uint32_t crc, uint32_t w)
+{
+    crc ^= w;
+    for (unsigned i = 0u; i < 32u; ++i) {
+        crc = (crc & 0x80000000u) ? ((crc << 1) ^ 0x04C11DB7u) : (crc << 1);
+    }
+    return crc;
+}
+
+CRC_TypeDef *shim_crc_port(void)
+{
+    if (s_crc.CR & CRC_CR_RESET) {
+        s_crc.CR    = 0u;
+        s_crc_state = 0xFFFFFFFFu;
+    } else if (s_crc.DR != s_crc_left) {
+        s_crc_state = shim_crc_feed(s_crc_state, s_crc.DR);
+    }
+    s_crc.DR   = s_crc_state;
+    s_crc_left = s_crc_state;
+    return &s_crc;
+}
+
+// ----------------- Cortex 내장 함수 -----------------
+uint32_t __RBIT(uint32_t v)
+{
+    uint32_t r = 0u;
+    for (unsigned i = 0u; i < 32u; ++i) {
+        r = (r << 1) | (v & 1u);
+        v >>= 1;
+    }
+    return r;
+}
+
+uint32_t __CLZ(uint32_t v) { return v ? (uint32_t)__builtin_clz(v) : 32u; }
+uint32_t __REV(uint32_t v) { return __builtin_bswap32(v); }
+void __disable_irq(void) { }
+void __enable_irq(void)  { }
+void __WFI(void) { if (shim_on_wfi != NULL) { shim_on_wfi(); } }
+void __DSB(void) { }
+void __ISB(void) { }
+void __NOP(void) { }
+void __DMB(void) { }
+uint32_t __get_PRIMASK(void) { return 0u; }
+void __set_PRIMASK(uint32_t v) { (void)v; }
+uint8_t  __LDREXB(volatile uint8_t *p) { return *p; }
+uint32_t __STREXB(uint8_t v, volatile uint8_t *p) { *p = v; return 0u; }
+void NVIC_SystemReset(void)
+{
+    if (shim_on_reset != NULL) {
+        shim_on_reset();
+    }
+}
+void HAL_NVIC_SetPriority(IRQn_Type n, uint32_t a, uint32_t b) { (void)n; (void)a; (void)b; }
+void HAL_NVIC_EnableIRQ(IRQn_Type n)  { (void)n; }
+void HAL_NVIC_DisableIRQ(IRQn_Type n) { (void)n; }
+
+// ----------------- PWR / RTC -----------------
+uint32_t Shim_StopCount(void)     { return s_stop_count; }
+bool     Shim_RtcWakeArmed(void)  { return s_rtc_armed; }
+uint32_t Shim_RtcWakeCounts(void) { return s_rtc_counts; }
+
+void HAL_PWR_EnterSTOPMode(uint32_t reg, uint8_t entry)
+{
+    (void)reg;
+    (void)entry;
+    s_stop_count++;
+    if (shim_on_stop != NULL) {
+        shim_on_stop();
+    }
+}
+
+void HAL_PWR_EnterSLEEPMode(uint32_t reg, uint8_t entry) { (void)reg; (void)entry; }
+void HAL_PWR_ConfigPVD(PWR_PVDTypeDef *c) { (void)c; }
+void HAL_PWR_EnablePVD(void)  { }
+void HAL_PWR_DisablePVD(void) { }
+void HAL_PWR_PVD_IRQHandler(void) { HAL_PWR_PVDCallback(); }
+__weak void HAL_PWR_PVDCallback(void) { }
+void HAL_PWREx_EnableFlashPowerDown(void) { }
+void HAL_PWR_EnableBkUpAccess(void) { }
+
+HAL_StatusTypeDef HAL_RTC_Init(RTC_HandleTypeDef *h) { (void)h; return HAL_OK; }
+
+HAL_StatusTypeDef HAL_RTCEx_SetWakeUpTimer_IT(RTC_HandleTypeDef *h, uint32_t counts, uint32_t clk)
+{
+    (void)h;
+    (void)clk;
+    s_rtc_armed  = true;
+    s_rtc_counts = counts;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTCEx_DeactivateWakeUpTimer(RTC_HandleTypeDef *h)
+{
+    (void)h;
+    s_rtc_armed = false;
+    return HAL_OK;
+}
+
+void HAL_RTCEx_WakeUpTimerIRQHandler(RTC_HandleTypeDef *h) { HAL_RTCEx_WakeUpTimerEventCallback(h); }
+__weak void HAL_RTCEx_WakeUpTimerEventCallback(RTC_HandleTypeDef *h) { (void)h; }
+
+// ----------------- RCC -----------------
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *o)               { (void)o; return HAL_OK; }
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *c, uint32_t l) { (void)c; (void)l; return HAL_OK; }
+HAL_StatusTypeDef HAL_RCCEx_PeriphCLKConfig(RCC_PeriphCLKInitTypeDef *p) { (void)p; return HAL_OK; }
+uint32_t HAL_RCC_GetHCLKFreq(void)     { return SystemCoreClock; }
+uint32_t HAL_RCC_GetPCLK1Freq(void)    { return SystemCoreClock / 2u; }
+uint32_t HAL_RCC_GetPCLK2Freq(void)    { return SystemCoreClock; }
+uint32_t HAL_RCC_GetSysClockFreq(void) { return SystemCoreClock; }
+void HAL_RCC_GetClockConfig(RCC_ClkInitTypeDef *c, uint32_t *l) { memset(c, 0, sizeof(*c)); *l = 0u; }
+
+// ----------------- 나머지 주변장치 (동작 없음) -----------------
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *h)   { (void)h; return HAL_OK; }
+HAL_StatusTypeDef HAL_DMA_DeInit(DMA_HandleTypeDef *h) { (void)h; return HAL_OK; }
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef *h)  { (void)h; return HAL_OK; }
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *h)          { (void)h; }
+
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *h) { (void)h; return HAL_OK; }
+// 블로킹 전송은 마지막 내용을 남겨 둠 (max7219_SendData 확인용)
+static uint8_t  s_spi_last[16];
+static uint16_t s_spi_last_len = 0u;
+
+uint16_t Shim_SpiLastTx(uint8_t *out, uint16_t max)
+{
+    uint16_t n = (s_spi_last_len < max) ? s_spi_last_len : max;
+    memcpy(out, s_spi_last, n);
+    return n;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *h, uint8_t *d, uint16_t n, uint32_t t)
+{
+    (void)t;
+    if (h->Lock == HAL_LOCKED) {
+        return HAL_BUSY;   // 실제 HAL의 __HAL_LOCK
+    }
+    s_spi_last_len = (n < sizeof(s_spi_last)) ? n : (uint16_t)sizeof(s_spi_last);
+    memcpy(s_spi_last, d, s_spi_last_len);
+    return HAL_OK;
+}
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *h, uint8_t *d, uint16_t n)
+{
+    (void)d; (void)n;
+    HAL_SPI_TxCpltCallback(h);
+    return HAL_OK;
+}
+HAL_StatusTypeDef HAL_SPI_DMAStop(SPI_HandleTypeDef *h) { (void)h; return HAL_OK; }
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef *h)   { (void)h; return HAL_OK; }
+__weak void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *h) { (void)h; }
+__weak void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *h)  { (void)h; }
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *h)     { (void)h; return HAL_OK; }
+__weak void HAL_TIM_MspPostInit(TIM_HandleTypeDef *h)       { (void)h; }   // stm32f4xx_hal_msp.c (핀 설정)
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *h) { h->Instance->CR1 |= 1u; return HAL_OK; }    // CEN
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *h)  { h->Instance->CR1 &= ~1u; return HAL_OK; }
+HAL_StatusTypeDef HAL_TIM_PWM_Init(TIM_HandleTypeDef *h)      { (void)h; return HAL_OK; }
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *h, uint32_t c) { (void)h; (void)c; return HAL_OK; }
+HAL_StatusTypeDef HAL_TIM_ConfigClockSource(TIM_HandleTypeDef *h, TIM_ClockConfigTypeDef *c)
+{
+    (void)h; (void)c;
+    return HAL_OK;
+}
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef *h, TIM_MasterConfigTypeDef *c)
+{
+    (void)h; (void)c;
+    return HAL_OK;
+}
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef *h, TIM_OC_InitTypeDef *c, uint32_t ch)
+{
+    (void)h; (void)c; (void)ch;
+    return HAL_OK;
+}
+void HAL_TIM_IRQHandler(TIM_HandleTypeDef *h) { HAL_TIM_PeriodElapsedCallback(h); }
+__weak void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *h) { (void)h; }
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *h)   { (void)h; return HAL_OK; }
+HAL_StatusTypeDef HAL_UART_DeInit(UART_HandleTypeDef *h) { (void)h; return HAL_OK; }
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *h, uint8_t *d, uint16_t n, uint32_t t)
+{
+    (void)h; (void)d; (void)n; (void)t;
+    return HAL_OK;
+}
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *h, uint8_t *d, uint16_t n)
+{
+    (void)h; (void)d; (void)n;
+    return HAL_OK;
+}
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *h, uint8_t *d, uint16_t n)
+{
+    (void)h; (void)d; (void)n;
+    return HAL_OK;
+}
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *h, uint8_t *d, uint16_t n)
+{
+    (void)h; (void)d; (void)n;
+    return HAL_OK;
+}
+HAL_StatusTypeDef HAL_UART_Abort(UART_HandleTypeDef *h)         { (void)h; return HAL_OK; }
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *h)  { (void)h; return HAL_OK; }
+HAL_StatusTypeDef HAL_UART_AbortTransmit(UART_HandleTypeDef *h) { (void)h; return HAL_OK; }
+HAL_StatusTypeDef HAL_UART_DMAStop(UART_HandleTypeDef *h)       { (void)h; return HAL_OK; }
+void HAL_UART_IRQHandler(UART_HandleTypeDef *h) { (void)h; }
+__weak void HAL_UART_RxCpltCallback(UART_HandleTypeDef *h) { (void)h; }
+__weak void HAL_UART_TxCpltCallback(UART_HandleTypeDef *h) { (void)h; }
+
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *h) { (void)h; return HAL_OK; }
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *h, ADC_ChannelConfTypeDef *c)
+{
+    (void)h; (void)c;
+    return HAL_OK;
+}
+// DMA 대상 버퍼를 기억 (테스트가 변환 결과를 직접 써 넣음, 하프워드 전송 기준)
+static uint16_t *s_adc_dma_buf = NULL;
+static uint32_t  s_adc_dma_len = 0u;
+
+uint16_t *Shim_AdcDmaBuf(uint32_t *len)
+{
+    *len = s_adc_dma_len;
+    return s_adc_dma_buf;
+}
+
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *h, uint32_t *d, uint32_t n)
+{
+    (void)h;
+    s_adc_dma_buf = (uint16_t *)d;
+    s_adc_dma_len = n;
+    return HAL_OK;
+}
+HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef *h) { (void)h; return HAL_OK; }
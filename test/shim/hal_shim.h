@@ -0,0 +1,69 @@
+/*
+ * hal_shim.h (호스트 테스트용)
+ *
+ *  hal_shim.c 가 흉내 내는 하드웨어를 테스트에서 조작하는 API
+ *  - 틱: uwTick 그대로 (Shim_SetTick / Shim_Advance)
+ *  - GPIO 입력: GPIOx->IDR 비트 (HAL_GPIO_ReadPin이 그대로 읽음)
+ *  - 플래시: 0x08000000 에 512 KB RAM을 붙여 둠 → 펌웨어가 주소로 직접 읽어도 됨
+ *      program은 1→0 비트만 (AND), erase는 섹터 전체 0xFF
+ *      전원 차단 주입: Shim_FlashCutAfter(n) 뒤 n번째 program/erase 에서 longjmp
+ *  - SPI: 블로킹 전송 마지막 내용만 보관
+ *  - ADC: DMA 버퍼 주소만 알려 줌 (테스트가 변환값을 써 넣음)
+ *  - CRC 유닛: 0x04C11DB7, MSB first, 32비트 워드 (실제 유닛과 같은 규칙)
+ *  - STOP 진입 / WFI: 훅 함수 (시간 진행, RTC/버튼 인터럽트 흉내)
+ *  - 타이머: HAL_TIM_Base_Start_IT/Stop_IT 가 TIMx->CR1 bit0(CEN)만 켜고 끔
+ */
+#ifndef SHIM_HAL_SHIM_H_
+#define SHIM_HAL_SHIM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <setjmp.h>
+#include "stm32f4xx_hal.h"
+
+#define SHIM_FLASH_BASE    0x08000000u
+#define SHIM_FLASH_SIZE    0x00080000u   // STM32F411CE 512 KB (섹터 0~7)
+
+// ----------------- 공통 -----------------
+// 틱 0, GPIO 입력 전부 HIGH, 훅/카운터 초기화 (플래시 내용은 그대로)
+void Shim_Reset(void);
+void Shim_SetTick(uint32_t ms);
+void Shim_Advance(uint32_t ms);
+
+// ----------------- 플래시 -----------------
+void     Shim_FlashInit(void);             // 처음 1회: 매핑 + 전부 0xFF
+void     Shim_FlashEraseAll(void);
+uint8_t *Shim_FlashPtr(uint32_t addr);
+
+// n번째(0부터) program/erase 직전에 전원이 나감 → shim_cut_env 로 longjmp(1)
+//  - erase 도중이면 섹터 앞쪽 절반만 지워진 상태로 남김 (지우다 만 섹터)
+//  - n < 0: 끊지 않음
+void     Shim_FlashCutAfter(int32_t n);
+extern jmp_buf  shim_cut_env;
+uint32_t Shim_FlashOps(void);              // 지금까지 program + erase 수
+uint32_t Shim_FlashErases(void);
+
+// ----------------- SPI -----------------
+// 마지막 HAL_SPI_Transmit(블로킹) 바이트를 out에 복사, 복사한 길이 반환
+// hspi.Lock이 잡혀 있으면 HAL_SPI_Transmit은 HAL_BUSY (끊긴 블로킹 전송 흉내)
+// SPI1 레지스터: SR은 늘 TXE, !BSY / DR은 마지막으로 쓴 바이트만 남음
+uint16_t Shim_SpiLastTx(uint8_t *out, uint16_t max);
+
+// ----------------- ADC -----------------
+// 마지막 HAL_ADC_Start_DMA 버퍼 (하프워드), 시작 전이면 NULL
+uint16_t *Shim_AdcDmaBuf(uint32_t *len);
+
+// ----------------- STOP / 인터럽트 -----------------
+// HAL_PWR_EnterSTOPMode 에서 부름 (NULL이면 그냥 반환)
+extern void (*shim_on_stop)(void);
+// __WFI 에서 부름 (스케줄러가 할 일 없을 때)
+extern void (*shim_on_wfi)(void);
+uint32_t Shim_StopCount(void);
+// NVIC_SystemReset 에서 부름 (NULL이면 그냥 반환, 보통 longjmp로 빠져나감)
+extern void (*shim_on_reset)(void);
+
+// RTC wakeup 타이머 (HAL_RTCEx_SetWakeUpTimer_IT 로 잡힌 값, 꺼져 있으면 armed=false)
+bool     Shim_RtcWakeArmed(void);
+uint32_t Shim_RtcWakeCounts(void);
+
+#endif /* SHIM_HAL_SHIM_H_ */
@@ -0,0 +1,297 @@
+/*
+ * stm32f4xx_hal.h (호스트 테스트용 shim)
+ *
+ *  펌웨어 소스를 PC에서 그대로 컴파일하려고 HAL 타입/상수/함수 선언만 흉내 냄.
+ *  - 동작이 필요한 것(틱, GPIO 입력, 플래시, CRC 유닛, STOP 진입)은 hal_shim.c
+ *  - 나머지 함수는 hal_shim.c에서 HAL_OK만 돌려줌
+ */
+#ifndef SHIM_STM32F4XX_HAL_H_
+#define SHIM_STM32F4XX_HAL_H_
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdbool.h>
+#define __IO volatile
+typedef enum { HAL_OK=0, HAL_ERROR, HAL_BUSY, HAL_TIMEOUT } HAL_StatusTypeDef;
+typedef enum { HAL_UNLOCKED = 0, HAL_LOCKED } HAL_LockTypeDef;
+typedef enum { GPIO_PIN_RESET=0, GPIO_PIN_SET } GPIO_PinState;
+typedef struct { uint32_t MODER, IDR, ODR, BSRR; } GPIO_TypeDef;
+extern GPIO_TypeDef *GPIOA, *GPIOB, *GPIOC, *GPIOE;
+#define GPIO_PIN_0 1u
+#define GPIO_PIN_1 2u
+#define GPIO_PIN_4 0x10u
+#define GPIO_PIN_5 0x20u
+#define GPIO_PIN_6 0x40u
+#define GPIO_PIN_7 0x80u
+#define GPIO_PIN_9 0x200u
+#define GPIO_PIN_10 0x400u
+#define GPIO_PIN_11 0x800u
+#define GPIO_PIN_12 0x1000u
+#define GPIO_PIN_13 0x2000u
+typedef struct { uint32_t Pin, Mode, Pull, Speed, Alternate; } GPIO_InitTypeDef;
+enum { GPIO_MODE_INPUT, GPIO_MODE_OUTPUT_PP, GPIO_MODE_AF_PP, GPIO_MODE_ANALOG, GPIO_MODE_IT_RISING_FALLING, GPIO_MODE_IT_FALLING, GPIO_MODE_IT_RISING };
+enum { GPIO_NOPULL, GPIO_PULLUP, GPIO_PULLDOWN };
+enum { GPIO_SPEED_FREQ_LOW, GPIO_SPEED_FREQ_VERY_HIGH };
+#define GPIO_AF5_SPI1 5
+#define GPIO_AF7_USART1 7
+#define GPIO_AF2_TIM4 2
+#define GPIO_AF10_OTG_FS 10
+void HAL_GPIO_WritePin(GPIO_TypeDef*, uint16_t, GPIO_PinState);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef*, uint16_t);
+void HAL_GPIO_TogglePin(GPIO_TypeDef*, uint16_t);
+void HAL_GPIO_Init(GPIO_TypeDef*, GPIO_InitTypeDef*);
+void HAL_GPIO_DeInit(GPIO_TypeDef*, uint32_t);
+void HAL_GPIO_EXTI_IRQHandler(uint16_t);
+void HAL_GPIO_EXTI_Callback(uint16_t);
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t);
+void HAL_Init(void);
+void HAL_IncTick(void);
+HAL_StatusTypeDef HAL_InitTick(uint32_t);
+extern volatile uint32_t uwTick;
+extern uint32_t uwTickPrio;
+extern uint32_t SystemCoreClock;
+/* DMA */
+typedef struct { uint32_t Channel, Direction, PeriphInc, MemInc, PeriphDataAlignment, MemDataAlignment, Mode, Priority, FIFOMode; } DMA_InitTypeDef;
+typedef struct { void *Instance; DMA_InitTypeDef Init; void *Parent; } DMA_HandleTypeDef;
+extern void *DMA2_Stream0, *DMA2_Stream2, *DMA2_Stream3, *DMA2_Stream5;
+enum { DMA_CHANNEL_0, DMA_CHANNEL_3, DMA_CHANNEL_4 };
+enum { DMA_MEMORY_TO_PERIPH, DMA_PERIPH_TO_MEMORY };
+enum { DMA_PINC_DISABLE, DMA_MINC_ENABLE, DMA_MINC_DISABLE };
+enum { DMA_PDATAALIGN_BYTE, DMA_MDATAALIGN_BYTE, DMA_PDATAALIGN_HALFWORD, DMA_MDATAALIGN_HALFWORD };
+enum { DMA_NORMAL, DMA_CIRCULAR };
+enum { DMA_PRIORITY_LOW, DMA_PRIORITY_MEDIUM, DMA_PRIORITY_HIGH };
+enum { DMA_FIFOMODE_DISABLE };
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef*);
+HAL_StatusTypeDef HAL_DMA_DeInit(DMA_HandleTypeDef*);
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef*);
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef*);
+#define __HAL_LINKDMA(h, f, d) do{ (h)->f = &(d); (d).Parent = (h);}while(0)
+/* SPI */
+typedef struct { uint32_t Mode, Direction, DataSize, CLKPolarity, CLKPhase, NSS, BaudRatePrescaler, FirstBit, TIMode, CRCCalculation, CRCPolynomial; } SPI_InitTypeDef;
+typedef struct { uint32_t CR1, CR2, SR, DR; } SPI_TypeDef;
+typedef struct SPI_HandleTypeDef { SPI_TypeDef *Instance; SPI_InitTypeDef Init; DMA_HandleTypeDef *hdmatx; DMA_HandleTypeDef *hdmarx; HAL_LockTypeDef Lock; } SPI_HandleTypeDef;
+extern SPI_TypeDef *SPI1;
+enum { SPI_MODE_MASTER, SPI_DIRECTION_2LINES, SPI_DATASIZE_8BIT, SPI_POLARITY_LOW, SPI_PHASE_1EDGE, SPI_NSS_SOFT, SPI_FIRSTBIT_MSB, SPI_TIMODE_DISABLE, SPI_CRCCALCULATION_DISABLE };
+#define SPI_BAUDRATEPRESCALER_2 0x00u
+#define SPI_BAUDRATEPRESCALER_4 0x08u
+#define SPI_BAUDRATEPRESCALER_8 0x10u
+#define SPI_BAUDRATEPRESCALER_16 0x18u
+#define SPI_BAUDRATEPRESCALER_32 0x20u
+#define SPI_BAUDRATEPRESCALER_64 0x28u
+#define SPI_BAUDRATEPRESCALER_128 0x30u
+#define SPI_BAUDRATEPRESCALER_256 0x38u
+#define SPI_CR1_BR 0x38u
+#define SPI_CR1_SPE 0x40u
+#define SPI_CR2_RXDMAEN 0x01u
+#define SPI_CR2_TXDMAEN 0x02u
+#define SPI_SR_TXE 0x02u
+#define SPI_SR_BSY 0x80u
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef*);
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef*, uint8_t*, uint16_t, uint32_t);
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef*, uint8_t*, uint16_t);
+HAL_StatusTypeDef HAL_SPI_DMAStop(SPI_HandleTypeDef*);
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef*);
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef*);
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef*);
+#define __HAL_SPI_DISABLE(h) ((void)(h))
+#define __HAL_SPI_ENABLE(h) ((void)(h))
+#define HAL_MAX_DELAY 0xFFFFFFFFu
+/* TIM */
+typedef struct { uint32_t Prescaler, CounterMode, Period, ClockDivision, AutoReloadPreload; } TIM_Base_InitTypeDef;
+typedef struct { uint32_t CR1, PSC, ARR, CCR1, CNT, EGR; } TIM_TypeDef;
+typedef struct { TIM_TypeDef *Instance; TIM_Base_InitTypeDef Init; } TIM_HandleTypeDef;
+extern TIM_TypeDef *TIM2, *TIM3, *TIM4, *TIM5;
+typedef struct { uint32_t ClockSource; } TIM_ClockConfigTypeDef;
+typedef struct { uint32_t MasterOutputTrigger, MasterSlaveMode; } TIM_MasterConfigTypeDef;
+typedef struct { uint32_t OCMode, Pulse, OCPolarity, OCFastMode; } TIM_OC_InitTypeDef;
+enum { TIM_COUNTERMODE_UP, TIM_CLOCKDIVISION_DIV1, TIM_AUTORELOAD_PRELOAD_DISABLE, TIM_CLOCKSOURCE_INTERNAL, TIM_TRGO_RESET, TIM_MASTERSLAVEMODE_DISABLE, TIM_OCMODE_PWM1, TIM_OCPOLARITY_HIGH, TIM_OCFAST_DISABLE };
+#define TIM_CHANNEL_1 0u
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef*);
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef*);
+HAL_StatusTypeDef HAL_TIM_PWM_Init(TIM_HandleTypeDef*);
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef*, uint32_t);
+HAL_StatusTypeDef HAL_TIM_ConfigClockSource(TIM_HandleTypeDef*, TIM_ClockConfigTypeDef*);
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef*, TIM_MasterConfigTypeDef*);
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef*, TIM_OC_InitTypeDef*, uint32_t);
+void HAL_TIM_IRQHandler(TIM_HandleTypeDef*);
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef*);
+#define __HAL_TIM_SET_COMPARE(h,c,v) ((h)->Instance->CCR1 = (v))
+#define __HAL_TIM_SET_AUTORELOAD(h,v) ((h)->Instance->ARR = (v))
+#define __HAL_TIM_SET_PRESCALER(h,v) ((h)->Instance->PSC = (v))
+#define __HAL_TIM_GET_AUTORELOAD(h) ((h)->Instance->ARR)
+#define __HAL_TIM_GET_COMPARE(h,c) ((h)->Instance->CCR1)
+#define __HAL_TIM_SET_COUNTER(h,v) ((h)->Instance->CNT = (v))
+/* UART */
+typedef struct { uint32_t BaudRate, WordLength, StopBits, Parity, Mode, HwFlowCtl, OverSampling; } UART_InitTypeDef;
+typedef struct { uint32_t SR, DR, BRR, CR1; } USART_TypeDef;
+typedef struct UART_HandleTypeDef { USART_TypeDef *Instance; UART_InitTypeDef Init; DMA_HandleTypeDef *hdmatx; DMA_HandleTypeDef *hdmarx; volatile uint32_t gState; } UART_HandleTypeDef;
+extern USART_TypeDef *USART1;
+enum { UART_WORDLENGTH_8B, UART_STOPBITS_1, UART_PARITY_NONE, UART_MODE_TX_RX, UART_HWCONTROL_NONE, UART_OVERSAMPLING_16 };
+#define HAL_UART_STATE_READY 0x20u
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef*);
+HAL_StatusTypeDef HAL_UART_DeInit(UART_HandleTypeDef*);
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef*, uint8_t*, uint16_t, uint32_t);
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef*, uint8_t*, uint16_t);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef*, uint8_t*, uint16_t);
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef*, uint8_t*, uint16_t);
+HAL_StatusTypeDef HAL_UART_Abort(UART_HandleTypeDef*);
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef*);
+HAL_StatusTypeDef HAL_UART_AbortTransmit(UART_HandleTypeDef*);
+HAL_StatusTypeDef HAL_UART_DMAStop(UART_HandleTypeDef*);
+void HAL_UART_IRQHandler(UART_HandleTypeDef*);
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef*);
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef*);
+/* FLASH */
+typedef struct { uint32_t TypeErase, Banks, Sector, NbSectors, VoltageRange; } FLASH_EraseInitTypeDef;
+enum { FLASH_TYPEERASE_SECTORS };
+enum { FLASH_VOLTAGE_RANGE_3 = 2 };
+enum { FLASH_TYPEPROGRAM_BYTE, FLASH_TYPEPROGRAM_HALFWORD, FLASH_TYPEPROGRAM_WORD };
+#define FLASH_SECTOR_4 4u
+#define FLASH_SECTOR_5 5u
+#define FLASH_SECTOR_6 6u
+#define FLASH_SECTOR_7 7u
+enum { FLASH_LATENCY_0, FLASH_LATENCY_1, FLASH_LATENCY_2, FLASH_LATENCY_3 };
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t, uint32_t, uint64_t);
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef*, uint32_t*);
+HAL_StatusTypeDef HAL_FLASHEx_Erase_IT(FLASH_EraseInitTypeDef*);
+void HAL_FLASH_IRQHandler(void);
+void HAL_FLASH_EndOfOperationCallback(uint32_t);
+void HAL_FLASH_OperationErrorCallback(uint32_t);
+void FLASH_Erase_Sector(uint32_t, uint8_t);
+/* RCC / PWR */
+typedef struct { uint32_t PLLState, PLLSource, PLLM, PLLN, PLLP, PLLQ; } RCC_PLLInitTypeDef;
+typedef struct { uint32_t OscillatorType, HSEState, LSEState, HSIState, HSICalibrationValue, LSIState; RCC_PLLInitTypeDef PLL; } RCC_OscInitTypeDef;
+typedef struct { uint32_t ClockType, SYSCLKSource, AHBCLKDivider, APB1CLKDivider, APB2CLKDivider; } RCC_ClkInitTypeDef;
+typedef struct { uint32_t PeriphClockSelection, RTCClockSelection; } RCC_PeriphCLKInitTypeDef;
+enum { RCC_OSCILLATORTYPE_HSI=1, RCC_OSCILLATORTYPE_LSI=8, RCC_HSI_ON=1, RCC_LSI_ON=1, RCC_HSICALIBRATION_DEFAULT=16, RCC_PLL_ON=2, RCC_PLL_NONE=0, RCC_PLL_OFF=1, RCC_PLLSOURCE_HSI=0 };
+enum { RCC_PLLP_DIV2=2, RCC_PLLP_DIV4=4, RCC_PLLP_DIV6=6, RCC_PLLP_DIV8=8 };
+enum { RCC_CLOCKTYPE_SYSCLK=1, RCC_CLOCKTYPE_HCLK=2, RCC_CLOCKTYPE_PCLK1=4, RCC_CLOCKTYPE_PCLK2=8 };
+enum { RCC_SYSCLKSOURCE_HSI, RCC_SYSCLKSOURCE_PLLCLK };
+enum { RCC_SYSCLK_DIV1, RCC_SYSCLK_DIV2, RCC_SYSCLK_DIV4 };
+enum { RCC_HCLK_DIV1, RCC_HCLK_DIV2, RCC_HCLK_DIV4 };
+enum { RCC_PERIPHCLK_RTC = 1, RCC_RTCCLKSOURCE_LSI = 2 };
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef*);
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef*, uint32_t);
+HAL_StatusTypeDef HAL_RCCEx_PeriphCLKConfig(RCC_PeriphCLKInitTypeDef*);
+uint32_t HAL_RCC_GetHCLKFreq(void);
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+uint32_t HAL_RCC_GetPCLK2Freq(void);
+uint32_t HAL_RCC_GetSysClockFreq(void);
+void HAL_RCC_GetClockConfig(RCC_ClkInitTypeDef*, uint32_t*);
+#define __HAL_RCC_PWR_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_SYSCFG_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_GPIOA_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_GPIOB_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_SPI1_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_SPI1_CLK_DISABLE() do{}while(0)
+#define __HAL_RCC_DMA2_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_CRC_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_ADC1_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_ADC1_CLK_DISABLE() do{}while(0)
+#define __HAL_RCC_RTC_ENABLE() do{}while(0)
+#define __HAL_RCC_USB_OTG_FS_CLK_ENABLE() do{}while(0)
+#define __HAL_PWR_VOLTAGESCALING_CONFIG(x) do{}while(0)
+enum { PWR_REGULATOR_VOLTAGE_SCALE1, PWR_REGULATOR_VOLTAGE_SCALE2, PWR_REGULATOR_VOLTAGE_SCALE3 };
+typedef struct { uint32_t PVDLevel, Mode; } PWR_PVDTypeDef;
+enum { PWR_PVDLEVEL_5, PWR_PVDLEVEL_6, PWR_PVDLEVEL_7, PWR_PVD_MODE_IT_RISING, PWR_PVD_MODE_IT_FALLING, PWR_PVD_MODE_IT_RISING_FALLING };
+enum { PWR_MAINREGULATOR_ON, PWR_LOWPOWERREGULATOR_ON, PWR_SLEEPENTRY_WFI, PWR_STOPENTRY_WFI };
+void HAL_PWR_ConfigPVD(PWR_PVDTypeDef*);
+void HAL_PWR_EnablePVD(void);
+void HAL_PWR_DisablePVD(void);
+void HAL_PWR_PVD_IRQHandler(void);
+void HAL_PWR_PVDCallback(void);
+void HAL_PWR_EnterSTOPMode(uint32_t, uint8_t);
+void HAL_PWR_EnterSLEEPMode(uint32_t, uint8_t);
+void HAL_PWREx_EnableFlashPowerDown(void);
+void HAL_PWR_EnableBkUpAccess(void);
+#define __HAL_PWR_GET_FLAG(f) 0
+#define PWR_FLAG_PVDO 4
+/* RTC */
+typedef struct { uint32_t HourFormat, AsynchPrediv, SynchPrediv, OutPut, OutPutPolarity, OutPutType; } RTC_InitTypeDef;
+typedef struct { void *Instance; RTC_InitTypeDef Init; } RTC_HandleTypeDef;
+extern void *RTC;
+enum { RTC_HOURFORMAT_24, RTC_OUTPUT_DISABLE, RTC_OUTPUT_POLARITY_HIGH, RTC_OUTPUT_TYPE_OPENDRAIN, RTC_WAKEUPCLOCK_CK_SPRE_16BITS, RTC_WAKEUPCLOCK_RTCCLK_DIV16 };
+HAL_StatusTypeDef HAL_RTC_Init(RTC_HandleTypeDef*);
+HAL_StatusTypeDef HAL_RTCEx_SetWakeUpTimer_IT(RTC_HandleTypeDef*, uint32_t, uint32_t);
+HAL_StatusTypeDef HAL_RTCEx_DeactivateWakeUpTimer(RTC_HandleTypeDef*);
+void HAL_RTCEx_WakeUpTimerIRQHandler(RTC_HandleTypeDef*);
+void HAL_RTCEx_WakeUpTimerEventCallback(RTC_HandleTypeDef*);
+/* ADC */
+typedef struct { uint32_t ClockPrescaler, Resolution, ScanConvMode, ContinuousConvMode, DiscontinuousConvMode, ExternalTrigConvEdge, ExternalTrigConv, DataAlign, NbrOfConversion, DMAContinuousRequests, EOCSelection; } ADC_InitTypeDef;
+typedef struct { void *Instance; ADC_InitTypeDef Init; DMA_HandleTypeDef *DMA_Handle; } ADC_HandleTypeDef;
+typedef struct { uint32_t Channel, Rank, SamplingTime; } ADC_ChannelConfTypeDef;
+extern void *ADC1;
+enum { ADC_CLOCK_SYNC_PCLK_DIV4, ADC_CLOCK_SYNC_PCLK_DIV8, ADC_RESOLUTION_12B, ADC_EXTERNALTRIGCONVEDGE_NONE, ADC_SOFTWARE_START, ADC_DATAALIGN_RIGHT, ADC_EOC_SINGLE_CONV, ADC_CHANNEL_1, ADC_SAMPLETIME_480CYCLES };
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef*);
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef*, ADC_ChannelConfTypeDef*);
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef*, uint32_t*, uint32_t);
+HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef*);
+#define ENABLE 1
+#define DISABLE 0
+/* NVIC / Cortex */
+typedef int IRQn_Type;
+enum { TIM3_IRQn=29, TIM5_IRQn=50, USART1_IRQn=37, EXTI0_IRQn=6, DMA2_Stream0_IRQn=56, DMA2_Stream2_IRQn=58, DMA2_Stream3_IRQn=59, DMA2_Stream5_IRQn=68, PVD_IRQn=1, RTC_WKUP_IRQn=3, FLASH_IRQn=4, OTG_FS_IRQn=67, SysTick_IRQn=-1 };
+void HAL_NVIC_SetPriority(IRQn_Type, uint32_t, uint32_t);
+void HAL_NVIC_EnableIRQ(IRQn_Type);
+void HAL_NVIC_DisableIRQ(IRQn_Type);
+void __disable_irq(void); void __enable_irq(void); void __WFI(void); void __DSB(void); void __ISB(void); void __NOP(void);
+uint32_t __get_PRIMASK(void); void __set_PRIMASK(uint32_t);
+uint32_t __RBIT(uint32_t); uint32_t __CLZ(uint32_t); uint32_t __REV(uint32_t);
+uint8_t __LDREXB(volatile uint8_t*); uint32_t __STREXB(uint8_t, volatile uint8_t*); void __DMB(void);
+typedef struct { volatile uint32_t DEMCR; } CoreDebug_Type; extern CoreDebug_Type *CoreDebug;
+#define CoreDebug_DEMCR_TRCENA_Msk (1u<<24)
+typedef struct { volatile uint32_t CTRL, CYCCNT; } DWT_Type; extern DWT_Type *DWT;
+#define DWT_CTRL_CYCCNTENA_Msk 1u
+typedef struct { volatile uint32_t SCR; } SCB_Type; extern SCB_Type *SCB;
+#define SCB_SCR_SLEEPDEEP_Msk 4u
+#define SCB_SCR_SLEEPONEXIT_Msk 2u
+typedef struct { volatile uint32_t CTRL, LOAD, VAL; } SysTick_Type; extern SysTick_Type *SysTick;
+#define SysTick_CTRL_TICKINT_Msk 2u
+#define SysTick_CTRL_ENABLE_Msk 1u
+typedef struct { volatile uint32_t DR, IDR, CR; } CRC_TypeDef;
+// CRC 유닛: 레지스터 접근마다 직전 쓰기를 반영하는 포트 함수 (hal_shim.c)
+CRC_TypeDef *shim_crc_port(void);
+#define CRC (shim_crc_port())
+#define CRC_CR_RESET 1u
+typedef struct { volatile uint32_t IMR, EMR, RTSR, FTSR, SWIER, PR; } EXTI_TypeDef; extern EXTI_TypeDef *EXTI;
+#define __HAL_GPIO_EXTI_CLEAR_IT(x) do{}while(0)
+#define UNUSED(x) ((void)(x))
+#define __weak __attribute__((weak))
+#define __STATIC_INLINE static inline
+#define assert_param(x) ((void)0)
+#define __HAL_RCC_TIM3_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_TIM4_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_TIM3_CLK_DISABLE() do{}while(0)
+#define __HAL_RCC_TIM4_CLK_DISABLE() do{}while(0)
+#define __HAL_RCC_USART1_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_USART1_CLK_DISABLE() do{}while(0)
+#define __HAL_RCC_TIM5_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_TIM5_CLK_DISABLE() do{}while(0)
+enum { ADC_EXTERNALTRIGCONVEDGE_RISING = 100, ADC_EXTERNALTRIGCONV_T3_TRGO, TIM_TRGO_UPDATE };
+uint32_t __CLZ(uint32_t);
+void HAL_SuspendTick(void);
+void HAL_ResumeTick(void);
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *h);
+#define __HAL_RCC_RTC_DISABLE() do{}while(0)
+typedef struct { uint32_t CR, PLLCFGR, CFGR; } RCC_TypeDef;
+extern RCC_TypeDef *RCC;
+#define RCC_CFGR_PPRE1 0x1C00u
+#define RCC_OSCILLATORTYPE_NONE 0u
+#define TIM_CR1_URS 0x4u
+#define TIM_EGR_UG 0x1u
+#define UART_BRR_SAMPLING16(p,b) ((p)/(b))
+#define MODIFY_REG(r,c,s) ((r) = (((r) & ~(c)) | (s)))
+#define SET_BIT(r,b) ((r) |= (b))
+#define CLEAR_BIT(r,b) ((r) &= ~(b))
+typedef struct { HAL_LockTypeDef Lock; } FLASH_ProcessTypeDef; extern FLASH_ProcessTypeDef pFlash;
+typedef struct { volatile uint32_t SR; } FLASH_TypeDef; extern FLASH_TypeDef *FLASH;
+#define FLASH_SR_BSY (1u<<16)
+typedef struct { volatile uint32_t CR, CSR; } PWR_TypeDef; extern PWR_TypeDef *PWR;
+#define PWR_CSR_PVDO (1u<<2)
+void NVIC_SystemReset(void);
+
+#endif /* SHIM_STM32F4XX_HAL_H_ */
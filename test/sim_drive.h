@@ -0,0 +1,153 @@
+/*
+ * sim_drive.h (호스트 테스트용)
+ *
+ *  합성 주행: 고속도로 직선 / 시내 / 커브 / 정차를 난수로 이어 붙여서 GPS fix를 만듦
+ *  - 속도는 목표로 가속도 제한(±2.5 m/s^2)을 두고 따라감, 커브는 일정 선회율
+ *  - 위치 잡음 ±0.6 m (수신기 흔들림 정도, 솎아내기 허용치보다 충분히 작게)
+ *  - 참값(잡음 없는 위치)도 같이 남김 → 솎아낸 궤적 오차 측정용
+ *  - test_util.h의 test_rand를 씀 (g_test_rng를 정하면 같은 주행)
+ */
+#ifndef SIM_DRIVE_H_
+#define SIM_DRIVE_H_
+
+#include <math.h>
+#include <string.h>
+#include "test_util.h"
+#include "gps_app.h"
+
+#define SIM_M_PER_DEG_LAT  111320.0
+
+typedef enum { SIM_SEG_STRAIGHT = 0, SIM_SEG_CURVE, SIM_SEG_STOP } sim_seg_t;
+
+typedef struct {
+    uint64_t  utc_ms;        // 2000-01-01 기준 ms
+    uint32_t  host_ms;       // HAL_GetTick 축
+    double    lat, lon;      // 참값 [deg]
+    double    alt_m;
+    double    speed_mps;
+    double    heading_deg;
+    double    target_mps;
+    double    turn_dps;      // 커브 선회율 [deg/s]
+    sim_seg_t seg;
+    int32_t   seg_left_ms;
+    double    alt_phase;
+} sim_drive_t;
+
+// 2000-01-01 기준 일수 → 연/월/일 (Howard Hinnant civil_from_days)
+static inline void sim_civil(uint32_t days, uint16_t *y, uint8_t *m, uint8_t *d)
+{
+    int32_t  z   = (int32_t)days + 730425;   // 0000-03-01 기준으로 옮김
+    int32_t  era = z / 146097;
+    uint32_t doe = (uint32_t)(z - era * 146097);
+    uint32_t yoe = (doe - doe / 1460u + doe / 36524u - doe / 146096u) / 365u;
+    uint32_t doy = doe - (365u * yoe + yoe / 4u - yoe / 100u);
+    uint32_t mp  = (5u * doy + 2u) / 153u;
+
+    *d = (uint8_t)(doy - (153u * mp + 2u) / 5u + 1u);
+    *m = (uint8_t)((mp < 10u) ? mp + 3u : mp - 9u);
+    *y = (uint16_t)((int32_t)yoe + era * 400 + ((*m <= 2u) ? 1 : 0));
+}
+
+static inline double sim_uniform(double lo, double hi)
+{
+    return lo + (hi - lo) * test_randf();
+}
+
+static void sim_next_segment(sim_drive_t *s)
+{
+    uint32_t r = test_rand() % 100u;
+
+    s->turn_dps = 0.0;
+    if (r < 35u) {
+        s->seg         = SIM_SEG_STRAIGHT;
+        s->target_mps  = sim_uniform(80.0, 115.0) / 3.6;
+        s->seg_left_ms = (int32_t)sim_uniform(60.0, 400.0) * 1000;
+    } else if (r < 65u) {
+        s->seg         = SIM_SEG_STRAIGHT;
+        s->target_mps  = sim_uniform(25.0, 60.0) / 3.6;
+        s->seg_left_ms = (int32_t)sim_uniform(15.0, 90.0) * 1000;
+    } else if (r < 90u) {
+        s->seg         = SIM_SEG_CURVE;
+        s->turn_dps    = sim_uniform(2.0, 12.0) * ((test_rand() & 1u) ? 1.0 : -1.0);
+        s->target_mps  = fmin(s->speed_mps, sim_uniform(30.0, 70.0) / 3.6);
+        s->seg_left_ms = (int32_t)sim_uniform(5.0, 25.0) * 1000;
+    } else {
+        s->seg         = SIM_SEG_STOP;
+        s->target_mps  = 0.0;
+        s->seg_left_ms = (int32_t)sim_uniform(20.0, 120.0) * 1000;
+    }
+}
+
+static inline void SimDrive_Start(sim_drive_t *s, uint32_t utc_s, uint32_t host_ms, double lat, double lon)
+{
+    memset(s, 0, sizeof(*s));
+    s->utc_ms      = (uint64_t)utc_s * 1000u;
+    s->host_ms     = host_ms;
+    s->lat         = lat;
+    s->lon         = lon;
+    s->alt_m       = 40.0;
+    s->heading_deg = 45.0;
+    sim_next_segment(s);
+}
+
+// dt_ms 만큼 움직임 (정차 구간은 멈춘 뒤 남은 시간만큼 서 있음)
+static inline void SimDrive_Step(sim_drive_t *s, uint32_t dt_ms)
+{
+    double dt = dt_ms / 1000.0;
+    double dv = s->target_mps - s->speed_mps;
+
+    dv = fmax(-2.5 * dt, fmin(2.5 * dt, dv));
+    s->speed_mps += dv;
+    if (s->speed_mps < 0.05 && s->target_mps == 0.0) {
+        s->speed_mps = 0.0;
+    }
+    s->heading_deg = fmod(s->heading_deg + s->turn_dps * dt + 360.0, 360.0);
+
+    double d = s->speed_mps * dt;
+    double h = s->heading_deg * M_PI / 180.0;
+    s->lat += d * cos(h) / SIM_M_PER_DEG_LAT;
+    s->lon += d * sin(h) / (SIM_M_PER_DEG_LAT * cos(s->lat * M_PI / 180.0));
+    s->alt_phase += d / 3000.0;
+    s->alt_m = 40.0 + 25.0 * sin(s->alt_phase);
+
+    s->utc_ms  += dt_ms;
+    s->host_ms += dt_ms;
+    s->seg_left_ms -= (int32_t)dt_ms;
+    // 정차는 완전히 선 다음부터 시간을 셈
+    if (s->seg == SIM_SEG_STOP && s->speed_mps > 0.0) {
+        s->seg_left_ms += (int32_t)dt_ms;
+    }
+    if (s->seg_left_ms <= 0) {
+        sim_next_segment(s);
+    }
+}
+
+// 지금 상태를 수신기가 낸 fix로 (위치에 잡음)
+static inline void SimDrive_Fix(const sim_drive_t *s, app_gps_state_t *g)
+{
+    uint32_t utc_s = (uint32_t)(s->utc_ms / 1000u);
+    double   n_m   = sim_uniform(-0.6, 0.6), e_m = sim_uniform(-0.6, 0.6);
+
+    memset(g, 0, sizeof(*g));
+    g->valid = true;
+    sim_civil(utc_s / 86400u, &g->year, &g->month, &g->day);
+    g->hour  = (uint8_t)((utc_s / 3600u) % 24u);
+    g->min   = (uint8_t)((utc_s / 60u) % 60u);
+    g->sec   = (uint8_t)(utc_s % 60u);
+
+    g->lat_deg     = s->lat + n_m / SIM_M_PER_DEG_LAT;
+    g->lon_deg     = s->lon + e_m / (SIM_M_PER_DEG_LAT * cos(s->lat * M_PI / 180.0));
+    g->hmsl_m      = (float)s->alt_m;
+    g->height_m    = (float)s->alt_m + 25.0f;
+    g->fixType     = 3u;
+    g->fixOk       = true;
+    g->numSV_used  = 9u;
+    g->speed_mps   = (float)s->speed_mps;
+    g->speed_kmh   = (float)(s->speed_mps * 3.6);
+    g->heading_deg = (float)s->heading_deg;
+    g->heading_valid = (g->speed_kmh >= 2.0f);
+    g->host_time_ms  = s->host_ms;
+    g->tow_ms        = (uint32_t)(s->utc_ms % (7u * 86400000u));
+}
+
+#endif /* SIM_DRIVE_H_ */
@@ -0,0 +1,224 @@
+// test_ambient_light.c
+//  주변광 필터 리플레이: ADC DMA 버퍼에 100 ms마다 샘플 1개씩 (TIM3 TRGO와 같은 속도) 써 넣고
+//  AmbientLight_Process 출력이 출렁이지 않는지, 밝기 변화는 제때 따라가는지 확인
+//  (AMBIENT_LIGHT_FITTED=1 로 빌드)
+#include <math.h>
+#include "test_util.h"
+#include "hal_shim.h"
+#include "ambient_light.h"
+
+#define STEP_MS   100u
+
+typedef struct {
+    uint32_t changes;       // Process가 true를 돌려준 횟수
+    uint32_t reversals;     // 출력 방향이 바뀐 횟수 (올라가다 내려감 / 그 반대)
+    int32_t  last_dir;
+    uint16_t last_out;
+} replay_t;
+
+static uint16_t *s_buf;
+static uint32_t  s_len;
+static uint32_t  s_idx;
+static uint32_t  s_now;
+
+static void replay_reset(replay_t *r)
+{
+    r->changes   = 0u;
+    r->reversals = 0u;
+    r->last_dir  = 0;
+    r->last_out  = AmbientLight_GetLog2Q8();
+}
+
+// 샘플 하나 (DMA 순환 버퍼에 한 칸) 넣고 Process
+static void feed(replay_t *r, double raw)
+{
+    if (raw < 0.0) {
+        raw = 0.0;
+    }
+    if (raw > 4095.0) {
+        raw = 4095.0;
+    }
+    s_buf[s_idx] = (uint16_t)raw;
+    s_idx = (s_idx + 1u) % s_len;
+    s_now += STEP_MS;
+
+    if (AmbientLight_Process(s_now)) {
+        r->changes++;
+        uint16_t out = AmbientLight_GetLog2Q8();
+        if (AmbientLight_IsValid() && out != r->last_out) {
+            int32_t dir = (out > r->last_out) ? 1 : -1;
+            if (r->last_dir != 0 && dir != r->last_dir) {
+                r->reversals++;
+            }
+            r->last_dir = dir;
+            r->last_out = out;
+        }
+    }
+}
+
+// 평균 raw, 곱셈 잡음 ±noise (균등)
+static double noisy(double mean, double noise)
+{
+    return mean * (1.0 + noise * (2.0 * test_randf() - 1.0));
+}
+
+static double out_log2(void)
+{
+    return (double)AmbientLight_GetLog2Q8() / 256.0;
+}
+
+static void start(void)
+{
+    Shim_Reset();
+    AmbientLight_Init();
+    s_buf = Shim_AdcDmaBuf(&s_len);
+    s_idx = 0u;
+    s_now = 1000u;
+}
+
+// ----------------- 시나리오 -----------------
+// 흐린 낮, 잡음 ±20%: 1초 안에 valid, 그 뒤 1분 동안 출력 고정
+static void test_steady_noise(void)
+{
+    replay_t r;
+
+    start();
+    CHECK(s_buf != NULL && s_len == 8u, "ADC DMA not started");
+    replay_reset(&r);
+
+    for (uint32_t i = 0u; i < 20u; ++i) {
+        feed(&r, noisy(1200.0, 0.2));
+    }
+    CHECK(AmbientLight_IsValid(), "not valid after 2 s of sane data");
+
+    replay_reset(&r);
+    for (uint32_t i = 0u; i < 600u; ++i) {
+        feed(&r, noisy(1200.0, 0.2));
+    }
+    CHECK(r.changes == 0u, "steady noisy light: %u output changes", r.changes);
+    CHECK(fabs(out_log2() - log2(1200.0)) < 0.4, "steady level %.2f vs %.2f", out_log2(), log2(1200.0));
+}
+
+// 터널 진입 (약 3옥타브 아래로 계단): 한 방향으로만 움직이고 3초 안에 따라감, 나올 때도 같음
+//  - "따라감" = 0.4 옥타브 안 (히스테리시스 0.25 + log2 근사 오차 0.09 + 잡음)
+static void test_tunnel_step(void)
+{
+    replay_t r;
+
+    start();
+    replay_reset(&r);
+    for (uint32_t i = 0u; i < 50u; ++i) {
+        feed(&r, noisy(2400.0, 0.1));
+    }
+
+    replay_reset(&r);
+    uint32_t settle = 0u;
+    for (uint32_t i = 1u; i <= 200u; ++i) {
+        feed(&r, noisy(300.0, 0.1));
+        if (settle == 0u && fabs(out_log2() - log2(300.0)) < 0.4) {
+            settle = i * STEP_MS;
+        }
+    }
+    printf("  tunnel in : %u ms to within 0.4 oct, %u updates\n", settle, r.changes);
+    CHECK(settle != 0u && settle <= 3000u, "tunnel entry settle %u ms", settle);
+    CHECK(r.reversals == 0u, "tunnel entry: %u direction reversals", r.reversals);
+
+    replay_reset(&r);
+    settle = 0u;
+    for (uint32_t i = 1u; i <= 200u; ++i) {
+        feed(&r, noisy(2400.0, 0.1));
+        if (settle == 0u && fabs(out_log2() - log2(2400.0)) < 0.4) {
+            settle = i * STEP_MS;
+        }
+    }
+    printf("  tunnel out: %u ms to within 0.4 oct, %u updates\n", settle, r.changes);
+    CHECK(settle != 0u && settle <= 3000u, "tunnel exit settle %u ms", settle);
+    CHECK(r.reversals == 0u, "tunnel exit: %u direction reversals", r.reversals);
+}
+
+// 밤길 가로등: 어두운 바탕에 2초마다 200 ms짜리 밝은 펄스
+//  → 평균이 올라간 한 단계로는 갈 수 있어도 펄스마다 오르내리면 안 됨
+static void test_streetlights(void)
+{
+    replay_t r;
+
+    start();
+    replay_reset(&r);
+    for (uint32_t i = 0u; i < 50u; ++i) {
+        feed(&r, noisy(60.0, 0.1));
+    }
+
+    replay_reset(&r);
+    for (uint32_t i = 0u; i < 1200u; ++i) {
+        bool lamp = (i % 20u) < 2u;
+        feed(&r, noisy(lamp ? 900.0 : 60.0, 0.1));
+    }
+    printf("  streetlights: %u updates, %u reversals in 120 s\n", r.changes, r.reversals);
+    CHECK(r.reversals == 0u, "streetlights: %u direction reversals", r.reversals);
+    CHECK(r.changes <= 3u, "streetlights: %u output updates", r.changes);
+}
+
+// 센서 단선 (0에 붙음): 3초 넘게 지나야 invalid, 다시 정상 1초면 valid
+static void test_rail_fault(void)
+{
+    replay_t r;
+
+    start();
+    replay_reset(&r);
+    for (uint32_t i = 0u; i < 30u; ++i) {
+        feed(&r, noisy(1000.0, 0.1));
+    }
+    CHECK(AmbientLight_IsValid(), "valid before fault");
+
+    // 버퍼 평균이 레일에 붙을 때까지 0.8초 + 3초
+    uint32_t invalid_at = 0u;
+    for (uint32_t i = 1u; i <= 60u; ++i) {
+        feed(&r, 0.0);
+        if (invalid_at == 0u && !AmbientLight_IsValid()) {
+            invalid_at = i * STEP_MS;
+        }
+    }
+    CHECK(invalid_at >= 3000u && invalid_at <= 4500u, "invalid after %u ms at rail", invalid_at);
+
+    uint32_t valid_at = 0u;
+    for (uint32_t i = 1u; i <= 40u; ++i) {
+        feed(&r, noisy(1000.0, 0.1));
+        if (valid_at == 0u && AmbientLight_IsValid()) {
+            valid_at = i * STEP_MS;
+        }
+    }
+    CHECK(valid_at != 0u && valid_at <= 2000u, "valid again after %u ms", valid_at);
+    CHECK(fabs(out_log2() - log2(1000.0)) < 0.4, "level after recovery %.2f", out_log2());
+}
+
+// Process는 100 ms보다 자주 불러도 100 ms마다 한 번만 처리
+static void test_rate_limit(void)
+{
+    replay_t r;
+
+    start();
+    replay_reset(&r);
+    for (uint32_t i = 0u; i < 30u; ++i) {
+        feed(&r, 1000.0);
+    }
+    uint16_t out = AmbientLight_GetLog2Q8();
+
+    for (uint32_t i = 0u; i < s_len; ++i) {
+        s_buf[i] = 50u;
+    }
+    for (uint32_t t = 1u; t < STEP_MS; ++t) {
+        AmbientLight_Process(s_now + t);
+    }
+    CHECK(AmbientLight_GetLog2Q8() == out, "processed before 100 ms elapsed");
+}
+
+int main(void)
+{
+    test_steady_noise();
+    test_tunnel_step();
+    test_streetlights();
+    test_rail_fault();
+    test_rate_limit();
+
+    return test_done("ambient_light");
+}
@@ -0,0 +1,153 @@
+// test_crc32.c
+//  crc32.c 교차 검증 + 호스트 벤치마크
+//  - 기준: 예전 settings_storage.c 의 비트 단위 CRC32 (플래시에 이미 있는 레코드가 이 값)
+//  - 하드웨어 경로 (CRC32_USE_HW=1, 링크된 crc32.c): CRC 유닛은 shim이 MSB-first로 흉내
+//  - 소프트웨어 경로 (CRC32_USE_HW=0): 같은 crc32.c를 이름만 바꿔서 여기 포함
+//  - __RBIT 변환 자체도 펌웨어와 따로 계산해 봄 (워드 RBIT → MPEG-2 → 결과 RBIT == 반사 CRC)
+//  - 벤치마크는 비트 단위 vs slice-by-4 만 (호스트의 하드웨어 경로는 흉내라서 의미 없음)
+#include <string.h>
+#include "test_util.h"
+#include "hal_shim.h"
+
+#define CRC32_USE_HW  0
+#define Crc32_Calc    sw_Crc32_Calc
+#define Crc32_Update  sw_Crc32_Update
+#include "crc32.c"
+#undef Crc32_Calc
+#undef Crc32_Update
+
+// 링크된 crc32.c (하드웨어 경로)
+uint32_t Crc32_Calc(const void *data, size_t len);
+uint32_t Crc32_Update(uint32_t crc, const void *data, size_t len);
+
+// ----------------- 기준 -----------------
+// 예전 settings_storage.c crc32_calc 그대로
+static uint32_t legacy_crc32(const uint8_t *data, size_t len)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= (uint32_t)data[i];
+        for (uint32_t bit = 0; bit < 8u; ++bit) {
+            uint32_t mask = (uint32_t)-(int32_t)(crc & 1u);
+            crc = (crc >> 1) ^ (0xEDB88320u & mask);
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t rbit32(uint32_t v)
+{
+    uint32_t r = 0u;
+    for (unsigned i = 0u; i < 32u; ++i) {
+        r = (r << 1) | ((v >> i) & 1u);
+    }
+    return r;
+}
+
+// CRC 유닛 규칙 (0x04C11DB7, 초기 0xFFFFFFFF, 워드 MSB부터)을 펌웨어와 같은 방식으로 감싼 것
+static uint32_t model_hw_crc32(const uint8_t *p, size_t len)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+    size_t   words = len / 4u;
+
+    for (size_t i = 0u; i < words; ++i) {
+        uint32_t w = (uint32_t)p[4u * i] | ((uint32_t)p[4u * i + 1u] << 8) |
+                     ((uint32_t)p[4u * i + 2u] << 16) | ((uint32_t)p[4u * i + 3u] << 24);
+        crc ^= rbit32(w);
+        for (unsigned b = 0u; b < 32u; ++b) {
+            crc = (crc & 0x80000000u) ? ((crc << 1) ^ 0x04C11DB7u) : (crc << 1);
+        }
+    }
+    crc = rbit32(crc);
+    // 꼬리 바이트는 반사 CRC로 이어서
+    for (size_t i = words * 4u; i < len; ++i) {
+        crc ^= p[i];
+        for (unsigned b = 0u; b < 8u; ++b) {
+            crc = (crc & 1u) ? ((crc >> 1) ^ 0xEDB88320u) : (crc >> 1);
+        }
+    }
+    return ~crc;
+}
+
+// ----------------- 검사 -----------------
+static uint8_t s_buf[4096 + 8];
+
+static void test_check_value(void)
+{
+    static const char s[] = "123456789";
+
+    CHECK(legacy_crc32((const uint8_t *)s, 9u) == 0xCBF43926u, "legacy check value");
+    CHECK(Crc32_Calc(s, 9u) == 0xCBF43926u, "hw check value %08X", Crc32_Calc(s, 9u));
+    CHECK(sw_Crc32_Calc(s, 9u) == 0xCBF43926u, "sw check value %08X", sw_Crc32_Calc(s, 9u));
+    CHECK(model_hw_crc32((const uint8_t *)s, 9u) == 0xCBF43926u, "RBIT model check value");
+    CHECK(Crc32_Calc(s, 0u) == 0u && sw_Crc32_Calc(s, 0u) == 0u, "empty buffer");
+}
+
+static void test_random(void)
+{
+    uint32_t bad = 0u;
+
+    for (uint32_t k = 0u; k < 20000u; ++k) {
+        size_t len = (k < 64u) ? k : (test_rand() % 300u);
+        size_t off = test_rand() % 4u;   // 정렬 안 된 시작 주소
+        uint8_t *p = s_buf + off;
+
+        for (size_t i = 0u; i < len; ++i) {
+            p[i] = (uint8_t)test_rand();
+        }
+        // 0/FF 로 채운 구간 (플래시 빈칸, 0 패딩)
+        if ((k % 7u) == 0u && len > 8u) {
+            memset(p + len / 2u, (k & 8u) ? 0xFF : 0x00, len / 4u);
+        }
+
+        uint32_t want  = legacy_crc32(p, len);
+        size_t   split = (len != 0u) ? (test_rand() % (len + 1u)) : 0u;
+        uint32_t upd   = Crc32_Update(Crc32_Update(0u, p, split), p + split, len - split);
+
+        if (Crc32_Calc(p, len) != want || sw_Crc32_Calc(p, len) != want ||
+            model_hw_crc32(p, len) != want || upd != want) {
+            if (bad++ < 5u) {
+                CHECK(false, "len %zu off %zu: legacy %08X hw %08X sw %08X model %08X update %08X", len, off,
+                      want, Crc32_Calc(p, len), sw_Crc32_Calc(p, len), model_hw_crc32(p, len), upd);
+            }
+        }
+    }
+    CHECK(bad == 0u, "%u of 20000 random buffers differ", bad);
+}
+
+// ----------------- 벤치마크 -----------------
+static volatile uint32_t s_sink;
+
+static void bench(const char *name, uint32_t (*fn)(const uint8_t *, size_t), size_t len, uint32_t reps)
+{
+    uint64_t t0 = test_now_ns();
+    for (uint32_t i = 0u; i < reps; ++i) {
+        s_buf[0] = (uint8_t)i;
+        s_sink ^= fn(s_buf, len);
+    }
+    uint64_t t1 = test_now_ns();
+    double ns_per_byte = (double)(t1 - t0) / ((double)reps * len);
+
+    printf("  %-12s %5zu B  %6.2f ns/B  %8.1f MB/s\n", name, len, ns_per_byte, 1000.0 / ns_per_byte);
+}
+
+static uint32_t bench_legacy(const uint8_t *p, size_t n) { return legacy_crc32(p, n); }
+static uint32_t bench_sw(const uint8_t *p, size_t n)     { return sw_Crc32_Calc(p, n); }
+
+int main(void)
+{
+    Shim_Reset();
+    test_check_value();
+    test_random();
+
+    for (size_t i = 0u; i < sizeof(s_buf); ++i) {
+        s_buf[i] = (uint8_t)test_rand();
+    }
+    printf("CRC32 host throughput (bitwise legacy vs slice-by-4):\n");
+    bench("bitwise", bench_legacy, 16u, 200000u);
+    bench("slice-by-4", bench_sw, 16u, 200000u);
+    bench("bitwise", bench_legacy, 4096u, 2000u);
+    bench("slice-by-4", bench_sw, 4096u, 2000u);
+
+    return test_done("crc32");
+}
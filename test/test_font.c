@@ -0,0 +1,187 @@
+// test_font.c
+//  MAX7219_FONT_ASCII 검사 + 세그먼트 ASCII 아트 렌더러
+//
+//   build/test_font            검사만
+//   build/test_font -a         0x20~0x7E 전부 그려 보기
+//   build/test_font "GO! 12.5" 문자열 하나 그려 보기 ('.'는 앞 글자 DP)
+#include <ctype.h>
+#include <string.h>
+#include "test_util.h"
+#include "hal_shim.h"
+#include "main.h"
+#include "max7219.h"
+
+// 세그먼트 비트 (no-decode 모드): DP a b c d e f g = D7..D0
+#define SEG_A  0x40u
+#define SEG_B  0x20u
+#define SEG_C  0x10u
+#define SEG_D  0x08u
+#define SEG_E  0x04u
+#define SEG_F  0x02u
+#define SEG_G  0x01u
+
+// 예전 SYMBOLS 표 (MAX7219_Numeric 순서) — 레거시 PrintDigit 모양이 바뀌면 안 됨
+static const uint8_t s_legacy_symbols[] = {
+    0x7E, 0x30, 0x6D, 0x79, 0x33, 0x5B, 0x5F, 0x70, 0x7F, 0x7B,   // 0~9
+    0x01, 0x4F, 0x37, 0x0E, 0x67, 0x00,                           // - E H L P blank
+    0x5B, 0x77, 0x0F, 0x7B, 0x05, 0x3D, 0x3C, 0x63                // S A T G R d u ^
+};
+
+// ----------------- 렌더러 -----------------
+// 글자 하나 = 가로 4칸 x 세로 3줄
+//   _
+//  |_|
+//  |_|.
+static void render(const uint8_t *seg, size_t n)
+{
+    char line[3][4u * 32u + 1u];
+    size_t k = 0u;
+
+    if (n > 32u) {
+        n = 32u;
+    }
+    for (size_t i = 0u; i < n; ++i, k += 4u) {
+        uint8_t s = seg[i];
+        memcpy(&line[0][k], (s & SEG_A) ? " _  " : "    ", 4u);
+        line[1][k + 0u] = (s & SEG_F) ? '|' : ' ';
+        line[1][k + 1u] = (s & SEG_G) ? '_' : ' ';
+        line[1][k + 2u] = (s & SEG_B) ? '|' : ' ';
+        line[1][k + 3u] = ' ';
+        line[2][k + 0u] = (s & SEG_E) ? '|' : ' ';
+        line[2][k + 1u] = (s & SEG_D) ? '_' : ' ';
+        line[2][k + 2u] = (s & SEG_C) ? '|' : ' ';
+        line[2][k + 3u] = (s & MAX7219_SEG_DP) ? '.' : ' ';
+    }
+    for (unsigned r = 0u; r < 3u; ++r) {
+        line[r][k] = '\0';
+        printf("%s\n", line[r]);
+    }
+}
+
+// 문자열 → 세그먼트 ('.'는 앞 글자 DP로 접음, 펌웨어 WriteString과 같은 규칙)
+static size_t text_to_seg(const char *s, uint8_t *seg, size_t max)
+{
+    size_t n = 0u;
+
+    for (; *s != '\0'; ++s) {
+        if ((*s == '.') && (n > 0u) && !(seg[n - 1u] & MAX7219_SEG_DP)) {
+            seg[n - 1u] |= MAX7219_SEG_DP;
+            continue;
+        }
+        if (n < max) {
+            seg[n++] = max7219_SegFromChar(*s);
+        }
+    }
+    return n;
+}
+
+static void render_all(void)
+{
+    uint8_t seg[16];
+
+    for (unsigned c0 = 0x20u; c0 < 0x7Fu; c0 += 16u) {
+        for (unsigned c = c0; (c < c0 + 16u) && (c < 0x7Fu); ++c) {
+            printf(" %c  ", (char)c);
+            seg[c - c0] = MAX7219_FONT_ASCII[c];
+        }
+        printf("\n");
+        render(seg, (c0 + 16u <= 0x7Fu) ? 16u : (0x7Fu - c0));
+        printf("\n");
+    }
+}
+
+// ----------------- 검사 -----------------
+static void test_table(void)
+{
+    for (unsigned c = 0u; c < 128u; ++c) {
+        uint8_t g = MAX7219_FONT_ASCII[c];
+
+        // DP는 '.', '!', '?' 같은 문장부호만 (글자/숫자에 붙으면 다음 글자 DP와 헷갈림)
+        if (isalnum((int)c)) {
+            CHECK((g & MAX7219_SEG_DP) == 0u, "'%c' glyph has DP set", (char)c);
+        }
+        CHECK(max7219_SegFromChar((char)c) == g, "SegFromChar(0x%02X) differs from table", c);
+
+        if (c == ' ' || c < 0x20u || c == 0x7Fu) {
+            CHECK(g == 0x00u, "0x%02X should be blank, got %02X", c, g);
+        } else {
+            CHECK(g != 0x00u, "printable '%c' renders blank", (char)c);
+        }
+    }
+
+    // "GO!" (0-100 카운트다운)
+    CHECK(max7219_SegFromChar('!') != 0x00u, "'!' blank");
+
+    // 숫자는 예전 모양 그대로
+    for (unsigned d = 0u; d < 10u; ++d) {
+        CHECK(MAX7219_FONT_ASCII['0' + d] == s_legacy_symbols[d], "digit %u %02X", d, MAX7219_FONT_ASCII['0' + d]);
+    }
+
+    // 대소문자 공유
+    for (unsigned c = 'a'; c <= 'z'; ++c) {
+        CHECK(MAX7219_FONT_ASCII[c] == MAX7219_FONT_ASCII[c - 0x20u], "'%c' != '%c'", (char)c, (char)(c - 0x20u));
+    }
+
+    // 각도 기호 (Latin-1 0xB0)
+    CHECK(max7219_SegFromChar((char)0xB0) == MAX7219_FONT_ASCII['^'], "degree glyph");
+    CHECK(max7219_SegFromChar((char)0xC0) == 0x00u, "non-ASCII should be blank");
+}
+
+// 레거시 max7219_PrintDigit: SPI로 나가는 바이트가 예전 SYMBOLS 표와 같아야 함
+static void test_legacy_print_digit(void)
+{
+    uint8_t tx[2];
+
+    max7219_Decode_Off();
+    for (unsigned i = 0u; i < sizeof(s_legacy_symbols); ++i) {
+        for (unsigned dp = 0u; dp < 2u; ++dp) {
+            max7219_PrintDigit(DIGIT_3, (MAX7219_Numeric)i, dp != 0u);
+            uint16_t n = Shim_SpiLastTx(tx, sizeof(tx));
+            uint8_t  want = (uint8_t)(s_legacy_symbols[i] | (dp ? MAX7219_SEG_DP : 0u));
+
+            CHECK(n == 2u && tx[0] == DIGIT_3 && tx[1] == want,
+                  "PrintDigit(%u, dp=%u) sent %02X %02X, want %02X", i, dp, tx[0], tx[1], want);
+        }
+    }
+}
+
+// last gasp: 블로킹 HAL_SPI_Transmit이 끊긴 채(hspi 락 잡힘)로 들어와도 shutdown이 나가야 함
+static void test_shutdown_preempted(void)
+{
+    uint8_t tx[2];
+    uint16_t n0 = Shim_SpiLastTx(tx, sizeof(tx));
+
+    SPI_PORT.Lock = HAL_LOCKED;
+    SPI1->DR   = 0xAAu;
+    SPI1->CR1 &= ~SPI_CR1_SPE;
+    SPI1->CR2 |= SPI_CR2_TXDMAEN;
+    HAL_GPIO_WritePin(CS_MAX7219_GPIO_Port, CS_MAX7219_Pin, GPIO_PIN_RESET);
+
+    max7219_ShutdownFromISR();
+
+    CHECK((uint8_t)SPI1->DR == 0x00u, "shutdown data not written to DR (last %02X)", (uint8_t)SPI1->DR);
+    CHECK((SPI1->CR1 & SPI_CR1_SPE) != 0u && (SPI1->CR2 & SPI_CR2_TXDMAEN) == 0u, "SPI not taken over");
+    CHECK((CS_MAX7219_GPIO_Port->ODR & CS_MAX7219_Pin) != 0u, "CS not released (no latch)");
+    CHECK(Shim_SpiLastTx(tx, sizeof(tx)) == n0, "went through the locked HAL handle");
+    SPI_PORT.Lock = HAL_UNLOCKED;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1) {
+        if (strcmp(argv[1], "-a") == 0) {
+            render_all();
+        } else {
+            uint8_t seg[32];
+            render(seg, text_to_seg(argv[1], seg, sizeof(seg)));
+        }
+        return 0;
+    }
+
+    Shim_Reset();
+    test_table();
+    test_legacy_print_digit();
+    test_shutdown_preempted();
+
+    return test_done("font");
+}
@@ -0,0 +1,283 @@
+// test_key_input.c
+//  버튼 바운스 트레이스 리플레이
+//  - 핀(PA0 IDR bit0)을 ms 단위로 움직이고 레벨이 바뀔 때마다 EXTI ISR(Key_OnEdgeISR) 호출
+//  - 메인 루프는 10 ms마다 Key_Process (blocked 구간에서는 안 부름)
+//  - 나온 제스처와 시각을 기대값과 비교
+#include <string.h>
+#include "test_util.h"
+#include "hal_shim.h"
+#include "key_input.h"
+#include "sched.h"
+
+#define MAX_EV  32u
+
+typedef struct {
+    key_event_t ev;
+    uint32_t    t;
+} ev_rec_t;
+
+static ev_rec_t s_log[MAX_EV];
+static uint32_t s_nlog;
+static uint8_t  s_pin = 1u;      // 1 = 뗌 (풀업)
+static bool     s_poll = true;   // false = 메인 루프가 막혀 있는 구간
+
+static const char *ev_name(key_event_t e)
+{
+    static const char *const names[] = { "-", "SHORT", "LONG", "DOUBLE", "REPEAT" };
+    return names[e];
+}
+
+static void pin_set(uint8_t level)
+{
+    if (level == s_pin) {
+        return;
+    }
+    s_pin = level;
+    if (level) {
+        GPIOA->IDR |= GPIO_PIN_0;
+    } else {
+        GPIOA->IDR &= ~(uint32_t)GPIO_PIN_0;
+    }
+    Key_OnEdgeISR();
+}
+
+static void run(uint32_t ms)
+{
+    for (uint32_t i = 0u; i < ms; ++i) {
+        Shim_Advance(1u);
+        if (s_poll && (HAL_GetTick() % 10u) == 0u) {
+            Key_Process(HAL_GetTick());
+            key_event_t e;
+            while ((e = Key_GetEvent()) != KEY_EVENT_NONE) {
+                if (s_nlog < MAX_EV) {
+                    s_log[s_nlog].ev = e;
+                    s_log[s_nlog].t  = HAL_GetTick();
+                    s_nlog++;
+                }
+            }
+        }
+    }
+}
+
+// 접점 바운스: 목표 레벨로 가기 전에 n번 튐 (각 0~2 ms)
+static void bounce_to(uint8_t level, uint32_t n)
+{
+    for (uint32_t i = 0u; i < n; ++i) {
+        pin_set(level);
+        run(test_rand() % 3u);
+        pin_set((uint8_t)!level);
+        run(1u + test_rand() % 2u);
+    }
+    pin_set(level);
+}
+
+static void press(uint32_t hold_ms)
+{
+    bounce_to(0u, 4u);
+    run(hold_ms);
+    bounce_to(1u, 4u);
+}
+
+static void start(void)
+{
+    Shim_Reset();
+    Shim_SetTick(1000u);
+    s_pin  = 1u;
+    s_poll = true;
+    s_nlog = 0u;
+    Key_SetDoubleTapEnabled(true);
+    Key_Init();
+}
+
+// 기대 제스처 열과 비교 ("SHORT DOUBLE" 식으로 출력)
+static void expect(const char *what, const key_event_t *want, uint32_t n)
+{
+    bool same = (n == s_nlog);
+    for (uint32_t i = 0u; same && i < n; ++i) {
+        same = (s_log[i].ev == want[i]);
+    }
+    if (!same) {
+        char got[160] = "";
+        for (uint32_t i = 0u; i < s_nlog; ++i) {
+            snprintf(got + strlen(got), sizeof(got) - strlen(got), " %s@%u", ev_name(s_log[i].ev), s_log[i].t);
+        }
+        CHECK(false, "%s: got%s", what, got);
+    }
+}
+
+#define EXPECT(what, ...)                                                   \
+    do {                                                                    \
+        static const key_event_t w_[] = { __VA_ARGS__ };                    \
+        expect(what, w_, sizeof(w_) / sizeof(w_[0]));                       \
+    } while (0)
+
+// ----------------- 시나리오 -----------------
+static void test_short(void)
+{
+    start();
+    uint32_t t_release;
+    press(150u);
+    t_release = HAL_GetTick();
+    run(600u);
+    EXPECT("short", KEY_EVENT_SHORT);
+    // 두 번째 탭을 기다리는 시간 뒤에 바로
+    CHECK(s_nlog == 1u && s_log[0].t - t_release <= KEY_DOUBLE_GAP_MS + KEY_DEBOUNCE_MS + 20u,
+          "short latency %u ms", s_nlog ? s_log[0].t - t_release : 0u);
+}
+
+static void test_double(void)
+{
+    start();
+    press(100u);
+    run(150u);
+    press(100u);
+    run(600u);
+    EXPECT("double", KEY_EVENT_DOUBLE);
+}
+
+static void test_long_repeat(void)
+{
+    start();
+    uint32_t t0 = HAL_GetTick();
+    press(1600u);
+    run(600u);
+    EXPECT("long+repeat", KEY_EVENT_LONG, KEY_EVENT_REPEAT, KEY_EVENT_REPEAT);
+    if (s_nlog >= 2u) {
+        uint32_t t_long = s_log[0].t - t0;
+        CHECK(t_long >= KEY_LONGPRESS_MS && t_long <= KEY_LONGPRESS_MS + 20u, "LONG after %u ms", t_long);
+        CHECK(s_log[1].t - s_log[0].t >= KEY_REPEAT_DELAY_MS, "first REPEAT too early");
+    }
+}
+
+// 메인 루프가 막혀 있는 동안 눌렀다 뗌: 엣지 시각으로 판정
+static void test_blocked(void)
+{
+    start();
+    s_poll = false;
+    press(150u);
+    run(100u);
+    s_poll = true;
+    run(600u);
+    EXPECT("blocked short", KEY_EVENT_SHORT);
+
+    start();
+    s_poll = false;
+    press(1200u);
+    run(100u);
+    s_poll = true;
+    run(600u);
+    EXPECT("blocked long", KEY_EVENT_LONG);
+}
+
+static void test_tap_then_long(void)
+{
+    start();
+    press(100u);
+    run(150u);
+    press(1000u);
+    run(600u);
+    EXPECT("tap+long", KEY_EVENT_SHORT, KEY_EVENT_LONG);
+}
+
+static void test_glitch(void)
+{
+    start();
+    pin_set(0u);
+    run(10u);
+    pin_set(1u);
+    run(600u);
+    EXPECT("10 ms glitch");
+
+    // 바운스만 잔뜩 (접점이 닿다 말았음)
+    start();
+    bounce_to(1u, 12u);
+    run(600u);
+    EXPECT("bounce only");
+}
+
+static void test_slow_taps(void)
+{
+    start();
+    press(100u);
+    run(500u);
+    press(100u);
+    run(600u);
+    EXPECT("two slow taps", KEY_EVENT_SHORT, KEY_EVENT_SHORT);
+}
+
+// 설정 메뉴: DOUBLE 끔 → SHORT가 뗀 직후 바로
+static void test_no_double(void)
+{
+    start();
+    Key_SetDoubleTapEnabled(false);
+    uint32_t t_release;
+    press(100u);
+    t_release = HAL_GetTick();
+    run(150u);
+    press(100u);
+    run(600u);
+    EXPECT("double disabled", KEY_EVENT_SHORT, KEY_EVENT_SHORT);
+    CHECK(s_nlog >= 1u && s_log[0].t - t_release <= KEY_DEBOUNCE_MS + 20u,
+          "immediate SHORT latency %u ms", s_nlog ? s_log[0].t - t_release : 0u);
+}
+
+// 엣지 큐(16) 넘침: 처리 안 되는 동안 바운스 40번 → 핀 레벨로 다시 맞춰서 눌림은 살아 있음
+static void test_queue_overflow(void)
+{
+    start();
+    s_poll = false;
+    bounce_to(0u, 40u);
+    s_poll = true;
+    run(150u);
+    bounce_to(1u, 2u);
+    run(600u);
+    EXPECT("edge queue overflow", KEY_EVENT_SHORT);
+}
+
+// 무작위 트레이스: 바운스 개수/간격, 누름 길이, 폴링 지연을 섞어서 분류만 확인
+static void test_random(void)
+{
+    uint32_t wrong = 0u;
+
+    for (uint32_t k = 0u; k < 2000u; ++k) {
+        start();
+        uint32_t hold = 60u + test_rand() % 1400u;
+        if (hold >= 700u && hold <= 900u) {
+            continue;   // LONG 경계 근처는 판정이 엣지 시각에 달려 있어서 제외
+        }
+        s_poll = (test_rand() % 4u) != 0u;
+        bounce_to(0u, 1u + test_rand() % 8u);
+        run(hold);
+        bounce_to(1u, 1u + test_rand() % 8u);
+        run(50u);
+        s_poll = true;
+        run(600u);
+
+        key_event_t want = (hold < 700u) ? KEY_EVENT_SHORT : KEY_EVENT_LONG;
+        if (s_nlog == 0u || s_log[0].ev != want) {
+            wrong++;
+        }
+        for (uint32_t i = 1u; i < s_nlog; ++i) {
+            if (s_log[i].ev != KEY_EVENT_REPEAT) {
+                wrong++;
+            }
+        }
+    }
+    CHECK(wrong == 0u, "random traces: %u misclassified", wrong);
+}
+
+int main(void)
+{
+    test_short();
+    test_double();
+    test_long_repeat();
+    test_blocked();
+    test_tap_then_long();
+    test_glitch();
+    test_slow_taps();
+    test_no_double();
+    test_queue_overflow();
+    test_random();
+
+    return test_done("key_input");
+}
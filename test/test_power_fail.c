@@ -0,0 +1,108 @@
+// test_power_fail.c
+//  PVD last gasp (power_fail.c) 를 그대로 포함해서 ISR 경로만 따로
+//  - 파워온 리셋 직후 (DWT 꺼짐, Sched_Init 전) 에 전압이 떨어졌다 돌아옴
+//      → PowerFail_Init이 사이클 카운터를 켜고, 카운터가 멈춰 있어도 복구 루프가 리셋으로 끝남
+//  - 메인 문맥의 섹터 erase 도중 전압 저하 → erase 지연까지 예산에 들어가고 최악값으로 남음,
+//    ISR 때 플래시가 아직 BSY면 플래시에 아무것도 안 씀
+//  - NVIC_SystemReset 은 훅에서 longjmp (ISR은 원래 돌아오지 않음)
+#include <string.h>
+#include "test_util.h"
+#include "hal_shim.h"
+
+#include "power_fail.c"
+
+static jmp_buf  s_reset_env;
+static uint32_t s_resets;
+
+static void on_reset(void)
+{
+    s_resets++;
+    longjmp(s_reset_env, 1);
+}
+
+// PVD 인터럽트 한 번 (VDD는 이미 돌아온 상태: PVDO 0). 리셋까지 갔으면 true
+static bool pvd_dip(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_triggered = 0u;
+    PWR->CSR   &= ~PWR_CSR_PVDO;
+    if (setjmp(s_reset_env) == 0) {
+        HAL_PWR_PVDCallback();
+        return false;     // 돌아오면 안 됨
+    }
+    return true;
+}
+
+// ----------------- 사이클 카운터 -----------------
+static void test_cyccnt_enabled_by_init(void)
+{
+    CoreDebug->DEMCR = 0u;   // 파워온 리셋 상태
+    DWT->CTRL        = 0u;
+    PowerFail_Init();
+    CHECK((CoreDebug->DEMCR & CoreDebug_DEMCR_TRCENA_Msk) != 0u, "TRCENA not set by PowerFail_Init");
+    CHECK((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) != 0u, "CYCCNTENA not set by PowerFail_Init");
+}
+
+// 호스트의 CYCCNT는 안 움직임 = 카운터가 꺼진 보드와 같음 → 반복 횟수로 리셋
+static void test_recover_without_cyccnt(void)
+{
+    DWT->CYCCNT = 0u;
+    s_resets    = 0u;
+    CHECK(pvd_dip() && s_resets == 1u, "recovery loop never reset with a stopped cycle counter");
+    CHECK(s_stats.count == 1u, "last gasp ran %u times", s_stats.count);
+}
+
+// ----------------- erase 도중 -----------------
+// 1.5 s짜리 erase가 끝나고서야 ISR이 들어옴 (CYCCNT는 그동안 흐름, BSY는 이미 풀림)
+static void test_erase_stall(void)
+{
+    uint32_t cycles = (ClockProfile_GetSysclkHz() / 1000u) * 1500u;
+
+    DWT->CYCCNT = 0u;
+    PowerFail_EraseBegin();
+    DWT->CYCCNT = cycles;
+    CHECK(pvd_dip(), "no reset after an erase-time dip");
+    PowerFail_EraseEnd();
+
+    CHECK(s_stats.erase_in_progress && s_stats.erase_latency_us == 1500000u,
+          "erase: in progress %u, latency %u us", s_stats.erase_in_progress, s_stats.erase_latency_us);
+    CHECK(s_stats.over_budget, "1.5 s erase stall reported within the %u us budget", POWER_FAIL_BUDGET_US);
+    CHECK(!s_stats.flash_skipped && Settings_Get(SETTINGS_KEY_LASTGASP_MAX_US) >= 1500000,
+          "worst case not stored: %d us", (int)Settings_Get(SETTINGS_KEY_LASTGASP_MAX_US));
+
+    // erase가 끝난 뒤의 저하는 지연 없음
+    CHECK(pvd_dip() && !s_stats.erase_in_progress && s_stats.erase_latency_us == 0u && !s_stats.over_budget,
+          "after erase: in progress %u, latency %u us", s_stats.erase_in_progress, s_stats.erase_latency_us);
+}
+
+// ISR 때 플래시가 아직 BSY → 쓰기는 BSY를 기다려야 하므로 건너뜀
+static void test_busy_skips_flush(void)
+{
+    uint32_t ops = Shim_FlashOps();
+
+    DWT->CYCCNT = 0u;
+    PowerFail_EraseBegin();
+    DWT->CYCCNT = (ClockProfile_GetSysclkHz() / 1000u) * 3000u;   // 이전 최악값보다 큼
+    FLASH->SR |= FLASH_SR_BSY;
+    CHECK(pvd_dip(), "no reset with flash busy");
+    FLASH->SR &= ~FLASH_SR_BSY;
+    PowerFail_EraseEnd();
+
+    CHECK(s_stats.flash_skipped && s_stats.erase_in_progress, "busy: skipped %u, in progress %u",
+          s_stats.flash_skipped, s_stats.erase_in_progress);
+    CHECK(Shim_FlashOps() == ops, "%u flash ops while BSY", Shim_FlashOps() - ops);
+}
+
+int main(void)
+{
+    Shim_FlashInit();
+    Shim_Reset();
+    shim_on_reset = on_reset;
+    Settings_Set(SETTINGS_KEY_LASTGASP_MAX_US, 0);   // 빈 플래시 → 활성 섹터 만들어 둠
+
+    test_cyccnt_enabled_by_init();
+    test_recover_without_cyccnt();
+    test_erase_stall();
+    test_busy_skips_flush();
+    return test_done("power_fail");
+}
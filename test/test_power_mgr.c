@@ -0,0 +1,244 @@
+// test_power_mgr.c
+//  주차 절전 전체 흐름: main.c를 그대로 포함해서 실제 태스크 표(Task_Key / Task_Power)로 돌림
+//  - fw_main()을 첫 WFI까지 돌려서 부팅 초기화는 펌웨어 그대로, 그 뒤로는 테스트가 1 ms씩 시간을 밀며 Sched_RunOnce
+//  - 수신기 대신 1초마다 fix를 PowerMgr_OnFix + SCHED_EV_GPS_FIX 로 넣음 (TASK_GPS / TASK_BOOT는 끔)
+//  - TIM3(100 ms) / TIM5(2 kHz) 콜백은 CEN이 켜져 있을 때만
+//  - RTC wakeup: LSI 30 kHz / 16 로 만료 (보정 1회 + STOP마다)
+//  - STOP 훅: 보통은 RTC wakeup으로 깨우고, 버튼 시나리오에서는 PA0 LOW + EXTI 콜백
+//  - 마지막에 상태별 시간 × 대략 전류로 mAh/h (주행 / 주차 / STOP 없이 주차)
+#include <string.h>
+#include "test_util.h"
+#include "hal_shim.h"
+
+#define main fw_main
+#include "main.c"
+#undef main
+
+#define LSI_RTC_HZ   1875u   // LSI 30 kHz / 16 (공칭 2 kHz와 일부러 다르게)
+
+// ----------------- 모의 하드웨어 -----------------
+static jmp_buf  s_boot_env;
+static uint32_t s_next_fix_ms;
+static float    s_speed_kmh;
+static bool     s_rtc_prev_armed;
+static uint32_t s_rtc_due_ms;
+static bool     s_press_in_stop;    // 다음 STOP에서 버튼으로 깨움
+
+static uint32_t s_stop_ms;          // STOP으로 잔 시간 합
+static uint32_t s_key_wake_stops;
+
+static uint32_t rtc_period_ms(void)
+{
+    return ((Shim_RtcWakeCounts() + 1u) * 1000u) / LSI_RTC_HZ;
+}
+
+static void boot_wfi(void)
+{
+    longjmp(s_boot_env, 1);
+}
+
+static void on_stop(void)
+{
+    if (s_press_in_stop) {
+        s_press_in_stop = false;
+        s_key_wake_stops++;
+        GPIOA->IDR &= ~(uint32_t)GPIO_PIN_0;
+        HAL_GPIO_EXTI_Callback(GPIO_PIN_0);
+        return;
+    }
+    // 버튼이 눌린 채로 다시 잠들면 안 됨 (power_stop_for 루프 조건)
+    CHECK((GPIOA->IDR & GPIO_PIN_0) != 0u, "entered STOP with the key held");
+    s_stop_ms += rtc_period_ms();
+    HAL_RTCEx_WakeUpTimerEventCallback(&hrtc);
+}
+
+static void key_release(void)
+{
+    GPIOA->IDR |= GPIO_PIN_0;
+    HAL_GPIO_EXTI_Callback(GPIO_PIN_0);
+}
+
+// 1 ms: 인터럽트 흉내 → 메인 루프 한 바퀴
+static void tick_1ms(void)
+{
+    Shim_Advance(1u);
+    uint32_t now = HAL_GetTick();
+
+    if (TIM5->CR1 & 1u) {
+        HAL_TIM_PeriodElapsedCallback(&htim5);
+        HAL_TIM_PeriodElapsedCallback(&htim5);
+    }
+    if ((TIM3->CR1 & 1u) && (now % 100u) == 0u) {
+        HAL_TIM_PeriodElapsedCallback(&htim3);
+    }
+
+    // LSI 보정용 RTC wakeup (STOP 밖에서 만료)
+    bool armed = Shim_RtcWakeArmed();
+    if (armed && !s_rtc_prev_armed) {
+        s_rtc_due_ms = now + rtc_period_ms();
+    }
+    s_rtc_prev_armed = armed;
+    if (armed && (int32_t)(now - s_rtc_due_ms) >= 0) {
+        HAL_RTCEx_WakeUpTimerEventCallback(&hrtc);
+        s_rtc_due_ms = now + rtc_period_ms();
+    }
+
+    if ((int32_t)(now - s_next_fix_ms) >= 0) {
+        app_gps_state_t gps;
+        memset(&gps, 0, sizeof(gps));
+        gps.valid     = true;
+        gps.speed_kmh = s_speed_kmh;
+        PowerMgr_OnFix(&gps, now);
+        Sched_Post(SCHED_EV_GPS_FIX);
+        s_next_fix_ms += 1000u;
+    }
+
+    Sched_RunOnce();
+}
+
+// ms 동안 돌림 (STOP이 시간을 건너뛰어도 끝 시각 기준), 그동안 ACTIVE로 돌아간 횟수 반환
+static uint32_t run(uint32_t ms)
+{
+    uint32_t end = HAL_GetTick() + ms;
+    uint32_t wakes = 0u;
+    power_state_t prev = PowerMgr_GetState();
+
+    while ((int32_t)(HAL_GetTick() - end) < 0) {
+        tick_1ms();
+        power_state_t st = PowerMgr_GetState();
+        if (prev == POWER_STATE_PARKED && st == POWER_STATE_ACTIVE) {
+            wakes++;
+        }
+        prev = st;
+    }
+    return wakes;
+}
+
+static void boot(void)
+{
+    Shim_FlashInit();
+    Shim_Reset();
+    Shim_SetTick(1000u);
+
+    shim_on_wfi = boot_wfi;
+    if (setjmp(s_boot_env) == 0) {
+        fw_main();
+    }
+    shim_on_wfi  = NULL;
+    shim_on_stop = on_stop;
+
+    // 수신기 설정 대기 대신 부팅 끝난 상태로
+    Sched_SetEnabled(TASK_BOOT, false);
+    Sched_SetEnabled(TASK_GPS, false);
+    ClockProfile_ReleaseFull();
+
+    s_next_fix_ms    = (HAL_GetTick() / 1000u + 1u) * 1000u;
+    s_speed_kmh      = 0.0f;
+    s_rtc_prev_armed = false;
+}
+
+// ----------------- 시나리오 -----------------
+static uint32_t s_park_awake_ms, s_park_window_ms;
+
+// 5분 서 있으면 PARKED, 그 뒤 10 ms 주기 Task_Key 호출로는 안 깨어나고 STOP까지 감
+static void test_park_and_stop(void)
+{
+    uint32_t t0 = HAL_GetTick();
+    uint32_t parked_at = 0u;
+
+    while (PowerMgr_GetState() == POWER_STATE_ACTIVE && (HAL_GetTick() - t0) < 400000u) {
+        tick_1ms();
+    }
+    parked_at = HAL_GetTick() - t0;
+    CHECK(PowerMgr_GetState() == POWER_STATE_PARKED, "never parked");
+    CHECK(parked_at >= POWER_PARK_TIMEOUT_MIN * 60000u && parked_at <= POWER_PARK_TIMEOUT_MIN * 60000u + 50u,
+          "parked after %u ms", parked_at);
+
+    // 페이드 + 보정(약 1초) 끝날 때까지
+    uint32_t wakes = run(3000u);
+    CHECK(wakes == 0u, "unparked %u times without input (periodic key poll)", wakes);
+    CHECK(DispBright_GetLevel() == 0u, "display not faded out (level %u)", DispBright_GetLevel());
+    CHECK((TIM5->CR1 & 1u) == 0u, "2 kHz brightness tick still running");
+
+    uint32_t stops0 = Shim_StopCount(), stop_ms0 = s_stop_ms;
+    s_park_window_ms = 60000u;
+    wakes = run(s_park_window_ms);
+    s_park_awake_ms = s_park_window_ms - (s_stop_ms - stop_ms0);
+
+    printf("  parked 60 s: %u STOP entries, %u ms awake (%.1f%%)\n",
+           Shim_StopCount() - stops0, s_park_awake_ms, 100.0 * s_park_awake_ms / s_park_window_ms);
+    CHECK(wakes == 0u && PowerMgr_GetState() == POWER_STATE_PARKED, "left PARKED without input");
+    CHECK(Shim_StopCount() - stops0 >= 55u, "only %u STOP entries in 60 epochs", Shim_StopCount() - stops0);
+    CHECK(s_park_awake_ms < s_park_window_ms / 5u, "awake %u ms of 60 s", s_park_awake_ms);
+}
+
+// STOP 중 버튼 → EXTI → Task_Key가 엣지 이벤트로 깨움, 그 누름은 입력으로 안 침
+static void test_key_wake(void)
+{
+    uint16_t mode_before = (uint16_t)g_display_mode;
+
+    s_press_in_stop  = true;
+    s_key_wake_stops = 0u;
+    uint32_t t0 = HAL_GetTick();
+    while (PowerMgr_GetState() == POWER_STATE_PARKED && (HAL_GetTick() - t0) < 3000u) {
+        tick_1ms();
+    }
+    CHECK(s_key_wake_stops == 1u, "key was not pressed inside STOP");
+    CHECK(PowerMgr_GetState() == POWER_STATE_ACTIVE, "key press in STOP did not wake");
+    CHECK((TIM5->CR1 & 1u) != 0u, "brightness tick not restarted");
+
+    run(150u);
+    key_release();
+    run(1000u);
+    CHECK(PowerMgr_GetState() == POWER_STATE_ACTIVE, "fell back to PARKED right after key wake");
+    CHECK(DispBright_GetLevel() != 0u, "display still dark after key wake");
+    CHECK((uint16_t)g_display_mode == mode_before, "wake-up press was taken as a SHORT");
+}
+
+// 다시 주차 → 출발 (fix 속도)로 한 epoch 안에 복구
+static void test_drive_wake(void)
+{
+    run(POWER_PARK_TIMEOUT_MIN * 60000u + 3000u);
+    CHECK(PowerMgr_GetState() == POWER_STATE_PARKED, "did not park again");
+
+    s_speed_kmh = 20.0f;
+    uint32_t t0 = HAL_GetTick();
+    while (PowerMgr_GetState() == POWER_STATE_PARKED && (HAL_GetTick() - t0) < 3000u) {
+        tick_1ms();
+    }
+    CHECK(PowerMgr_GetState() == POWER_STATE_ACTIVE, "moving fix did not wake");
+    CHECK(HAL_GetTick() - t0 <= 1000u, "drive wake took %u ms", HAL_GetTick() - t0);
+}
+
+// ----------------- 전류 모델 -----------------
+// 대략값 (데이터시트 typ): STM32F411 / MAX7219 8자리 중간 밝기 / u-blox M8
+#define EM_MCU_ACTIVE_MA   8.0    // MID 프로파일, 대부분 WFI
+#define EM_MCU_PARKED_MA   3.0    // HSI 16 MHz, fix 하나 처리
+#define EM_MCU_STOP_MA     0.05   // STOP + 저전력 레귤레이터
+#define EM_DISP_ON_MA      60.0
+#define EM_DISP_SHDN_MA    0.15
+#define EM_GPS_CONT_MA     25.0
+#define EM_GPS_PSM_MA      9.0    // 1 Hz cyclic tracking 평균
+
+static void energy_model(void)
+{
+    double awake = (double)s_park_awake_ms / s_park_window_ms;
+    double drive = EM_MCU_ACTIVE_MA + EM_DISP_ON_MA + EM_GPS_CONT_MA;
+    double park  = awake * EM_MCU_PARKED_MA + (1.0 - awake) * EM_MCU_STOP_MA + EM_DISP_SHDN_MA + EM_GPS_PSM_MA;
+    double park_wfi = EM_MCU_PARKED_MA + EM_DISP_SHDN_MA + EM_GPS_PSM_MA;
+
+    printf("  energy model: driving %.1f mAh/h, parked %.2f mAh/h (%.2f without STOP)\n",
+           drive, park, park_wfi);
+    CHECK(park < park_wfi, "STOP does not save anything in the model");
+}
+
+int main(void)
+{
+    boot();
+    test_park_and_stop();
+    energy_model();
+    test_key_wake();
+    test_drive_wake();
+
+    return test_done("power_mgr");
+}
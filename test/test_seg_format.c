@@ -0,0 +1,213 @@
+// test_seg_format.c
+//  SegFmt_* (정수 전용) 결과가 예전 snprintf / float 경로와 같은 세그먼트를 만드는지 전 범위 비교,
+//  그리고 필드 하나 만드는 데 드는 시간 (호스트 ns, x86이면 TSC 사이클도)
+#include <math.h>
+#include <string.h>
+#include "test_util.h"
+#include "seg_format.h"
+#include "max7219.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+// ----------------- 예전 방식 (app_display.c ui_print_*, 문자 → 폰트) -----------------
+static void legacy_put(uint8_t *out, uint8_t pos, char ch, bool dp)
+{
+    out[pos] = (uint8_t)(max7219_SegFromChar(ch) | (dp ? MAX7219_SEG_DP : 0x00u));
+}
+
+// XXX.X (4자리)
+static void legacy_fixed_1(uint8_t *out, float value, uint16_t max_x10)
+{
+    if (value < 0.0f) {
+        value = -value;
+    }
+    float max_val = (float)max_x10 / 10.0f;
+    if (value > max_val) {
+        value = max_val;
+    }
+    uint16_t v10 = (uint16_t)(value * 10.0f + 0.5f);
+    if (v10 > max_x10) {
+        v10 = max_x10;
+    }
+
+    uint8_t d[4];
+    d[0] = (uint8_t)((v10 / 1000u) % 10u);
+    d[1] = (uint8_t)((v10 / 100u) % 10u);
+    d[2] = (uint8_t)((v10 / 10u) % 10u);
+    d[3] = (uint8_t)(v10 % 10u);
+
+    bool show[4] = { false, false, true, true };
+    if (v10 >= 1000u) {
+        show[0] = true;
+        show[1] = true;
+    } else if (v10 >= 100u) {
+        show[1] = true;
+    }
+    for (uint8_t i = 0u; i < 4u; ++i) {
+        legacy_put(out, i, show[i] ? (char)('0' + d[i]) : ' ', i == 2u);
+    }
+}
+
+// 정수 우측 정렬 (snprintf)
+static void legacy_uint_right(uint8_t *out, uint32_t value, uint8_t width)
+{
+    char buf[12];
+    int  n = snprintf(buf, sizeof(buf), "%lu", (unsigned long)value);
+
+    for (uint8_t i = 0u; i < width; ++i) {
+        int src = n - (int)width + (int)i;
+        legacy_put(out, i, (src >= 0) ? buf[src] : ' ', false);
+    }
+}
+
+// -XX.X (부호 1자리 + 3자리)
+static void legacy_signed_grade(uint8_t *out, float grade)
+{
+    if (grade > 99.9f)  grade = 99.9f;
+    if (grade < -99.9f) grade = -99.9f;
+
+    legacy_put(out, 0u, (grade < -0.05f) ? '-' : ' ', false);
+
+    uint16_t v10 = (uint16_t)(fabsf(grade) * 10.0f + 0.5f);
+    if (v10 > 999u) {
+        v10 = 999u;
+    }
+    legacy_put(out, 1u, (v10 >= 100u) ? (char)('0' + (v10 / 100u) % 10u) : ' ', false);
+    legacy_put(out, 2u, (char)('0' + (v10 / 10u) % 10u), true);
+    legacy_put(out, 3u, (char)('0' + v10 % 10u), false);
+}
+
+// XXX (속도 정수)
+static void legacy_speed_int3(uint8_t *out, float speed_kmh)
+{
+    if (speed_kmh < 0.0f)   speed_kmh = 0.0f;
+    if (speed_kmh > 199.0f) speed_kmh = 199.0f;
+
+    uint16_t v = (uint16_t)(speed_kmh + 0.5f);
+    uint8_t  h = (uint8_t)((v / 100u) % 10u);
+    uint8_t  t = (uint8_t)((v / 10u) % 10u);
+
+    legacy_put(out, 0u, (h > 0u) ? (char)('0' + h) : ' ', false);
+    legacy_put(out, 1u, ((h > 0u) || (t > 0u)) ? (char)('0' + t) : ' ', false);
+    legacy_put(out, 2u, (char)('0' + v % 10u), false);
+}
+
+// ----------------- 비교 -----------------
+static void check_same(const uint8_t *a, const uint8_t *b, uint8_t w, const char *what, long v)
+{
+    CHECK(memcmp(a, b, w) == 0, "%s(%ld): %02X %02X %02X %02X vs %02X %02X %02X %02X",
+          what, v, a[0], a[1], a[2], w > 3u ? a[3] : 0u, b[0], b[1], b[2], w > 3u ? b[3] : 0u);
+}
+
+static void test_equivalence(void)
+{
+    uint8_t a[SEGFMT_MAX_WIDTH], b[SEGFMT_MAX_WIDTH];
+
+    for (uint32_t v10 = 0u; v10 <= 9999u; ++v10) {
+        legacy_fixed_1(a, (float)v10 / 10.0f, 9999u);
+        SegFmt_Unsigned(b, 4u, v10, 1u, 9999u, 0u);
+        check_same(a, b, 4u, "fixed_1", (long)v10);
+    }
+
+    for (uint32_t i = 0u; i < 200000u; ++i) {
+        uint32_t v = (i < 100000u) ? i : (test_rand() % 100000u);
+        legacy_uint_right(a, v, 5u);
+        SegFmt_Unsigned(b, 5u, v, 0u, 99999u, 0u);
+        check_same(a, b, 5u, "uint_right", (long)v);
+    }
+
+    for (int32_t g10 = -999; g10 <= 999; ++g10) {
+        legacy_signed_grade(a, (float)g10 / 10.0f);
+        SegFmt_Signed(b, 4u, g10, 1u, 999u, 0u);
+        check_same(a, b, 4u, "signed_grade", (long)g10);
+    }
+
+    for (uint32_t v = 0u; v <= 199u; ++v) {
+        legacy_speed_int3(a, (float)v);
+        SegFmt_Unsigned(b, 3u, v, 0u, 199u, 0u);
+        check_same(a, b, 3u, "speed_int3", (long)v);
+    }
+
+    // 클램프 / 오버플로 표시
+    SegFmt_Unsigned(b, 3u, 250u, 0u, 199u, 0u);
+    legacy_speed_int3(a, 250.0f);
+    check_same(a, b, 3u, "speed clamp", 250);
+
+    SegFmt_Unsigned(b, 4u, 12345u, 1u, 9999u, SEGFMT_OVF_MARK);
+    for (uint8_t i = 0u; i < 4u; ++i) {
+        CHECK(b[i] == SEGFMT_SEG_OVF, "overflow mark digit %u = %02X", i, b[i]);
+    }
+
+    // ZERO_PAD + DP_LAST ("2026.")
+    SegFmt_Unsigned(b, 4u, 2026u, 0u, 9999u, SEGFMT_ZERO_PAD | SEGFMT_DP_LAST);
+    CHECK(b[0] == MAX7219_FONT_ASCII['2'] && b[1] == MAX7219_FONT_ASCII['0'] &&
+          b[3] == (MAX7219_FONT_ASCII['6'] | MAX7219_SEG_DP), "year format");
+
+    // uint32 전체 폭
+    SegFmt_Unsigned(b, 9u, 999999999u, 0u, 0xFFFFFFFFu, 0u);
+    for (uint8_t i = 0u; i < 9u; ++i) {
+        CHECK(b[i] == MAX7219_FONT_ASCII['9'], "9 digits [%u]", i);
+    }
+}
+
+// ----------------- 벤치마크 -----------------
+#define BENCH_N  2000000u
+
+static volatile uint8_t s_sink;
+
+typedef void (*bench_fn_t)(uint8_t *out, uint32_t v);
+
+static void bl_fixed_1(uint8_t *o, uint32_t v)  { legacy_fixed_1(o, (float)(v % 10000u) / 10.0f, 9999u); }
+static void bn_fixed_1(uint8_t *o, uint32_t v)  { SegFmt_Unsigned(o, 4u, v % 10000u, 1u, 9999u, 0u); }
+static void bl_uint(uint8_t *o, uint32_t v)     { legacy_uint_right(o, v % 100000u, 5u); }
+static void bn_uint(uint8_t *o, uint32_t v)     { SegFmt_Unsigned(o, 5u, v % 100000u, 0u, 99999u, 0u); }
+static void bl_grade(uint8_t *o, uint32_t v)    { legacy_signed_grade(o, (float)((int32_t)(v % 1999u) - 999) / 10.0f); }
+static void bn_grade(uint8_t *o, uint32_t v)    { SegFmt_Signed(o, 4u, (int32_t)(v % 1999u) - 999, 1u, 999u, 0u); }
+static void bl_speed(uint8_t *o, uint32_t v)    { legacy_speed_int3(o, (float)(v % 200u)); }
+static void bn_speed(uint8_t *o, uint32_t v)    { SegFmt_Unsigned(o, 3u, v % 200u, 0u, 199u, 0u); }
+
+static void bench_one(const char *name, bench_fn_t fn)
+{
+    uint8_t  out[SEGFMT_MAX_WIDTH];
+    uint32_t v = 12345u;
+
+    uint64_t t0 = test_now_ns();
+#ifdef HAVE_TSC
+    uint64_t c0 = __rdtsc();
+#endif
+    for (uint32_t i = 0u; i < BENCH_N; ++i) {
+        v = (v * 1103515245u) + 12345u;
+        fn(out, v >> 8);
+        s_sink ^= out[0];
+    }
+#ifdef HAVE_TSC
+    uint64_t c1 = __rdtsc();
+#endif
+    uint64_t t1 = test_now_ns();
+
+    printf("  %-22s %7.1f ns/field", name, (double)(t1 - t0) / BENCH_N);
+#ifdef HAVE_TSC
+    printf("  %7.1f TSC cycles/field", (double)(c1 - c0) / BENCH_N);
+#endif
+    printf("\n");
+}
+
+int main(void)
+{
+    test_equivalence();
+
+    printf("per-field cost (legacy float/snprintf vs SegFmt):\n");
+    bench_one("fixed_1   legacy", bl_fixed_1);
+    bench_one("fixed_1   SegFmt", bn_fixed_1);
+    bench_one("uint(5)   legacy", bl_uint);
+    bench_one("uint(5)   SegFmt", bn_uint);
+    bench_one("grade     legacy", bl_grade);
+    bench_one("grade     SegFmt", bn_grade);
+    bench_one("speed(3)  legacy", bl_speed);
+    bench_one("speed(3)  SegFmt", bn_speed);
+
+    return test_done("seg_format");
+}
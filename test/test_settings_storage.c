@@ -0,0 +1,390 @@
+// test_settings_storage.c
+//  설정 로그 전원 차단 시뮬레이터
+//  - settings_storage.c를 그대로 포함 (재부팅 = RAM 인덱스만 지움, 플래시는 그대로)
+//  - 작업 목록(키 쓰기 / 주차 중 erase)을 돌리다가 k번째 program/erase 직전에 전원을 끊고
+//    재부팅해서 모든 키가 "마지막으로 끝난 쓰기 값"인지 확인 (끊긴 쓰기의 키만 옛 값/새 값 둘 다 허용)
+//    → 구간 안의 모든 k에 대해 반복
+//  - 구간: 처음 쓰기 (섹터 선택 + 헤더 gen 1), 5 → 6 넘어가기 (gen 2, 옛 섹터 erase),
+//          6 → 5 (gen 3, 아직 안 지운 섹터를 넘어가면서 지움)
+//  - 주기 체크포인트: 부팅 때 뒤로 읽는 양이 묶이는지, 체크포인트 쓰는 중에 끊겨도 되는지
+//  - 전원 저하 예비 슬롯: 평소 한도까지 채운 뒤 last gasp 쓰기, 메인 문맥 쓰기를 끊고 들어오는 last gasp
+#include <string.h>
+#include "test_util.h"
+#include "hal_shim.h"
+
+#include "settings_storage.c"
+
+// 플래시 쓰기 중 FULL 클럭 요청은 호스트에서 의미 없음 (clock_profile.c 안 씀)
+void ClockProfile_RequestFull(void) { }
+void ClockProfile_ReleaseFull(void) { }
+// erase 구간 표시도 (power_fail.c 안 씀)
+void PowerFail_EraseBegin(void) { }
+void PowerFail_EraseEnd(void) { }
+
+#define AREA_BASE   0x08020000u
+#define AREA_SIZE   (2u * SETTINGS_SECTOR_SIZE)
+
+typedef enum { OP_SET, OP_PROCESS } op_kind_t;
+
+typedef struct {
+    op_kind_t kind;
+    uint8_t   key;
+    int32_t   value;
+} op_t;
+
+#define MAX_OPS   40000u
+
+static op_t     s_ops[MAX_OPS];
+static uint32_t s_nops;
+
+// 재부팅: RAM 상태만 초기화
+static void reboot(void)
+{
+    memset(&s_index, 0, sizeof(s_index));
+    s_last_gasp        = 0u;
+    s_migrate_src_addr = 0u;
+    pFlash.Lock        = HAL_UNLOCKED;
+}
+
+static int32_t rand_value(uint8_t key)
+{
+    const settings_key_desc_t *d = &s_keys[key];
+    int64_t span = (int64_t)d->max - d->min + 1;
+    int64_t v    = d->min + (int64_t)(test_rand() % (uint32_t)((span > 100000) ? 100000 : span));
+    return (int32_t)v;
+}
+
+// 트립 키 위주로 (실제 쓰기 빈도와 비슷하게), 가끔 설정 키
+static void gen_ops(uint32_t n, uint32_t process_every)
+{
+    s_nops = 0u;
+    for (uint32_t i = 0u; i < n && s_nops < MAX_OPS; ++i) {
+        op_t *op = &s_ops[s_nops++];
+        if (process_every != 0u && (i % process_every) == process_every - 1u) {
+            op->kind = OP_PROCESS;
+            continue;
+        }
+        uint32_t r = test_rand() % 16u;
+        op->kind  = OP_SET;
+        op->key   = (r < 12u) ? (uint8_t)(SETTINGS_KEY_TRIP_A_DIST_M + (r % 10u))
+                              : (uint8_t)(1u + (test_rand() % (SETTINGS_KEY_COUNT - 1u)));
+        op->value = rand_value(op->key);
+    }
+}
+
+// 기대값 (마지막으로 끝난 쓰기), 끊긴 쓰기의 키/새 값
+static int32_t s_model[SETTINGS_KEY_COUNT];
+static int32_t s_inflight_key;
+static int32_t s_inflight_value;
+
+static void model_reset(void)
+{
+    for (uint8_t k = 1u; k < SETTINGS_KEY_COUNT; ++k) {
+        s_model[k] = s_keys[k].def;
+    }
+}
+
+static void model_from_flash(void)
+{
+    reboot();
+    for (uint8_t k = 1u; k < SETTINGS_KEY_COUNT; ++k) {
+        s_model[k] = Settings_Get((settings_key_t)k);
+    }
+}
+
+// ops[from, to) 실행, 끊기면 false (끊긴 op 번호는 *cut_at)
+static bool run_ops(uint32_t from, uint32_t to, uint32_t *cut_at)
+{
+    volatile uint32_t i = from;
+
+    if (setjmp(shim_cut_env) != 0) {
+        *cut_at = i;
+        return false;
+    }
+    for (; i < to; ++i) {
+        const op_t *op = &s_ops[i];
+        s_inflight_key = (op->kind == OP_SET) ? op->key : -1;
+        s_inflight_value = op->value;
+        if (op->kind == OP_SET) {
+            CHECK(Settings_Set((settings_key_t)op->key, op->value), "op %u: Settings_Set(%u) failed", i, op->key);
+            s_model[op->key] = op->value;
+        } else {
+            (void)Settings_Process(true);
+        }
+    }
+    s_inflight_key = -1;
+    return true;
+}
+
+static uint32_t s_bad;
+
+// 활성 섹터는 "쓰인 슬롯 → 빈 슬롯" 경계가 하나뿐이어야 함 (경계를 이진 탐색으로 찾음)
+static void check_no_hole(const char *what, uint32_t k_cut)
+{
+    if (s_index.active == SETTINGS_NO_SECTOR) {
+        return;
+    }
+    bool blank_seen = false;
+    for (uint32_t i = 0u; i < SETTINGS_SLOT_COUNT; ++i) {
+        bool blank = settings_addr_blank(settings_slot_addr(s_index.active, i));
+        if (blank_seen && !blank && s_bad++ < 8u) {
+            CHECK(false, "%s, cut at flash op %u: written slot %u after a blank slot", what, k_cut, i);
+            return;
+        }
+        blank_seen = blank_seen || blank;
+    }
+}
+
+static void verify(const char *what, uint32_t k_cut)
+{
+    reboot();
+    (void)Settings_Get(SETTINGS_KEY_TIMEZONE);
+    check_no_hole(what, k_cut);
+    for (uint8_t k = 1u; k < SETTINGS_KEY_COUNT; ++k) {
+        int32_t got = Settings_Get((settings_key_t)k);
+        bool ok = (got == s_model[k]) || ((int32_t)k == s_inflight_key && got == s_inflight_value);
+        if (!ok && s_bad++ < 8u) {
+            CHECK(false, "%s, cut at flash op %u: key %u = %d, want %d", what, k_cut, k, got, s_model[k]);
+        }
+    }
+}
+
+// ----------------- 구간마다 모든 단계에서 끊기 -----------------
+static uint8_t s_snap[AREA_SIZE];
+
+static void snap_save(void)    { memcpy(s_snap, Shim_FlashPtr(AREA_BASE), AREA_SIZE); }
+static void snap_restore(void) { memcpy(Shim_FlashPtr(AREA_BASE), s_snap, AREA_SIZE); }
+
+// 스냅숏 + ops[from, to) 를 flash op k마다 끊어 보고, 끊긴 뒤에도 로그가 계속 쓸 만한지 (몇 번 더 쓰기)
+static void cut_sweep(const char *what, uint32_t from, uint32_t to)
+{
+    int32_t model0[SETTINGS_KEY_COUNT];
+
+    snap_save();
+    model_from_flash();
+    memcpy(model0, s_model, sizeof(model0));
+
+    // 끊지 않고 한 번: 이 구간의 flash op 수
+    uint32_t cut_at, ops0 = Shim_FlashOps();
+    reboot();
+    Shim_FlashCutAfter(-1);
+    run_ops(from, to, &cut_at);
+    uint32_t total = Shim_FlashOps() - ops0;
+
+    for (uint32_t k = 0u; k < total; ++k) {
+        snap_restore();
+        memcpy(s_model, model0, sizeof(model0));
+        reboot();
+
+        Shim_FlashCutAfter((int32_t)k);
+        bool done = run_ops(from, to, &cut_at);
+        Shim_FlashCutAfter(-1);
+        CHECK(!done, "%s: no cut at op %u of %u", what, k, total);
+        verify(what, k);
+
+        // 재부팅 후 같은 구간을 끝까지 (다시 끊지 않음) → 끝난 뒤 값도 맞아야 함
+        model_from_flash();
+        s_inflight_key = -1;
+        CHECK(run_ops(cut_at, to, &cut_at), "%s: cut again", what);
+        verify(what, k);
+    }
+    printf("  %-34s %5u cut points\n", what, total);
+
+    snap_restore();
+    memcpy(s_model, model0, sizeof(model0));
+    reboot();
+}
+
+static uint32_t hdr_gen(uint8_t sector)
+{
+    const settings_sector_hdr_t *h = (const settings_sector_hdr_t *)(uintptr_t)s_sector_base[sector];
+    return (h->magic == SETTINGS_KV_MAGIC && h->gen_inv == ~h->gen) ? h->gen : 0u;
+}
+
+// 섹터 남은 자리가 slots 개가 될 때까지 ops 를 끊지 않고 실행 (인덱스만 보고)
+static uint32_t fill_until(uint32_t from, uint32_t free_slots)
+{
+    uint32_t cut_at;
+    uint32_t limit = SETTINGS_SLOT_COUNT - SETTINGS_LAST_GASP_SLOTS;
+
+    while (from < s_nops && (s_index.active == SETTINGS_NO_SECTOR || limit - s_index.next_free_slot > free_slots)) {
+        run_ops(from, from + 1u, &cut_at);
+        from++;
+    }
+    return from;
+}
+
+static void test_rotation_cuts(void)
+{
+    Shim_FlashEraseAll();
+    model_reset();
+    reboot();
+    gen_ops(MAX_OPS, 3000u);
+
+    // 1) 빈 플래시에 처음 쓰기
+    cut_sweep("first write (gen 1)", 0u, 40u);
+    uint32_t cut_at;
+    run_ops(0u, 40u, &cut_at);
+    CHECK(hdr_gen(0u) == 1u && hdr_gen(1u) == 0u, "first sector gen %u/%u", hdr_gen(0u), hdr_gen(1u));
+
+    // 2) 5 → 6: 넘어가기 + 주차 erase
+    uint32_t at = fill_until(40u, 30u);
+    s_ops[at + 50u].kind = OP_PROCESS;   // 넘어간 뒤 주차 erase
+    cut_sweep("rotate 5->6 (gen 2) + erase", at, at + 80u);
+    run_ops(at, at + 80u, &cut_at);
+    CHECK(hdr_gen(1u) == 2u, "second sector gen %u", hdr_gen(1u));
+    CHECK(s_index.active == 1u, "active sector %u", s_index.active);
+    CHECK(settings_sector_blank(0u), "old sector not erased");
+
+    // 3) 6 → 5 인데 옛 섹터(5)를 주차 erase 전에 다시 씀 → 넘어가면서 지움
+    at = fill_until(at + 80u, 30u);
+    // 5번에 쓰레기 (지우다 만 섹터처럼)
+    uint32_t junk = 0x12345678u;
+    HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, s_sector_base[0] + 0x100u, junk);
+    reboot();
+    uint32_t e0 = Shim_FlashErases();
+    uint32_t stop = at;
+    while (stop < s_nops && s_ops[stop].kind == OP_SET) {
+        stop++;
+    }
+    stop = (stop > at + 80u) ? at + 80u : stop;
+    cut_sweep("rotate 6->5 (gen 3) over dirty", at, stop);
+    run_ops(at, stop, &cut_at);
+    CHECK(hdr_gen(0u) == 3u, "wrapped sector gen %u", hdr_gen(0u));
+    CHECK(Shim_FlashErases() - e0 >= 1u, "dirty target not erased before rotating");
+}
+
+// ----------------- 부팅 때 뒤로 읽는 양 -----------------
+// 섹터 처음에만 쓰인 키 + 한 번도 안 쓴 키가 있어도 마지막 체크포인트까지만 읽음
+static void test_replay_bound(void)
+{
+    uint32_t cut_at;
+
+    Shim_FlashEraseAll();
+    model_reset();
+    reboot();
+    gen_ops(MAX_OPS, 0u);
+    for (uint32_t i = 0u; i < MAX_OPS; ++i) {
+        // 트립 키만 (설정 키는 맨 처음 한 번)
+        s_ops[i].key   = (uint8_t)(SETTINGS_KEY_TRIP_A_DIST_M + (i % 10u));
+        s_ops[i].value = rand_value(s_ops[i].key);
+    }
+    s_ops[0].key   = SETTINGS_KEY_TIMEZONE;
+    s_ops[0].value = -5;
+
+    uint32_t at = fill_until(0u, 2000u);
+    reboot();
+    (void)Settings_Get(SETTINGS_KEY_TIMEZONE);
+    uint32_t walked = s_index.next_free_slot - s_index.checkpoint_slot;
+    printf("  replay after %u slots: walked back %u\n", s_index.next_free_slot, walked);
+    CHECK(walked <= SETTINGS_CHECKPOINT_SLOTS + SETTINGS_KEY_COUNT, "walked back %u slots", walked);
+    CHECK(!(s_index.stored_mask & (1u << SETTINGS_KEY_TELEM_MASK)), "never-stored key reported as stored");
+    verify("replay bound", 0u);
+
+    // 주기 체크포인트 한두 개를 포함한 구간에서 끊기
+    cut_sweep("periodic checkpoint", at, at + 300u);
+    run_ops(at, at + 300u, &cut_at);
+    verify("periodic checkpoint", 0u);
+}
+
+// ----------------- 전원 저하 예비 슬롯 -----------------
+static void test_last_gasp_reserve(void)
+{
+    uint32_t cut_at;
+
+    Shim_FlashEraseAll();
+    model_reset();
+    reboot();
+    gen_ops(MAX_OPS, 0u);
+
+    uint32_t at = fill_until(0u, 0u);
+    uint32_t limit = SETTINGS_SLOT_COUNT - SETTINGS_LAST_GASP_SLOTS;
+    CHECK(s_index.next_free_slot == limit, "filled to %u, limit %u", s_index.next_free_slot, limit);
+    uint32_t gen = s_index.active_gen;
+
+    // 평소 쓰기면 여기서 넘어가겠지만 last gasp는 예비 슬롯에
+    Settings_BeginLastGasp();
+    int32_t v = 1000;
+    for (uint8_t k = SETTINGS_KEY_TRIP_A_DIST_M; k <= SETTINGS_KEY_TRIP_LAST_UTC_S; ++k) {
+        v += 7;
+        CHECK(Settings_Set((settings_key_t)k, v), "last gasp set %u failed", k);
+        s_model[k] = v;
+    }
+    CHECK(s_index.active_gen == gen, "last gasp rotated the log");
+    CHECK(s_index.next_free_slot > limit, "last gasp did not use the reserve");
+    verify("last gasp reserve", 0u);
+
+    // 예비 슬롯까지 다 쓰면 실패만 (erase/넘어가기 안 함)
+    Settings_BeginLastGasp();
+    uint32_t e0 = Shim_FlashErases();
+    uint32_t n_ok = 0u;
+    for (uint32_t i = 0u; i < SETTINGS_LAST_GASP_SLOTS + 4u; ++i) {
+        if (Settings_Set(SETTINGS_KEY_ODO_DIST_M, (int32_t)(5000u + i))) {
+            s_model[SETTINGS_KEY_ODO_DIST_M] = (int32_t)(5000u + i);
+            n_ok++;
+        }
+    }
+    CHECK(Shim_FlashErases() == e0 && s_index.active_gen == gen, "last gasp erased or rotated");
+    CHECK(n_ok < SETTINGS_LAST_GASP_SLOTS, "wrote %u records past the reserve", n_ok);
+    verify("last gasp reserve full", 0u);
+
+    // 다음 부팅의 평소 쓰기는 넘어감
+    CHECK(run_ops(at, at + 1u, &cut_at), "write after full reserve");
+    CHECK(s_index.active_gen == gen + 1u, "no rotation after the reserve was used");
+    verify("after reserve rotation", 0u);
+}
+
+// 메인 문맥 쓰기를 끊고 들어온 last gasp (PVD 인터럽트는 돌아오지 않음)
+//  a) 첫 워드 쓰기 직전에 끊김   b) 첫 워드만 쓰고 끊김 (경계 갱신 전 / 후)
+static void test_last_gasp_preempt(void)
+{
+    static const char *const names[] = { "before word 0", "after word 0, boundary not moved",
+                                         "after word 0, boundary moved" };
+
+    for (uint32_t c = 0u; c < 3u; ++c) {
+        uint32_t cut_at;
+
+        Shim_FlashEraseAll();
+        model_reset();
+        reboot();
+        gen_ops(200u, 0u);
+        run_ops(0u, 100u, &cut_at);
+
+        int32_t old = s_model[SETTINGS_KEY_TIMEZONE];
+        uint32_t slot = s_index.next_free_slot;
+        Shim_FlashCutAfter((c == 0u) ? 0 : 1);
+        if (setjmp(shim_cut_env) == 0) {
+            Settings_Set(SETTINGS_KEY_TIMEZONE, (old == 3) ? 4 : 3);
+            CHECK(false, "main write not cut");
+        }
+        Shim_FlashCutAfter(-1);
+        if (c == 1u) {
+            s_index.next_free_slot = slot;   // 첫 워드와 경계 갱신 사이
+        }
+
+        // 여기서부터 PVD 인터럽트 (s_index는 끊긴 그대로)
+        Settings_BeginLastGasp();
+        CHECK(Settings_Set(SETTINGS_KEY_ODO_DIST_M, 777777), "%s: last gasp set failed", names[c]);
+        s_model[SETTINGS_KEY_ODO_DIST_M] = 777777;
+
+        verify(names[c], 0u);
+        CHECK(Settings_Get(SETTINGS_KEY_TIMEZONE) == old, "%s: half-written record was used", names[c]);
+
+        // 다음 부팅에서 계속 쓸 수 있어야 함
+        CHECK(run_ops(100u, 200u, &cut_at), "%s: writes after reboot", names[c]);
+        verify(names[c], 0u);
+    }
+}
+
+int main(void)
+{
+    Shim_FlashInit();
+    Shim_Reset();
+
+    test_rotation_cuts();
+    test_replay_bound();
+    test_last_gasp_reserve();
+    test_last_gasp_preempt();
+
+    return test_done("settings_storage");
+}
@@ -0,0 +1,185 @@
+// test_solar.c
+//  solar.c (day-of-year 표 + float32 시간각) 정확도를 NOAA/Meeus double 계산과 비교
+//  - 기준: 사건 시각의 적위/균시차로 3번 반복 (태양이 움직이는 것까지 반영)
+//  - 2024~2027 (윤년 주기 전체), 위도 -60 ~ 64, 경도 5개
+//  - 허용: 일출/일몰 3.5분 (위도 60도 이상에서 정오 적위만 쓰는 오차가 2~3분), 고도 0.5도
+#include <math.h>
+#include "test_util.h"
+#include "solar.h"
+
+#define D2R(x)  ((x) * M_PI / 180.0)
+#define R2D(x)  ((x) * 180.0 / M_PI)
+
+// ----------------- 기준 (NOAA 스프레드시트 식) -----------------
+static double julian_day(int y, int m, int d, double hour_utc)
+{
+    if (m <= 2) {
+        y -= 1;
+        m += 12;
+    }
+    int a = y / 100;
+    int b = 2 - a + a / 4;
+    return floor(365.25 * (y + 4716)) + floor(30.6001 * (m + 1)) + d + b - 1524.5 + hour_utc / 24.0;
+}
+
+static void noaa_params(double jd, double *decl_deg, double *eot_min)
+{
+    double t   = (jd - 2451545.0) / 36525.0;
+    double l0  = fmod(280.46646 + t * (36000.76983 + t * 0.0003032), 360.0);
+    double m   = 357.52911 + t * (35999.05029 - 0.0001537 * t);
+    double e   = 0.016708634 - t * (0.000042037 + 0.0000001267 * t);
+    double c   = sin(D2R(m)) * (1.914602 - t * (0.004817 + 0.000014 * t)) +
+                 sin(D2R(2.0 * m)) * (0.019993 - 0.000101 * t) + sin(D2R(3.0 * m)) * 0.000289;
+    double om  = 125.04 - 1934.136 * t;
+    double lam = l0 + c - 0.00569 - 0.00478 * sin(D2R(om));
+    double eps0 = 23.0 + (26.0 + (21.448 - t * (46.815 + t * (0.00059 - t * 0.001813))) / 60.0) / 60.0;
+    double eps = eps0 + 0.00256 * cos(D2R(om));
+    double y   = tan(D2R(eps / 2.0));
+
+    y *= y;
+    *decl_deg = R2D(asin(sin(D2R(eps)) * sin(D2R(lam))));
+    *eot_min  = 4.0 * R2D(y * sin(2.0 * D2R(l0)) - 2.0 * e * sin(D2R(m)) +
+                          4.0 * e * y * sin(D2R(m)) * cos(2.0 * D2R(l0)) -
+                          0.5 * y * y * sin(4.0 * D2R(l0)) - 1.25 * e * e * sin(2.0 * D2R(m)));
+}
+
+// sign -1 = 일출, +1 = 일몰 (UTC 분). 없으면 false
+static bool ref_event(int y, int mo, int d, double lat, double lon, int sign, double *out_min)
+{
+    double t = 720.0 - 4.0 * lon;
+
+    for (int it = 0; it < 3; ++it) {
+        double decl, eot;
+        noaa_params(julian_day(y, mo, d, t / 60.0), &decl, &eot);
+        double c = (cos(D2R(SOLAR_ZENITH_OFFICIAL)) - sin(D2R(lat)) * sin(D2R(decl))) /
+                   (cos(D2R(lat)) * cos(D2R(decl)));
+        if (c > 1.0 || c < -1.0) {
+            return false;
+        }
+        t = 720.0 - 4.0 * lon - eot + sign * 4.0 * R2D(acos(c));
+    }
+    *out_min = t;
+    return true;
+}
+
+static double ref_elevation(int y, int mo, int d, double lat, double lon, int minute_utc)
+{
+    double decl, eot;
+    noaa_params(julian_day(y, mo, d, minute_utc / 60.0), &decl, &eot);
+    double ha = (minute_utc + eot + 4.0 * lon) / 4.0 - 180.0;
+    return R2D(asin(sin(D2R(lat)) * sin(D2R(decl)) + cos(D2R(lat)) * cos(D2R(decl)) * cos(D2R(ha))));
+}
+
+// ----------------- 날짜 -----------------
+static const uint8_t s_mdays[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+static bool is_leap(int y)
+{
+    return ((y % 4) == 0 && (y % 100) != 0) || ((y % 400) == 0);
+}
+
+static void doy_to_date(int y, int doy, int *mo, int *d)
+{
+    int m = 0;
+    while (true) {
+        int n = s_mdays[m] + ((m == 1 && is_leap(y)) ? 1 : 0);
+        if (doy <= n) {
+            break;
+        }
+        doy -= n;
+        m++;
+    }
+    *mo = m + 1;
+    *d  = doy;
+}
+
+// ----------------- 검사 -----------------
+static const double s_lats[] = { -60.0, -45.0, -33.9, -15.0, 0.0, 15.0, 23.4, 37.5, 45.0, 52.5, 60.0, 64.0 };
+static const double s_lons[] = { -150.0, -74.0, 0.0, 127.0, 175.0 };
+
+static void test_events(void)
+{
+    double   max_err = 0.0, sum_err = 0.0;
+    uint32_t n = 0u, mismatch = 0u;
+
+    for (int y = 2024; y <= 2027; ++y) {
+        int days = is_leap(y) ? 366 : 365;
+        for (int doy = 1; doy <= days; doy += 3) {
+            int mo, d;
+            doy_to_date(y, doy, &mo, &d);
+
+            for (size_t i = 0u; i < sizeof(s_lats) / sizeof(s_lats[0]); ++i) {
+                for (size_t j = 0u; j < sizeof(s_lons) / sizeof(s_lons[0]); ++j) {
+                    double  rr, rs;
+                    int16_t r, s;
+                    bool ref_ok = ref_event(y, mo, d, s_lats[i], s_lons[j], -1, &rr) &&
+                                  ref_event(y, mo, d, s_lats[i], s_lons[j], +1, &rs);
+                    bool ok = Solar_EventsUtc((uint16_t)doy, (float)s_lats[i], (float)s_lons[j],
+                                              SOLAR_ZENITH_OFFICIAL, &r, &s);
+                    if (ok != ref_ok) {
+                        mismatch++;
+                        continue;
+                    }
+                    if (!ok) {
+                        continue;
+                    }
+                    double er = fabs(r - rr), es = fabs(s - rs);
+                    CHECK(er <= 3.5 && es <= 3.5, "%04d-%02d-%02d lat %.1f lon %.0f: rise %d/%.1f set %d/%.1f",
+                          y, mo, d, s_lats[i], s_lons[j], r, rr, s, rs);
+                    max_err = fmax(max_err, fmax(er, es));
+                    sum_err += er + es;
+                    n += 2u;
+                }
+            }
+        }
+    }
+
+    printf("  rise/set: %u events, max %.2f min, mean %.2f min\n", n, max_err, sum_err / n);
+    CHECK(mismatch == 0u, "%u days disagree on whether the sun rises/sets", mismatch);
+    CHECK(sum_err / n < 0.75, "mean error %.2f min", sum_err / n);
+}
+
+static void test_elevation(void)
+{
+    static const double pos[][2] = { { 37.5, 127.0 }, { 60.0, 10.0 }, { -33.9, 151.2 }, { 40.7, -74.0 } };
+    double max_err = 0.0;
+
+    for (int doy = 1; doy <= 365; doy += 4) {
+        int mo, d;
+        doy_to_date(2026, doy, &mo, &d);
+        for (size_t p = 0u; p < 4u; ++p) {
+            solar_state_t st;
+            Solar_StatePrepare(&st, (uint16_t)doy, (float)pos[p][0], (float)pos[p][1]);
+            for (int m = 0; m < 1440; m += 17) {
+                double e = fabs(Solar_ElevationDeg(&st, (uint16_t)m, NULL) -
+                                ref_elevation(2026, mo, d, pos[p][0], pos[p][1], m));
+                max_err = fmax(max_err, e);
+            }
+        }
+    }
+    printf("  elevation: max %.3f deg\n", max_err);
+    CHECK(max_err < 0.5, "elevation error %.3f deg", max_err);
+}
+
+static void test_polar(void)
+{
+    int16_t r, s;
+
+    // 북위 75도: 하지 백야, 동지 극야
+    CHECK(!Solar_EventsUtc(172u, 75.0f, 15.0f, SOLAR_ZENITH_OFFICIAL, &r, &s), "midnight sun not detected");
+    CHECK(!Solar_EventsUtc(355u, 75.0f, 15.0f, SOLAR_ZENITH_OFFICIAL, &r, &s), "polar night not detected");
+    // 적도: 1년 내내 12시간 남짓
+    for (uint16_t doy = 1u; doy <= 366u; ++doy) {
+        bool ok = Solar_EventsUtc(doy, 0.0f, 0.0f, SOLAR_ZENITH_OFFICIAL, &r, &s);
+        CHECK(ok && (s - r) > 720 && (s - r) < 740, "equator day %u length %d", doy, s - r);
+    }
+}
+
+int main(void)
+{
+    test_events();
+    test_elevation();
+    test_polar();
+
+    return test_done("solar");
+}
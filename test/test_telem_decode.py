@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+# test_telem_decode.py
+#  tools/telem_decode.py 확인 (make가 test_telemetry 다음에 돌림)
+#  - 파서: 한 바이트씩 / 쓰레기 / CRC 깨짐 / 너무 긴 길이 / payload 안의 sync / seq 끊김
+#  - build/test_telemetry --loop (telemetry.c LOOPBACK 빌드)와 stdin/stdout으로 주고받기
+#      기본 5 Hz 스트림 값, CONFIG → ACK → 보내는 메시지/주기 바뀜, 깨진 CONFIG는 무시, 범위 밖은 잘림
+#  - CLI: --exec --config --frames --json, 캡처 파일
+import io
+import json
+import os
+import struct
+import sys
+import tempfile
+from contextlib import redirect_stderr, redirect_stdout
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'tools'))
+import telem_decode as td  # noqa: E402
+
+BRIDGE = 'build/test_telemetry --loop'
+
+fails = 0
+
+
+def check(cond, msg):
+    global fails
+    if not cond:
+        fails += 1
+        print('FAIL %s' % msg, file=sys.stderr)
+
+
+def run_cli(args):
+    out, err = io.StringIO(), io.StringIO()
+    with redirect_stdout(out), redirect_stderr(err):
+        rc = td.main(args)
+    return rc, out.getvalue(), err.getvalue()
+
+
+def fix_dt(frames):
+    """FIX 사이 간격 [s] (중복 없이)"""
+    t = [f['utc_s'] + f['ms'] / 1000.0 for ty, _, f in frames if ty == td.MSG_FIX]
+    return sorted({round(b - a, 3) for a, b in zip(t, t[1:])})
+
+
+class Bridge:
+    """test_telemetry --loop 에 붙어서 디코드한 프레임을 모음"""
+
+    def __init__(self):
+        self.link = td.Link(exec_cmd=BRIDGE)
+        self.parser = td.Parser()
+        self.raw = bytearray()
+
+    def until(self, done, limit=2000):
+        """done(frames) 가 참이 될 때까지 (또는 limit 프레임) 읽음"""
+        frames = []
+        while len(frames) < limit and not done(frames):
+            data = self.link.read()
+            if not data:
+                break
+            self.raw += data
+            frames += [(ty, seq, td.decode(ty, p)) for ty, seq, p in self.parser.feed(data)]
+        return frames
+
+    def config(self, rate, mask, corrupt=False):
+        frame = bytearray(td.config_frame(rate, mask))
+        if corrupt:
+            frame[-1] ^= 0x5A
+        self.link.write(bytes(frame))
+
+    def close(self):
+        self.link.close()
+
+
+def after_ack(frames):
+    """(ACK 내용, ACK 뒤 프레임들)"""
+    for i, (ty, _, f) in enumerate(frames):
+        if ty == td.MSG_CONFIG_ACK:
+            return f, frames[i + 1:]
+    return None, []
+
+
+# ----------------- 파서 -----------------
+def test_parser():
+    fix = struct.pack('<IHiiiBBBB', 830941200, 200, 375665000, 1269780000, 4000, 3, 9, 12, 3)
+    frames = [td.encode(td.MSG_FIX, 250 + i, fix) for i in range(10)]   # seq 255 → 0 넘김
+    stream = b''.join(frames)
+
+    p = td.Parser()
+    got = []
+    for b in stream:
+        got += p.feed(bytes([b]))
+    check(len(got) == 10 and p.seq_gaps == 0 and p.skipped == 0, 'byte-by-byte: %d frames, %d gaps, %d skipped' % (
+        len(got), p.seq_gaps, p.skipped))
+    check([s for _, s, _ in got] == [(250 + i) & 0xFF for i in range(10)], 'seq wrap')
+    f = td.decode(*got[0][::2])
+    check(f['utc_s'] == 830941200 and f['ms'] == 200 and abs(f['lat_deg'] - 37.5665) < 1e-9
+          and f['hmsl_m'] == 40.0 and f['valid'] and f['fix_ok'], 'FIX decode %s' % f)
+
+    # 쓰레기 / sync 반쪽 / CRC 깨진 프레임 / 길이가 MAX_LEN보다 큰 헤더 사이에 끼움
+    broken = bytearray(frames[1])
+    broken[10] ^= 0x01
+    toolong = td.SYNC + struct.pack('<BBH', td.MSG_FIX, 0, td.MAX_LEN + 1)
+    p = td.Parser()
+    got = p.feed(b'\x00\xa5\x13' + frames[0] + bytes(broken) + b'\xa5' + toolong + frames[2] + b'\xa5')
+    check([s for _, s, _ in got] == [250, 252], 'resync: seq %s' % [s for _, s, _ in got])
+    check(p.crc_errors == 1 and p.seq_gaps == 1, 'resync: %d CRC errors, %d gaps' % (p.crc_errors, p.seq_gaps))
+    got = p.feed(frames[3][1:])     # 앞에 남겨 둔 0xA5 와 이어짐
+    check(len(got) == 1 and got[0][1] == 253, 'sync split across reads')
+
+    # payload 안에 sync + 그럴듯한 헤더가 있어도 프레임 경계가 흔들리지 않음
+    fake = td.SYNC + struct.pack('<BBH', td.MSG_CONFIG, 7, 2) + b'\x0a\x03'
+    p = td.Parser()
+    got = p.feed(td.encode(td.MSG_PARSER, 1, fake + bytes(24 - len(fake))) + td.encode(td.MSG_ZTO100, 2, b'\0' * 5))
+    check([t for t, _, _ in got] == [td.MSG_PARSER, td.MSG_ZTO100], 'sync inside a payload')
+
+    check(td.parse_mask('fix,motion') == 0x03 and td.parse_mask('all') == 0x3F and td.parse_mask('0x30') == 0x30
+          and td.parse_mask('TRIP') == 0x04, 'parse_mask')
+    try:
+        td.decode(td.MSG_TRIP, b'\0' * 20)
+        check(False, 'short TRIP payload accepted')
+    except td.BadPayload:
+        pass
+
+
+# ----------------- LOOPBACK 대역 -----------------
+def test_bridge():
+    br = Bridge()
+    try:
+        # 기본 설정 (5 Hz, 전부): 느린 메시지 5종이 다 나올 때까지
+        frames = br.until(lambda fr: {t for t, _, _ in fr} >= set(range(td.MSG_FIX, td.MSG_ZTO100 + 1)))
+        last = {t: f for t, _, f in frames}
+        check(fix_dt(frames) == [0.2], 'default FIX interval %s' % fix_dt(frames))
+        check(len(last) == 6, 'default stream types %s' % sorted(last))
+        trip, ps, tasks, zto = (last.get(t, {}) for t in (td.MSG_TRIP, td.MSG_PARSER, td.MSG_TASKS, td.MSG_ZTO100))
+        check(trip.get('A') == {'dist_m': 12345, 'time_s': 1800, 'top_kmh': 131.4, 'avg_kmh': 24.7}, 'TRIP %s' % trip)
+        check(ps.get('rx_bytes') == 123456 and ps.get('telem_dropped') == 0, 'PARSER %s' % ps)
+        check(len(tasks.get('tasks', [])) == 3 and tasks['tasks'][1]['max_us'] == 65535 and tasks['cpu_pct'] == 3.7,
+              'TASKS %s' % tasks)
+        check(zto == {'state': 'DONE', 'time_s': 7.42, 'uncert_s': 0.03}, 'ZTO100 %s' % zto)
+        check(abs(last.get(td.MSG_MOTION, {}).get('grade_pct', 0) + 2.5) < 1e-9, 'MOTION grade')
+        fix = last.get(td.MSG_FIX, {})
+        check(abs(fix.get('lat_deg', 0) - 37.5665) < 0.1 and fix.get('fix_type') == 3, 'FIX %s' % fix)
+
+        # 10 Hz, FIX/MOTION만
+        br.config(10, td.parse_mask('fix,motion'))
+        frames = br.until(lambda fr: len(after_ack(fr)[1]) >= 40)
+        ack, rest = after_ack(frames)
+        check(ack == {'rate_hz': 10, 'mask': 0x03}, 'ACK %s' % ack)
+        check({t for t, _, _ in rest} == {td.MSG_FIX, td.MSG_MOTION}, 'after mask: %s' % {t for t, _, _ in rest})
+        check(fix_dt(rest) == [0.1], '10 Hz FIX interval %s' % fix_dt(rest))
+
+        # CRC 깨진 CONFIG → ACK 없고 그대로
+        br.config(1, td.parse_mask('trip'), corrupt=True)
+        frames = br.until(lambda fr: len(fr) >= 60)
+        check(after_ack(frames)[0] is None and fix_dt(frames) == [0.1], 'corrupt CONFIG was applied')
+
+        # 범위 밖 → 20 Hz / 있는 메시지만
+        br.config(50, 0xFF)
+        frames = br.until(lambda fr: len(after_ack(fr)[1]) >= 100)
+        ack, rest = after_ack(frames)
+        check(ack == {'rate_hz': 20, 'mask': 0x3F}, 'clamped ACK %s' % ack)
+        check(fix_dt(rest) == [0.05], '20 Hz FIX interval %s' % fix_dt(rest))
+        check(br.parser.crc_errors == 0 and br.parser.seq_gaps == 0 and br.parser.skipped == 0,
+              'bridge stream: %d CRC errors, %d gaps, %d skipped' % (
+                  br.parser.crc_errors, br.parser.seq_gaps, br.parser.skipped))
+        nframes = br.parser.frames
+    finally:
+        br.close()
+    return bytes(br.raw), nframes
+
+
+# ----------------- CLI -----------------
+def test_cli(raw, nframes):
+    rc, out, err = run_cli(['--exec', BRIDGE, '--config', '20', 'fix', '--frames', '30', '--json'])
+    msgs = [json.loads(line) for line in out.splitlines()]
+    ack = [m for m in msgs if m['type'] == 'CONFIG_ACK']
+    check(rc == 0 and ack and ack[0]['rate_hz'] == 20 and ack[0]['mask'] == 0x01, 'CLI --config: rc %d %s' % (rc, ack))
+    check(' 0 CRC errors' in err, 'CLI summary: %s' % err.strip())
+
+    try:
+        run_cli(['--config', '10', 'nosuch'])
+        check(False, 'bad --config mask accepted')
+    except SystemExit as e:
+        check(e.code == 2, 'bad --config mask: exit %s' % e.code)
+
+    # 캡처 파일: 위에서 받은 바이트 그대로
+    with tempfile.NamedTemporaryFile(suffix='.bin', delete=False) as f:
+        f.write(raw)
+    rc, out, err = run_cli([f.name])
+    os.unlink(f.name)
+    lines = out.splitlines()
+    check(rc == 0 and len(lines) == nframes, 'capture file: rc %d, %d lines, %d frames' % (rc, len(lines), nframes))
+    check(any(' FIX ' in ln and 'T09:00:' in ln for ln in lines), 'text FIX line')
+
+
+def main():
+    test_parser()
+    raw, nframes = test_bridge()
+    test_cli(raw, nframes)
+    print('  %d frames through the LOOPBACK bridge' % nframes)
+    print('telem_decode: %s' % ('FAIL (%d)' % fails if fails else 'ok'))
+    return 1 if fails else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,347 @@
+// test_telemetry.c
+//  telemetry.c (TELEMETRY_TRANSPORT_LOOPBACK) 호스트 실행
+//  - 다른 모듈은 고정값 stub (GPS fix만 합성 주행) → 메시지 값을 그대로 비교할 수 있게
+//
+//   build/test_telemetry            프레임 구조 / 이중 버퍼 / 링 꽉 참 / 명령 수신 검사
+//   build/test_telemetry --loop [s] LOOPBACK 대역: stdin 바이트 → Telemetry_OnRx,
+//                                   LOOPBACK 링 → stdout. 10 ms마다 Process (실제 시간의 약 100배)
+//                                   stdin이 닫히거나 s초(기본 600, 모의 시간)가 지나면 끝
+//       → tools/telem_decode.py --exec "build/test_telemetry --loop" 로 보드 없이 프로토콜 확인
+#include <string.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "test_util.h"
+#include "hal_shim.h"
+#include "sim_drive.h"
+#include "telemetry.h"
+#include "gps_ubx.h"
+#include "app_display.h"
+#include "trip_store.h"
+#include "sched.h"
+#include "settings_storage.h"
+#include "crc32.h"
+
+#define LOOP_TASKS  3u
+
+// ----------------- stub -----------------
+static sim_drive_t        s_drive;
+static gps_ubx_stats_t    s_ubx = { 123456u, 4567u, 3u, 1u, 2u };
+static trip_stats_t       s_trip[TRIP_COUNT] = {
+    { 12345u, 1800000u, 131.4f, 24.7f },
+    { 678u, 60000u, 55.0f, 40.7f },
+    { 987654u, 36000000u, 162.0f, 98.8f },
+};
+static sched_task_stats_t s_task[SCHED_MAX_TASKS];
+static clock_util_t       s_util = { .util_permille = 37u };
+static int32_t            s_settings[SETTINGS_KEY_COUNT];
+static uint32_t           s_settings_writes;
+
+bool APP_GPS_GetState(app_gps_state_t *out)
+{
+    SimDrive_Fix(&s_drive, out);
+    return true;
+}
+
+uint32_t APP_GPS_UtcSeconds(const app_gps_state_t *gps)
+{
+    (void)gps;
+    return (uint32_t)(s_drive.utc_ms / 1000u);
+}
+
+const gps_ubx_stats_t *GPS_UBX_GetStats(void)            { return &s_ubx; }
+const trip_stats_t *TripStore_Get(trip_id_t id)          { return &s_trip[id]; }
+const sched_task_stats_t *Sched_GetStats(uint8_t task)   { return &s_task[task]; }
+clock_profile_t ClockProfile_Get(void)                   { return CLOCK_PROFILE_MID; }
+const clock_util_t *ClockProfile_GetUtil(clock_profile_t p) { (void)p; return &s_util; }
+float APP_Display_GetGrade(void)                         { return -2.5f; }
+
+uint8_t APP_Display_GetZeroTo100(float *time_s, float *uncert_s)
+{
+    *time_s   = 7.42f;
+    *uncert_s = 0.03f;
+    return APP_DISPLAY_ZTO_DONE;
+}
+
+int32_t Settings_Get(settings_key_t key)
+{
+    return s_settings[key];
+}
+
+bool Settings_Set(settings_key_t key, int32_t value)
+{
+    s_settings[key] = value;
+    s_settings_writes++;
+    return true;
+}
+
+static void start(uint8_t rate, uint8_t mask)
+{
+    Shim_Reset();
+    Shim_SetTick(1000u);
+    // 2026-05-01 09:00:00 UTC
+    SimDrive_Start(&s_drive, 830941200u, HAL_GetTick(), 37.5665, 126.9780);
+    for (uint8_t i = 0u; i < SCHED_MAX_TASKS; ++i) {
+        s_task[i].runs     = 1000u * (i + 1u);
+        s_task[i].overruns = i;
+        s_task[i].last_us  = 50u + i;
+        s_task[i].max_us   = (i == 1u) ? 70000u : 300u + i;   // 65535 포화 확인용
+    }
+    s_settings[SETTINGS_KEY_TELEM_RATE_HZ] = rate;
+    s_settings[SETTINGS_KEY_TELEM_MASK]    = mask;
+    s_settings_writes = 0u;
+    (void)Telemetry_Init();
+
+    uint8_t junk[TELEMETRY_LOOPBACK_SIZE];
+    while (Telemetry_LoopbackRead(junk, sizeof(junk)) != 0u) {
+    }
+}
+
+static void step_10ms(void)
+{
+    SimDrive_Step(&s_drive, 10u);
+    Shim_Advance(10u);
+    Telemetry_Process(HAL_GetTick(), LOOP_TASKS);
+}
+
+// ----------------- LOOPBACK 대역 -----------------
+static int loop_bridge(uint32_t max_s)
+{
+    uint8_t buf[TELEMETRY_LOOPBACK_SIZE];
+
+    start(5u, TELEM_MASK_ALL);
+    (void)fcntl(0, F_SETFL, fcntl(0, F_GETFL) | O_NONBLOCK);
+
+    for (uint32_t t = 0u; t < max_s * 100u; ++t) {
+        ssize_t n = read(0, buf, sizeof(buf));
+        if (n == 0) {
+            break;   // 호스트가 닫음
+        }
+        if (n > 0) {
+            Telemetry_OnRx(buf, (uint32_t)n);
+        }
+        step_10ms();
+
+        uint32_t out = Telemetry_LoopbackRead(buf, sizeof(buf));
+        if (out != 0u && (fwrite(buf, 1u, out, stdout) != out || fflush(stdout) != 0)) {
+            break;
+        }
+        usleep(100u);
+    }
+    return 0;
+}
+
+// ----------------- 프레임 읽기 (검사용) -----------------
+typedef struct {
+    uint8_t  type;
+    uint8_t  seq;
+    uint16_t len;
+    uint8_t  payload[128];
+} frame_t;
+
+static uint8_t  s_rx[8192];
+static uint32_t s_rx_len;
+static uint32_t s_rx_pos;
+static uint32_t s_bad_frames;
+
+static void drain(void)
+{
+    s_rx_len += Telemetry_LoopbackRead(&s_rx[s_rx_len], sizeof(s_rx) - s_rx_len);
+}
+
+// 링에서 꺼낸 바이트는 빈틈없이 프레임이어야 함 (이중 버퍼는 버퍼 단위로만 넘어감)
+static bool next_frame(frame_t *f)
+{
+    if (s_rx_len - s_rx_pos < 8u) {
+        return false;
+    }
+    const uint8_t *p = &s_rx[s_rx_pos];
+    f->type = p[2];
+    f->seq  = p[3];
+    f->len  = (uint16_t)(p[4] | (p[5] << 8));
+    if (p[0] != 0xA5u || p[1] != 0x5Au || f->len > sizeof(f->payload) || s_rx_len - s_rx_pos < 8u + f->len) {
+        s_bad_frames++;
+        s_rx_pos = s_rx_len;
+        return false;
+    }
+    uint16_t crc = (uint16_t)(p[6 + f->len] | (p[7 + f->len] << 8));
+    if (crc != (uint16_t)Crc32_Calc(&p[2], 4u + f->len)) {
+        s_bad_frames++;
+    }
+    memcpy(f->payload, &p[6], f->len);
+    s_rx_pos += 8u + f->len;
+    return true;
+}
+
+static void rx_reset(void)
+{
+    s_rx_len = s_rx_pos = s_bad_frames = 0u;
+}
+
+static uint32_t get_u32(const uint8_t *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+static uint16_t get_u16(const uint8_t *p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+
+static void send_cmd(uint8_t type, const uint8_t *pl, uint16_t len, bool corrupt)
+{
+    uint8_t f[32];
+
+    f[0] = 0xA5u;
+    f[1] = 0x5Au;
+    f[2] = type;
+    f[3] = 0u;
+    f[4] = (uint8_t)len;
+    f[5] = (uint8_t)(len >> 8);
+    memcpy(&f[6], pl, len);
+    uint16_t crc = (uint16_t)Crc32_Calc(&f[2], 4u + len) ^ (corrupt ? 1u : 0u);
+    f[6 + len] = (uint8_t)crc;
+    f[7 + len] = (uint8_t)(crc >> 8);
+    Telemetry_OnRx(f, 8u + len);
+}
+
+// ----------------- 검사 -----------------
+// 5 Hz / 전부: 10초에 FIX/MOTION 50개씩, 느린 메시지 10개씩, seq 연속, 값 그대로
+static void test_stream(void)
+{
+    uint32_t count[8] = { 0 }, n = 0u;
+    uint8_t  prev_seq = 0u;
+    uint32_t seq_gaps = 0u, fix_ms_prev = 0u, fix_dt_bad = 0u;
+    frame_t  f;
+
+    start(5u, TELEM_MASK_ALL);
+    rx_reset();
+    for (uint32_t t = 0u; t < 1000u; ++t) {
+        step_10ms();
+        drain();
+        while (next_frame(&f)) {
+            if ((n++ != 0u) && f.seq != (uint8_t)(prev_seq + 1u)) {
+                seq_gaps++;
+            }
+            prev_seq = f.seq;
+            if (f.type < 8u) {
+                count[f.type]++;
+            }
+            if (f.type == TELEM_MSG_FIX) {
+                uint32_t ms = get_u32(f.payload) * 1000u + get_u16(&f.payload[4]);
+                if (fix_ms_prev != 0u && ms - fix_ms_prev != 200u) {
+                    fix_dt_bad++;
+                }
+                fix_ms_prev = ms;
+                CHECK(f.len == 22u && f.payload[18] == 3u && f.payload[21] == 0x03u, "FIX payload");
+            } else if (f.type == TELEM_MSG_TRIP) {
+                CHECK(f.len == 36u && get_u32(f.payload) == 12345u && get_u32(&f.payload[4]) == 1800u &&
+                      get_u16(&f.payload[8]) == 1314u && get_u32(&f.payload[24]) == 987654u, "TRIP payload");
+            } else if (f.type == TELEM_MSG_TASKS) {
+                CHECK(f.len == 1u + LOOP_TASKS * 12u + 2u && f.payload[0] == LOOP_TASKS &&
+                      get_u16(&f.payload[1 + 12 + 10]) == 0xFFFFu && get_u16(&f.payload[f.len - 2u]) == 37u,
+                      "TASKS payload");
+            } else if (f.type == TELEM_MSG_MOTION) {
+                CHECK(f.len == 11u && (int16_t)get_u16(&f.payload[5]) == -25, "MOTION payload");
+            } else if (f.type == TELEM_MSG_ZTO100) {
+                CHECK(f.len == 5u && f.payload[0] == APP_DISPLAY_ZTO_DONE && get_u16(&f.payload[1]) == 7420u &&
+                      get_u16(&f.payload[3]) == 30u, "ZTO100 payload");
+            }
+        }
+    }
+    CHECK(s_bad_frames == 0u && seq_gaps == 0u, "%u bad frames, %u seq gaps", s_bad_frames, seq_gaps);
+    CHECK(count[TELEM_MSG_FIX] == 50u && count[TELEM_MSG_MOTION] == 50u, "FIX %u MOTION %u in 10 s at 5 Hz",
+          count[TELEM_MSG_FIX], count[TELEM_MSG_MOTION]);
+    CHECK(count[TELEM_MSG_TRIP] == 10u && count[TELEM_MSG_PARSER] == 10u && count[TELEM_MSG_TASKS] == 10u &&
+          count[TELEM_MSG_ZTO100] == 10u, "slow messages %u %u %u %u", count[TELEM_MSG_TRIP],
+          count[TELEM_MSG_PARSER], count[TELEM_MSG_TASKS], count[TELEM_MSG_ZTO100]);
+    CHECK(fix_dt_bad == 0u, "%u FIX intervals not 200 ms", fix_dt_bad);
+    CHECK(Telemetry_GetStats()->dropped == 0u, "dropped frames with the host reading");
+}
+
+// 호스트가 안 읽으면: 링이 차서 BUSY → 채우는 버퍼도 차서 프레임을 버림 (seq는 안 씀).
+// 다시 읽으면 찢어진 프레임 없이 이어지고, 버린 수는 PARSER telem_dropped로 호스트에 알려짐
+static void test_backpressure(void)
+{
+    frame_t  f;
+    uint32_t frames = 0u, gaps = 0u, reported = 0u;
+    uint8_t  prev = 0u;
+
+    start(20u, TELEM_MASK_ALL);
+    rx_reset();
+    for (uint32_t t = 0u; t < 500u; ++t) {
+        step_10ms();
+    }
+    const telemetry_stats_t *st = Telemetry_GetStats();
+    uint32_t dropped = st->dropped;
+    CHECK(st->tx_busy > 0u && dropped > 0u, "ring never filled (busy %u dropped %u)", st->tx_busy, dropped);
+
+    for (uint32_t t = 0u; t < 300u; ++t) {
+        drain();
+        step_10ms();
+    }
+    drain();
+    while (next_frame(&f)) {
+        if (frames++ != 0u) {
+            gaps += (uint8_t)(f.seq - prev - 1u);
+        }
+        prev = f.seq;
+        if (f.type == TELEM_MSG_PARSER) {
+            reported = get_u32(&f.payload[20]);
+        }
+    }
+    CHECK(s_bad_frames == 0u && gaps == 0u, "%u torn frames, %u seq gaps after backpressure", s_bad_frames, gaps);
+    CHECK(st->dropped == dropped, "still dropping while the host reads");
+    CHECK(reported == dropped, "PARSER reports %u dropped, %u dropped", reported, dropped);
+    printf("  host not reading 5 s at 20 Hz: %u tx busy, %u frames dropped, stream resumes intact\n",
+           st->tx_busy, dropped);
+}
+
+// CONFIG: 쓰레기 바이트 뒤에 와도 찾고, 적용/저장/ACK. CRC 틀린 명령은 무시
+static void test_config(void)
+{
+    static const uint8_t garbage[] = { 0x00, 0xA5, 0x11, 0x5A, 0xFF };
+    uint8_t  cfg[2] = { 10u, TELEM_MASK_FIX | TELEM_MASK_MOTION };
+    frame_t  f;
+    bool     ack = false, other = false;
+
+    start(5u, TELEM_MASK_ALL);
+    rx_reset();
+    Telemetry_OnRx(garbage, sizeof(garbage));
+    send_cmd(TELEM_MSG_CONFIG, cfg, 2u, false);
+    for (uint32_t t = 0u; t < 200u; ++t) {
+        step_10ms();
+        drain();
+        while (next_frame(&f)) {
+            if (f.type == TELEM_MSG_CONFIG_ACK) {
+                ack = (f.len == 2u && f.payload[0] == cfg[0] && f.payload[1] == cfg[1]);
+            } else if (ack && f.type != TELEM_MSG_FIX && f.type != TELEM_MSG_MOTION) {
+                other = true;
+            }
+        }
+    }
+    CHECK(ack, "no CONFIG_ACK");
+    CHECK(!other, "masked-out messages after CONFIG");
+    CHECK(Telemetry_GetRate() == 10u && Telemetry_GetMask() == cfg[1], "config not applied");
+    CHECK(s_settings[SETTINGS_KEY_TELEM_RATE_HZ] == 10 && s_settings[SETTINGS_KEY_TELEM_MASK] == cfg[1],
+          "config not saved");
+    CHECK(Telemetry_GetStats()->rx_frames == 1u && Telemetry_GetStats()->rx_errors >= 3u,
+          "rx frames %u errors %u", Telemetry_GetStats()->rx_frames, Telemetry_GetStats()->rx_errors);
+
+    // CRC 틀림 → 무시, 범위 밖 → 잘라서 적용
+    cfg[0] = 3u;
+    send_cmd(TELEM_MSG_CONFIG, cfg, 2u, true);
+    step_10ms();
+    CHECK(Telemetry_GetRate() == 10u, "corrupt CONFIG applied");
+    cfg[0] = 50u;
+    cfg[1] = 0xFFu;
+    send_cmd(TELEM_MSG_CONFIG, cfg, 2u, false);
+    step_10ms();
+    CHECK(Telemetry_GetRate() == 20u && Telemetry_GetMask() == TELEM_MASK_ALL, "CONFIG not clamped (%u %02X)",
+          Telemetry_GetRate(), Telemetry_GetMask());
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1 && strcmp(argv[1], "--loop") == 0) {
+        return loop_bridge((argc > 2) ? (uint32_t)atoi(argv[2]) : 600u);
+    }
+
+    test_stream();
+    test_backpressure();
+    test_config();
+    return test_done("telemetry");
+}
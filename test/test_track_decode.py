@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+# test_track_decode.py
+#  tools/track_decode.py 를 test_track_log 가 만든 덤프로 확인 (make가 test_track_log 다음에 돌림)
+#  - 멀쩡한 덤프: 점이 펌웨어에 들어간 점과 정확히 같고 문제 0
+#  - 망가뜨린 덤프: CRC 불일치 / 쓰다 만 블록 / seq 끊김 / 블록 뒤 쓰레기를 잡고, 그 블록만 빠짐
+#  - GPX: XML로 읽히고 점 수 / 구간 수 (전원이 꺼져 있던 10분에서 나뉨)
+#  - 512KB 전체 덤프, 빈 섹터
+import csv
+import io
+import os
+import struct
+import sys
+import tempfile
+import xml.etree.ElementTree as ET
+import zlib
+from contextlib import redirect_stderr, redirect_stdout
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'tools'))
+import track_decode as td  # noqa: E402
+
+BIN = 'build/track7.bin'
+EXPECT = 'build/track7_points.csv'
+
+fails = 0
+
+
+def check(cond, msg):
+    global fails
+    if not cond:
+        fails += 1
+        print('FAIL %s' % msg, file=sys.stderr)
+
+
+def block_off(i):
+    return td.HDR_SIZE + i * td.BLOCK_SIZE
+
+
+def reseal(data, i):
+    """블록 i의 CRC를 다시 계산해서 넣음 (헤더를 고친 뒤)"""
+    off = block_off(i)
+    blen = struct.unpack_from('<H', data, off + 2)[0]
+    body = bytes(data[off:off + 12]) + b'\xff\xff\xff\xff' + bytes(data[off + 16:off + 16 + blen])
+    struct.pack_into('<I', data, off + 12, zlib.crc32(body))
+
+
+def points(blocks):
+    return [p for _, pts in blocks for p in pts]
+
+
+def run_cli(args):
+    out, err = io.StringIO(), io.StringIO()
+    with redirect_stdout(out), redirect_stderr(err):
+        rc = td.main(args)
+    return rc, out.getvalue(), err.getvalue()
+
+
+def main():
+    with open(BIN, 'rb') as f:
+        clean = f.read()
+    with open(EXPECT) as f:
+        want = [tuple(int(v) for v in row) for row in list(csv.reader(f))[1:]]
+
+    # ----------------- 멀쩡한 덤프 -----------------
+    gen, first_seq, blocks, problems = td.read_sector(clean)
+    got = points(blocks)
+    check(gen == 1 and first_seq == 0, 'header gen %d first_seq %d' % (gen, first_seq))
+    check(problems == [], 'problems in a clean dump: %s' % problems)
+    check(got == want, '%d points decoded, %d expected (first difference at %s)' % (
+        len(got), len(want), next((i for i, (a, b) in enumerate(zip(got, want)) if a != b), '-')))
+    check([s for s, _ in blocks] == list(range(len(blocks))), 'seq not 0..n-1')
+    nblocks = len(blocks)
+    per_block = [len(pts) for _, pts in blocks]
+
+    # raw CSV 출력 = 기대값 파일 (seq 열만 더 있음)
+    rc, out, _ = run_cli([BIN, '-f', 'raw', '--strict'])
+    rows = [tuple(int(v) for v in r[1:]) for r in list(csv.reader(io.StringIO(out)))[1:]]
+    check(rc == 0 and rows == want, 'raw CSV differs (rc %d, %d rows)' % (rc, len(rows)))
+
+    rc, out, _ = run_cli([BIN])
+    rows = list(csv.reader(io.StringIO(out)))
+    check(rc == 0 and len(rows) == len(want) + 1, 'CSV has %d rows' % len(rows))
+    check(rows[1][1].startswith('2026-05-01T09:00:0'), 'first CSV time %s' % rows[1][1])
+
+    # GPX: 전원이 꺼져 있던 10분 + 정차(점 하나 찍고 쉼)로 생긴 빈 시간에서 구간이 나뉨
+    with tempfile.TemporaryDirectory() as tmp:
+        gpx = os.path.join(tmp, 'a.gpx')
+        rc, _, _ = run_cli([BIN, '-f', 'gpx', '-o', gpx])
+        ns = {'g': 'http://www.topografix.com/GPX/1/1'}
+        root = ET.parse(gpx).getroot()
+    segs = root.findall('g:trk/g:trkseg', ns)
+    t = [u + ms / 1000.0 for u, ms, *_ in want]
+    want_segs = 1 + sum(1 for a, b in zip(t, t[1:]) if b - a > td.TRKSEG_GAP_S)
+    check(rc == 0 and len(segs) == want_segs, '%d GPX segments, expected %d' % (len(segs), want_segs))
+    check(sum(len(s.findall('g:trkpt', ns)) for s in segs) == len(want), 'GPX point count')
+    check(want_segs >= 2, 'power-off gap did not split the track')
+
+    # ----------------- 망가뜨린 덤프 -----------------
+    # payload 한 바이트 → 그 블록만 빠지고 CRC 문제 하나
+    bad = bytearray(clean)
+    bad[block_off(3) + 20] ^= 0x01
+    _, _, blocks, problems = td.read_sector(bytes(bad))
+    check(len(problems) == 1 and 'CRC' in problems[0], 'flipped byte: %s' % problems)
+    check(len(points(blocks)) == len(want) - per_block[3], 'flipped byte: block 3 not dropped alone')
+    with tempfile.NamedTemporaryFile(suffix='.bin', delete=False) as f:
+        f.write(bad)
+    rc, _, err = run_cli([f.name, '--strict'])
+    os.unlink(f.name)
+    check(rc == 1 and 'CRC' in err, '--strict did not fail on a CRC error (rc %d)' % rc)
+
+    # 마지막 블록 crc가 빈칸 → 쓰다 만 블록 (전원이 쓰는 도중에 나감)
+    bad = bytearray(clean)
+    bad[block_off(nblocks - 1) + 12:block_off(nblocks - 1) + 16] = b'\xff' * 4
+    _, _, blocks, problems = td.read_sector(bytes(bad))
+    check(len(problems) == 1 and 'incomplete' in problems[0], 'torn block: %s' % problems)
+    check(len(blocks) == nblocks - 1, 'torn block: %d blocks left' % len(blocks))
+
+    # seq 건너뜀 (CRC는 맞게) → 끊김으로 보고, 점은 그대로
+    bad = bytearray(clean)
+    struct.pack_into('<I', bad, block_off(5) + 4, 5 + 10)
+    reseal(bad, 5)
+    _, _, blocks, problems = td.read_sector(bytes(bad))
+    check(any('seq gap' in p and 'seq 15' in p for p in problems), 'seq jump not reported: %s' % problems)
+    check(points(blocks) == want, 'seq jump changed the points')
+
+    # 블록이 통째로 빠진 것처럼 (앞으로 당김): 이후 seq가 하나씩 밀림
+    bad = bytearray(clean)
+    tail = bad[block_off(7):block_off(nblocks)]
+    bad[block_off(6):block_off(nblocks)] = tail + b'\xff' * td.BLOCK_SIZE
+    _, _, blocks, problems = td.read_sector(bytes(bad))
+    check(len(problems) == 1 and 'expected 6' in problems[0], 'missing block: %s' % problems)
+
+    # 빈 블록 뒤에 쓰인 블록 (쓰기 순서가 깨짐)
+    bad = bytearray(clean)
+    off = block_off(nblocks + 3)
+    bad[off:off + 4] = b'\x00\x00\x00\x00'
+    _, _, _, problems = td.read_sector(bytes(bad))
+    check(any('after the first blank' in p for p in problems), 'data after blank: %s' % problems)
+
+    # 레코드 수를 하나 늘림 (CRC는 맞게) → 블록 해석 실패로 빠짐
+    bad = bytearray(clean)
+    bad[block_off(2) + 8] += 1
+    reseal(bad, 2)
+    _, _, blocks, problems = td.read_sector(bytes(bad))
+    check(len(problems) == 1 and 'block 2' in problems[0], 'bad count: %s' % problems)
+    check(len(points(blocks)) == len(want) - per_block[2], 'bad count: block 2 not dropped')
+
+    # ----------------- 덤프 모양 -----------------
+    full = bytearray(b'\xff' * td.FLASH_SIZE)
+    full[td.SECTOR_OFFSET:td.SECTOR_OFFSET + td.SECTOR_SIZE] = clean
+    _, _, blocks, problems = td.read_sector(bytes(full))
+    check(points(blocks) == want and problems == [], '512KB whole-flash dump')
+
+    gen, _, blocks, problems = td.read_sector(b'\xff' * td.SECTOR_SIZE)
+    check(gen == 0 and blocks == [] and problems == [], 'blank sector')
+
+    rc, _, err = run_cli([os.devnull])
+    check(rc == 2 and 'error' in err, 'empty file accepted')
+
+    print('  %d points in %d blocks decoded, %d GPX segments' % (len(want), nblocks, want_segs))
+    print('track_decode: %s' % ('FAIL (%d)' % fails if fails else 'ok'))
+    return 1 if fails else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
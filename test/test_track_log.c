@@ -0,0 +1,172 @@
+// test_track_log.c
+//  track_log.c 를 합성 주행으로 돌려서 Sector 7 덤프를 만들고 블록 구조를 확인
+//  - 솎아내기 결과(블록에 들어간 점)를 가로채서 기대값으로 같이 저장
+//      build/track7.bin         : 0x08060000부터 128KB (ST-Link 덤프와 같은 모양)
+//      build/track7_points.csv  : 들어간 점 (플래시 단위 정수, track_decode.py -f raw 와 같은 열)
+//    → test_track_decode.py 가 tools/track_decode.py 로 읽어서 비교
+//  - 중간에 전원 저하(FlushFromISR) → 재부팅(TrackLog_Init) → 10분 뒤 다시 주행
+#include <string.h>
+#include "test_util.h"
+#include "hal_shim.h"
+#include "sim_drive.h"
+
+// 블록에 들어가는 점 = 솎아내기가 내놓은 점
+#define TrackSimplify_Push   test_simplify_push
+#define TrackSimplify_Flush  test_simplify_flush
+#include "track_log.c"
+#undef TrackSimplify_Push
+#undef TrackSimplify_Flush
+
+uint8_t TrackSimplify_Push(const track_point_t *pt, bool force, track_point_t out[2]);
+uint8_t TrackSimplify_Flush(track_point_t *out);
+
+// erase 구간 표시는 호스트에서 의미 없음 (power_fail.c 안 씀)
+void PowerFail_EraseBegin(void) { }
+void PowerFail_EraseEnd(void) { }
+
+#define MAX_POINTS  8192u
+
+static track_point_t s_kept[MAX_POINTS];
+static uint32_t      s_nkept;
+static uint32_t      s_ncand;
+
+static void keep(const track_point_t *pt, uint8_t n)
+{
+    for (uint8_t i = 0u; i < n; ++i) {
+        if (s_nkept < MAX_POINTS) {
+            s_kept[s_nkept] = pt[i];
+        }
+        s_nkept++;
+    }
+}
+
+uint8_t test_simplify_push(const track_point_t *pt, bool force, track_point_t out[2])
+{
+    uint8_t n = TrackSimplify_Push(pt, force, out);
+    s_ncand++;
+    keep(out, n);
+    return n;
+}
+
+uint8_t test_simplify_flush(track_point_t *out)
+{
+    uint8_t n = TrackSimplify_Flush(out);
+    keep(out, n);
+    return n;
+}
+
+// ----------------- 주행 -----------------
+static sim_drive_t s_drive;
+
+// 1 Hz fix + 10 ms마다 TrackLog_Process (Task_Power 주기)
+static void drive(uint32_t seconds)
+{
+    for (uint32_t i = 0u; i < seconds; ++i) {
+        app_gps_state_t gps;
+
+        for (uint32_t k = 0u; k < 100u; ++k) {
+            SimDrive_Step(&s_drive, 10u);
+            Shim_Advance(10u);
+            TrackLog_Process(false);
+        }
+        SimDrive_Fix(&s_drive, &gps);
+        TrackLog_OnFix(&gps);
+    }
+}
+
+// 주차: 남은 점 닫고 다 쓸 때까지
+static void park(void)
+{
+    TrackLog_Flush();
+    for (uint32_t i = 0u; i < 100u && s_pending; ++i) {
+        Shim_Advance(10u);
+        TrackLog_Process(true);
+    }
+}
+
+// ----------------- 검사 -----------------
+// 펌웨어 쪽 규칙 그대로: 쓰인 블록은 앞에서부터 빈틈없이, seq = first_seq + 번호, CRC 일치
+static uint32_t check_blocks(void)
+{
+    const track_sector_hdr_t *h = (const track_sector_hdr_t *)TRACK_SECTOR_BASE;
+    uint32_t n = 0u, records = 0u;
+
+    CHECK(h->magic == TRACK_MAGIC && h->gen_inv == ~h->gen, "sector header");
+    for (; n < TRACK_BLOCK_COUNT; ++n) {
+        const track_block_t *b = (const track_block_t *)track_block_addr(n);
+        if (track_addr_blank(track_block_addr(n))) {
+            break;
+        }
+        track_block_t copy = *b;
+        copy.hdr.crc = 0xFFFFFFFFu;
+        CHECK(Crc32_Calc(&copy, sizeof(copy.hdr) + copy.hdr.len) == b->hdr.crc, "block %u CRC", n);
+        CHECK(b->hdr.seq == h->first_seq + n, "block %u seq %u", n, b->hdr.seq);
+        CHECK(b->hdr.len <= TRACK_PAYLOAD_MAX && b->hdr.count != 0u, "block %u len %u count %u",
+              n, b->hdr.len, b->hdr.count);
+        records += b->hdr.count;
+    }
+    for (uint32_t i = n; i < TRACK_BLOCK_COUNT; ++i) {
+        CHECK(track_addr_blank(track_block_addr(i)), "block %u written after the first blank", i);
+    }
+    CHECK(records == s_nkept, "%u records in flash, %u points kept", records, s_nkept);
+    return n;
+}
+
+static void save(const char *bin, const char *csv)
+{
+    FILE *f = fopen(bin, "wb");
+    CHECK(f != NULL, "cannot write %s", bin);
+    if (f != NULL) {
+        fwrite(Shim_FlashPtr(TRACK_SECTOR_BASE), 1u, TRACK_SECTOR_SIZE, f);
+        fclose(f);
+    }
+
+    f = fopen(csv, "w");
+    CHECK(f != NULL, "cannot write %s", csv);
+    if (f != NULL) {
+        fprintf(f, "utc_s,ms,lat,lon,alt_dm,speed_cms,heading_ddeg\n");
+        for (uint32_t i = 0u; i < s_nkept && i < MAX_POINTS; ++i) {
+            const track_point_t *p = &s_kept[i];
+            fprintf(f, "%u,%u,%d,%d,%d,%d,%d\n", p->utc_s, p->ms, p->lat, p->lon, p->alt_dm,
+                    p->speed_cms, p->heading);
+        }
+        fclose(f);
+    }
+}
+
+int main(void)
+{
+    Shim_FlashInit();
+    Shim_Reset();
+    Shim_SetTick(1000u);
+
+    // 2026-05-01 09:00:00 UTC, 서울
+    SimDrive_Start(&s_drive, 830941200u, HAL_GetTick(), 37.5665, 126.9780);
+    TrackLog_Init();
+    CHECK(s_state == TRACK_STATE_READY && s_stats.gen == 1u, "blank sector not claimed");
+
+    drive(3600u);
+    uint32_t written = s_stats.blocks_written;
+
+    // 전원 저하: 쓰던 블록 + 채우던 블록을 ISR에서 마저 → 재부팅
+    TrackLog_FlushFromISR();
+    CHECK(!s_pending && s_block[s_fill].hdr.count == 0u, "last gasp left points in RAM");
+    uint32_t blocks = s_next_block;
+    TrackLog_Init();
+    CHECK(s_next_block == blocks && s_seq == blocks, "resume at block %u seq %u, expected %u",
+          s_next_block, s_seq, blocks);
+
+    s_drive.utc_ms  += 600000u;
+    s_drive.host_ms  = HAL_GetTick();
+    drive(3600u);
+    park();
+
+    uint32_t n = check_blocks();
+    printf("  2 h drive: %u fixes -> %u points (%.1fx), %u blocks (%u before the power cut), %u B\n",
+           s_ncand, s_nkept, (double)s_ncand / s_nkept, n, written, s_stats.used_bytes);
+    CHECK(s_stats.blocks_dropped == 0u, "%u blocks dropped", s_stats.blocks_dropped);
+    CHECK(s_nkept <= MAX_POINTS, "too many points for the test buffer");
+
+    save("build/track7.bin", "build/track7_points.csv");
+    return test_done("track_log");
+}
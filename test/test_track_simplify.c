@@ -0,0 +1,247 @@
+// test_track_simplify.c
+//  track_simplify.c 압축률 / 모양 오차를 주행 기록으로 측정
+//  - 기본: sim_drive.h 합성 주행 4개 (시드별 1시간, 1 Hz, 위치 잡음 ±0.6 m)
+//  - 인자로 CSV를 주면 그 기록으로 (열: utc_s,ms,lat,lon,alt_dm,speed_cms,heading_ddeg, 첫 줄은 머리글)
+//      → 솎아내기 없이 1 Hz로 남긴 기록. track_decode.py -f raw 의 seq 열만 뺀 모양
+//  - 후보 점은 TrackLog_OnFix와 같은 규칙 (3 km/h 아래로 내려가면 한 번 강제로 찍고 쉼)
+//  - 확인
+//      후보 점 → 남긴 선분까지 거리 ≤ TRACK_SIMPLIFY_TOL_M (솎아내기가 보장하는 값)
+//      참값(잡음 없는 위치) → 남긴 선분 ≤ 허용치 + 잡음
+//      남긴 점 사이 ≤ TRACK_SIMPLIFY_MAX_GAP_S (정차로 후보가 끊긴 구간 빼고)
+//      처음 / 정차 / 마지막 점은 남음, 전체 압축률 5배 이상
+#include <math.h>
+#include <string.h>
+#include "test_util.h"
+#include "sim_drive.h"
+#include "track_simplify.h"
+#include "track_log.h"
+
+#define MAX_FIXES   8192u
+#define DRIVE_S     3600u
+
+typedef struct {
+    track_point_t pt;
+    double        true_lat, true_lon;   // 참값 (기록이면 NAN)
+    bool          force;                // 정차 지점
+    bool          kept;
+} cand_t;
+
+typedef struct {
+    uint32_t fixes, cands, kept;
+    double   max_err_m;      // 후보 → 선분
+    double   max_true_m;     // 참값 → 선분
+    uint32_t max_gap_s;
+} result_t;
+
+static cand_t s_cand[MAX_FIXES];
+static uint32_t s_ncand;
+static uint32_t s_nfix;
+static bool     s_was_moving;
+
+// ----------------- 후보 점 -----------------
+static void add_fix(const track_point_t *pt, double true_lat, double true_lon)
+{
+    bool moving = (pt->speed_cms * 0.036 >= TRACK_LOG_MOVE_KMH);
+
+    s_nfix++;
+    if (!moving && !s_was_moving) {
+        return;
+    }
+    if (s_ncand >= MAX_FIXES) {
+        return;
+    }
+    cand_t *c   = &s_cand[s_ncand++];
+    c->pt       = *pt;
+    c->true_lat = true_lat;
+    c->true_lon = true_lon;
+    c->force    = (!moving && s_was_moving);
+    c->kept     = false;
+    s_was_moving = moving;
+}
+
+static int32_t iround(double v)
+{
+    return (int32_t)lround(v);
+}
+
+static void sim_fixes(uint32_t seed)
+{
+    sim_drive_t d;
+
+    g_test_rng = seed;
+    SimDrive_Start(&d, 830941200u, 0u, 37.5665, 126.9780);
+    for (uint32_t i = 0u; i < DRIVE_S; ++i) {
+        app_gps_state_t g;
+        track_point_t   pt;
+
+        for (uint32_t k = 0u; k < 10u; ++k) {
+            SimDrive_Step(&d, 100u);
+        }
+        SimDrive_Fix(&d, &g);
+        pt.utc_s     = (uint32_t)(d.utc_ms / 1000u);
+        pt.ms        = (uint32_t)(d.utc_ms % 1000u);
+        pt.lat       = iround(g.lat_deg * 1e7);
+        pt.lon       = iround(g.lon_deg * 1e7);
+        pt.alt_dm    = iround(g.hmsl_m * 10.0);
+        pt.speed_cms = iround(g.speed_mps * 100.0);
+        pt.heading   = iround(g.heading_deg * 10.0) % 3600;
+        add_fix(&pt, d.lat, d.lon);
+    }
+}
+
+static bool csv_fixes(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char  line[256];
+
+    if (f == NULL) {
+        return false;
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        track_point_t pt;
+        if (sscanf(line, "%u,%u,%d,%d,%d,%d,%d", &pt.utc_s, &pt.ms, &pt.lat, &pt.lon, &pt.alt_dm,
+                   &pt.speed_cms, &pt.heading) == 7) {
+            add_fix(&pt, NAN, NAN);
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+// ----------------- 솎아내기 -----------------
+// 내놓은 점을 후보 목록에서 표시 (시간 순서대로 나오므로 앞에서부터 찾음)
+static void mark(const track_point_t *out, uint8_t n, uint32_t *next)
+{
+    for (uint8_t i = 0u; i < n; ++i) {
+        while (*next < s_ncand && memcmp(&s_cand[*next].pt, &out[i], sizeof(out[i])) != 0) {
+            (*next)++;
+        }
+        CHECK(*next < s_ncand, "kept point %u.%03u is not a candidate", out[i].utc_s, out[i].ms);
+        if (*next < s_ncand) {
+            s_cand[(*next)++].kept = true;
+        }
+    }
+}
+
+static void simplify(void)
+{
+    track_point_t out[2];
+    uint32_t      next = 0u;
+
+    TrackSimplify_Reset();
+    for (uint32_t i = 0u; i < s_ncand; ++i) {
+        mark(out, TrackSimplify_Push(&s_cand[i].pt, s_cand[i].force, out), &next);
+    }
+    mark(out, TrackSimplify_Flush(out), &next);
+}
+
+// ----------------- 측정 -----------------
+// 점 (lat, lon) → a-b 선분 [m], a 위도에서 평면 근사
+static double seg_dist(double lat, double lon, const track_point_t *a, const track_point_t *b)
+{
+    double kx = SIM_M_PER_DEG_LAT * cos(a->lat * 1e-7 * M_PI / 180.0);
+    double x  = (lon - a->lon * 1e-7) * kx, y = (lat - a->lat * 1e-7) * SIM_M_PER_DEG_LAT;
+    double px = (b->lon - a->lon) * 1e-7 * kx, py = (b->lat - a->lat) * 1e-7 * SIM_M_PER_DEG_LAT;
+    double l2 = px * px + py * py;
+    double t  = (l2 > 0.0) ? fmax(0.0, fmin(1.0, (x * px + y * py) / l2)) : 0.0;
+
+    return hypot(x - t * px, y - t * py);
+}
+
+static result_t measure(void)
+{
+    result_t r = { .fixes = s_nfix, .cands = s_ncand };
+    uint32_t prev = 0u;
+
+    CHECK(s_ncand > 0u && s_cand[0].kept && s_cand[s_ncand - 1u].kept, "first/last point not kept");
+    for (uint32_t i = 0u; i < s_ncand; ++i) {
+        if (s_cand[i].force) {
+            CHECK(s_cand[i].kept, "stop at %u not kept", s_cand[i].pt.utc_s);
+        }
+        if (!s_cand[i].kept) {
+            continue;
+        }
+        r.kept++;
+        if (i == 0u) {
+            continue;
+        }
+        // prev ~ i 사이 후보는 선분 prev-i 로 대신함
+        const track_point_t *a = &s_cand[prev].pt, *b = &s_cand[i].pt;
+        bool contiguous = true;
+        for (uint32_t k = prev; k <= i; ++k) {
+            const cand_t *c = &s_cand[k];
+            r.max_err_m = fmax(r.max_err_m, seg_dist(c->pt.lat * 1e-7, c->pt.lon * 1e-7, a, b));
+            if (!isnan(c->true_lat)) {
+                r.max_true_m = fmax(r.max_true_m, seg_dist(c->true_lat, c->true_lon, a, b));
+            }
+            if (k > prev && c->pt.utc_s - s_cand[k - 1u].pt.utc_s > 1u) {
+                contiguous = false;    // 정차로 후보가 끊김
+            }
+        }
+        if (contiguous && b->utc_s - a->utc_s > r.max_gap_s) {
+            r.max_gap_s = b->utc_s - a->utc_s;
+        }
+        prev = i;
+    }
+    return r;
+}
+
+static result_t run(const char *name, double noise_m)
+{
+    simplify();
+    result_t r = measure();
+
+    printf("  %-22s %5u fixes %5u cand -> %4u kept (%5.1fx)  max err %.2f m", name, r.fixes, r.cands, r.kept,
+           (double)r.cands / r.kept, r.max_err_m);
+    if (noise_m > 0.0) {
+        printf(" (true %.2f m)", r.max_true_m);
+    }
+    printf("  max gap %u s\n", r.max_gap_s);
+
+    // 좌표 1e-7 deg 반올림 + float 계산 여유
+    CHECK(r.max_err_m <= TRACK_SIMPLIFY_TOL_M + 0.05, "%s: %.2f m off the kept track", name, r.max_err_m);
+    CHECK(r.max_true_m <= TRACK_SIMPLIFY_TOL_M + noise_m + 0.05, "%s: true track %.2f m off", name, r.max_true_m);
+    CHECK(r.max_gap_s <= TRACK_SIMPLIFY_MAX_GAP_S, "%s: %u s between kept points", name, r.max_gap_s);
+    return r;
+}
+
+static void reset_fixes(void)
+{
+    s_ncand      = 0u;
+    s_nfix       = 0u;
+    s_was_moving = true;
+}
+
+int main(int argc, char **argv)
+{
+    static const uint32_t seeds[] = { 0x12345678u, 0x0BADF00Du, 0x5EED0001u, 0xC0FFEE42u };
+    uint32_t cands = 0u, kept = 0u;
+
+    if (argc > 1) {
+        for (int i = 1; i < argc; ++i) {
+            reset_fixes();
+            CHECK(csv_fixes(argv[i]), "cannot read %s", argv[i]);
+            if (s_ncand > 0u) {
+                result_t r = run(argv[i], 0.0);
+                cands += r.cands;
+                kept  += r.kept;
+            }
+        }
+    } else {
+        for (uint32_t i = 0u; i < sizeof(seeds) / sizeof(seeds[0]); ++i) {
+            char name[32];
+            reset_fixes();
+            sim_fixes(seeds[i]);
+            snprintf(name, sizeof(name), "1 h drive %08X", seeds[i]);
+            // 잡음은 북/동 각각 ±0.6 m → 최대 0.85 m
+            result_t r = run(name, 0.6 * M_SQRT2);
+            cands += r.cands;
+            kept  += r.kept;
+        }
+        CHECK(kept != 0u && cands >= 5u * kept, "compression %u -> %u below 5x", cands, kept);
+    }
+    if (kept != 0u) {
+        printf("  total %u -> %u (%.1fx)\n", cands, kept, (double)cands / kept);
+    }
+    return test_done("track_simplify");
+}
@@ -0,0 +1,64 @@
+/*
+ * test_util.h (호스트 테스트 공통)
+ *
+ *  - CHECK: 실패해도 계속 돌고 개수만 셈 (마지막에 test_done이 종료 코드로)
+ *  - test_now_ns: 벤치마크용 단조 시계
+ */
+#ifndef TEST_UTIL_H_
+#define TEST_UTIL_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+static int g_test_fail = 0;
+
+#define CHECK(cond, ...)                                                  \
+    do {                                                                  \
+        if (!(cond)) {                                                    \
+            if (g_test_fail < 20) {                                       \
+                fprintf(stderr, "FAIL %s:%d: ", __FILE__, __LINE__);      \
+                fprintf(stderr, __VA_ARGS__);                             \
+                fputc('\n', stderr);                                      \
+            }                                                             \
+            g_test_fail++;                                                \
+        }                                                                 \
+    } while (0)
+
+static inline int test_done(const char *name)
+{
+    if (g_test_fail != 0) {
+        printf("%s: FAIL (%d)\n", name, g_test_fail);
+        return 1;
+    }
+    printf("%s: ok\n", name);
+    return 0;
+}
+
+static inline uint64_t test_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+// 재현 가능한 난수 (xorshift32)
+static uint32_t g_test_rng = 0x12345678u;
+
+static inline uint32_t test_rand(void)
+{
+    uint32_t x = g_test_rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    g_test_rng = x;
+    return x;
+}
+
+// [0, 1)
+static inline double test_randf(void)
+{
+    return (double)(test_rand() >> 8) / 16777216.0;
+}
+
+#endif /* TEST_UTIL_H_ */
@@ -0,0 +1,262 @@
+// test_zto100.c
+//  0-100 km/h 측정 반복성: 같은 출발을 epoch 위상 / 수신 지연 / 속도 잡음만 바꿔서 여러 번 재생
+//  - app_display.c 를 그대로 포함해서 update_zero_to_100_state / zero_to_100_countdown_done 을 직접 부름
+//  - 출발 기록 3개 (가속 곡선이 다른 차): 정지 → 반응 시간 뒤 출발, 0.3 s 동안 가속도가 올라감
+//  - 2 Hz NAV-PVT: 위상 0~500 ms 무작위, Doppler 잡음 0.05 m/s (sAcc 0.12), 호스트 수신 지연 50~150 ms,
+//    iTOW는 주 경계를 지나가게
+//  - 예전 방식(GO! 틱 → 100 이상 첫 fix의 호스트 시각)과 비교: 같은 출발이면 흩어짐만 보면 됨
+//  - 참값: 1.5 km/h를 지난 순간 → 100 km/h를 지난 순간
+#include <math.h>
+#include <string.h>
+#include "test_util.h"
+#include "hal_shim.h"
+
+#include "app_display.c"
+#include "settings_storage.h"
+
+// trip_store.c 가 쓰는 설정 (여기서는 값만 들고 있음)
+static int32_t s_settings[SETTINGS_KEY_COUNT];
+
+int32_t Settings_Get(settings_key_t key)
+{
+    return s_settings[key];
+}
+
+bool Settings_Set(settings_key_t key, int32_t value)
+{
+    s_settings[key] = value;
+    return true;
+}
+
+#define EPOCH_MS     500u
+#define RUNS         500u
+#define GO_MS        10000u      // GO! 호스트 시각
+#define REACT_S      0.6         // GO! 뒤 출발까지 (기록마다 같음)
+
+typedef struct {
+    const char *name;
+    double      vmax_mps;
+    double      tau_s;
+} launch_t;
+
+// 출발 후 t [s] 속도: 0.3 s 동안 가속도가 0에서 올라가고 그 뒤 v = vmax (1 - exp(-t/tau))
+static double launch_speed(const launch_t *l, double t)
+{
+    if (t <= 0.0) {
+        return 0.0;
+    }
+    double tt = (t < 0.3) ? (t * t / 0.6) : (t - 0.15);
+    return l->vmax_mps * (1.0 - exp(-tt / l->tau_s));
+}
+
+static double launch_cross(const launch_t *l, double kmh)
+{
+    double lo = 0.0, hi = 120.0;
+    for (int i = 0; i < 80; ++i) {
+        double m = 0.5 * (lo + hi);
+        if (launch_speed(l, m) * 3.6 < kmh) {
+            lo = m;
+        } else {
+            hi = m;
+        }
+    }
+    return lo;
+}
+
+static double gauss(void)
+{
+    double u = test_randf() + 1e-12, v = test_randf();
+    return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+// ----------------- 재생 -----------------
+typedef struct {
+    double old_s;      // 예전 방식
+    double new_s;
+    double uncert_s;
+} replay_t;
+
+static void feed(uint32_t host_ms, uint32_t tow_ms, double v_mps)
+{
+    app_gps_state_t g;
+
+    memset(&g, 0, sizeof(g));
+    g.valid         = true;
+    g.fixOk         = true;
+    g.fixType       = 3u;
+    g.speed_mps     = (float)v_mps;
+    g.speed_acc_mps = 0.12f;
+    g.tow_ms        = tow_ms;
+    g.host_time_ms  = host_ms;
+    Shim_SetTick(host_ms);
+    update_zero_to_100_state(&g);
+}
+
+static bool replay(const launch_t *l, replay_t *r)
+{
+    double   phase_s = test_randf() * (EPOCH_MS / 1000.0);
+    uint32_t tow0    = GPS_WEEK_MS - 4000u;     // 출발 직전에 주가 바뀜
+    bool     go      = false;
+
+    memset(&s_disp, 0, sizeof(s_disp));
+    r->old_s = -1.0;
+
+    // GO! 3초 전(카운트다운)부터 epoch
+    for (uint32_t e = 0u; e < 80u && !s_disp.zto100_done; ++e) {
+        double   t_s  = -3.0 + phase_s + e * (EPOCH_MS / 1000.0);        // GO! 기준 epoch 시각
+        double   v    = fmax(0.0, launch_speed(l, t_s - REACT_S) + 0.05 * gauss());
+        uint32_t host = GO_MS + (uint32_t)lround((t_s + 0.05 + 0.1 * test_randf()) * 1000.0);
+        uint32_t tow  = (tow0 + (uint32_t)lround((t_s + 3.0) * 1000.0)) % GPS_WEEK_MS;
+
+        if (!go && host >= GO_MS) {
+            go = true;
+            Shim_SetTick(GO_MS);
+            zero_to_100_countdown_done();
+        }
+        // 예전 방식: GO! 틱부터 100 이상 첫 fix를 받은 호스트 시각까지
+        if (go && r->old_s < 0.0 && v * 3.6 >= 100.0) {
+            r->old_s = (host - GO_MS) * 0.001;
+        }
+        feed(host, tow, v);
+    }
+
+    float time_s, uncert_s;
+    if (APP_Display_GetZeroTo100(&time_s, &uncert_s) != APP_DISPLAY_ZTO_DONE) {
+        return false;
+    }
+    r->new_s    = time_s;
+    r->uncert_s = uncert_s;
+    return true;
+}
+
+typedef struct {
+    double mean, sd, spread;   // spread: 최대 - 최소의 절반
+} stat_t;
+
+static stat_t stats(const double *x, uint32_t n)
+{
+    stat_t   s = { 0 };
+    double   lo = x[0], hi = x[0], sum = 0.0, sum2 = 0.0;
+
+    for (uint32_t i = 0u; i < n; ++i) {
+        sum  += x[i];
+        sum2 += x[i] * x[i];
+        lo = fmin(lo, x[i]);
+        hi = fmax(hi, x[i]);
+    }
+    s.mean   = sum / n;
+    s.sd     = sqrt(fmax(0.0, sum2 / n - s.mean * s.mean));
+    s.spread = 0.5 * (hi - lo);
+    return s;
+}
+
+static void test_launch(const launch_t *l)
+{
+    static double old_s[RUNS], err_s[RUNS];
+    double truth = launch_cross(l, ZTO100_END_KMH) - launch_cross(l, ZTO100_START_KMH);
+    uint32_t covered = 0u, done = 0u;
+    double   usum = 0.0;
+
+    for (uint32_t i = 0u; i < RUNS; ++i) {
+        replay_t r;
+        if (!replay(l, &r)) {
+            continue;
+        }
+        usum       += r.uncert_s;
+        old_s[done] = r.old_s;
+        err_s[done] = r.new_s - truth;
+        if (fabs(err_s[done]) <= 2.0 * r.uncert_s) {
+            covered++;
+        }
+        done++;
+    }
+    CHECK(done == RUNS, "%s: %u of %u runs finished", l->name, done, RUNS);
+    if (done == 0u) {
+        return;
+    }
+
+    stat_t so = stats(old_s, done), sn = stats(err_s, done);
+    printf("  %-10s %5.2f s  old: sd %.3f, +/-%.2f s   new: sd %.3f, +/-%.2f s, bias %+.3f s, "
+           "u %.3f s, |err| <= 2u in %u/%u\n", l->name, truth, so.sd, so.spread, sn.sd, sn.spread, sn.mean,
+           usum / done, covered, done);
+
+    CHECK(so.sd > 0.1, "%s: old method sd %.3f s (replay not varying?)", l->name, so.sd);
+    CHECK(sn.sd <= 0.05, "%s: sd %.3f s", l->name, sn.sd);
+    CHECK(sn.spread <= 0.15, "%s: spread +/-%.3f s", l->name, sn.spread);
+    // 출발 위상에 따른 치우침 (출발 구간 평균 가속도로 보간하면 +0.05~0.07 s)
+    CHECK(fabs(sn.mean) <= 0.02, "%s: bias %+.3f s", l->name, sn.mean);
+    CHECK(covered >= done * 9u / 10u, "%s: error within 2 u in %u/%u", l->name, covered, done);
+}
+
+// ----------------- 경계 -----------------
+// 100 전에 다시 섰다가 출발 → 두 번째 출발부터 잼
+static void test_restart(void)
+{
+    static const launch_t l = { "restart", 60.0, 11.3 };
+    uint32_t tow = 100000u, host = GO_MS;
+
+    memset(&s_disp, 0, sizeof(s_disp));
+    feed(host, tow, 0.0);
+    zero_to_100_countdown_done();
+    for (uint32_t e = 1u; e <= 6u; ++e) {           // 3 s 가다가
+        feed(host + e * EPOCH_MS, tow + e * EPOCH_MS, launch_speed(&l, e * 0.5 - 0.25));
+    }
+    CHECK(s_disp.zto100_launched, "first launch not seen");
+    feed(host + 7u * EPOCH_MS, tow + 7u * EPOCH_MS, 0.0);   // 섬
+    CHECK(!s_disp.zto100_launched && !s_disp.zto100_done, "stop before 100 not reset");
+
+    for (uint32_t e = 8u; e < 80u && !s_disp.zto100_done; ++e) {
+        feed(host + e * EPOCH_MS, tow + e * EPOCH_MS, launch_speed(&l, (e - 8u) * 0.5 - 0.25));
+    }
+    float t, u;
+    double truth = launch_cross(&l, ZTO100_END_KMH) - launch_cross(&l, ZTO100_START_KMH);
+    CHECK(APP_Display_GetZeroTo100(&t, &u) == APP_DISPLAY_ZTO_DONE && fabs(t - truth) < 0.15,
+          "restart: %.3f s, expected %.3f s", t, truth);
+}
+
+// 100을 지나는 epoch 하나가 빠짐 (1 s 간격) → 그래도 보간, 불확도는 커짐
+static void test_missing_epoch(void)
+{
+    static const launch_t l = { "gap", 60.0, 11.3 };
+    double truth = launch_cross(&l, ZTO100_END_KMH) - launch_cross(&l, ZTO100_START_KMH);
+    double t100  = launch_cross(&l, ZTO100_END_KMH);
+    uint32_t tow = 200000u, host = GO_MS;
+    float  t, u, u_full = 0.0f;
+
+    for (int pass = 0; pass < 2; ++pass) {
+        memset(&s_disp, 0, sizeof(s_disp));
+        feed(host, tow, 0.0);
+        zero_to_100_countdown_done();
+        for (uint32_t e = 1u; e < 80u && !s_disp.zto100_done; ++e) {
+            double te = e * 0.5 - 0.2;
+            // 두 번째는 100을 지나는 epoch를 건너뜀
+            if (pass == 1 && te >= t100 && te < t100 + 0.5) {
+                continue;
+            }
+            feed(host + e * EPOCH_MS, tow + e * EPOCH_MS, launch_speed(&l, te));
+        }
+        CHECK(APP_Display_GetZeroTo100(&t, &u) == APP_DISPLAY_ZTO_DONE && fabs(t - truth) < 0.15,
+              "pass %d: %.3f s, expected %.3f s", pass, t, truth);
+        if (pass == 0) {
+            u_full = u;
+        }
+    }
+    CHECK(u > u_full, "missing epoch: uncertainty %.3f s not above %.3f s", u, u_full);
+}
+
+int main(void)
+{
+    static const launch_t launches[] = {
+        { "quick",   70.0,  9.0 },
+        { "typical", 60.0, 11.3 },
+        { "slow",    50.0, 14.0 },
+    };
+
+    Shim_Reset();
+    for (uint32_t i = 0u; i < sizeof(launches) / sizeof(launches[0]); ++i) {
+        test_launch(&launches[i]);
+    }
+    test_restart();
+    test_missing_epoch();
+    return test_done("zto100");
+}
@@ -0,0 +1,311 @@
+#!/usr/bin/env python3
+# telem_decode.py
+#  텔레메트리 스트림 디코더 (프레임/메시지 포맷은 project codes/telemetry.h 주석 그대로)
+#  - 입력: USB CDC 포트(pyserial), 캡처 파일/stdin, 또는 LOOPBACK 대역 프로그램(--exec)
+#  - 프레임마다 sync → 길이 → CRC 확인, seq 끊김(전송 중에 빠진 프레임)을 셈
+#    (장치 송신 버퍼가 넘쳐서 버린 프레임은 seq를 안 쓰므로 PARSER의 telem_dropped로 봄)
+#  - --config RATE MASK: 시작할 때 CONFIG 프레임을 보내고 CONFIG_ACK를 기다림
+#
+#   tools/telem_decode.py --port /dev/ttyACM0                   보드 (USB_CDC 빌드)
+#   tools/telem_decode.py --port COM5 --config 10 fix,motion    10 Hz, FIX/MOTION만
+#   tools/telem_decode.py capture.bin --json                    캡처 파일 → JSON 한 줄씩
+#   tools/telem_decode.py --exec "test/build/test_telemetry --loop" --config 20 all --frames 100
+#       보드 없이: 호스트에서 돌린 telemetry.c(LOOPBACK)와 stdin/stdout으로 주고받음
+import argparse
+import datetime
+import json
+import os
+import shlex
+import struct
+import subprocess
+import sys
+import time
+import zlib
+
+SYNC = b'\xa5\x5a'
+HDR = struct.Struct('<2sBBH')    # sync type seq len
+HDR_SIZE = HDR.size
+CRC_SIZE = 2
+MAX_LEN = 512                    # TELEMETRY_BUF_SIZE: 이보다 긴 프레임은 나올 수 없음
+
+MSG_FIX, MSG_MOTION, MSG_TRIP, MSG_PARSER, MSG_TASKS, MSG_ZTO100 = 0x01, 0x02, 0x03, 0x04, 0x05, 0x06
+MSG_CONFIG, MSG_CONFIG_ACK = 0x80, 0x81
+
+MSG_NAMES = {
+    MSG_FIX: 'FIX', MSG_MOTION: 'MOTION', MSG_TRIP: 'TRIP', MSG_PARSER: 'PARSER',
+    MSG_TASKS: 'TASKS', MSG_ZTO100: 'ZTO100', MSG_CONFIG: 'CONFIG', MSG_CONFIG_ACK: 'CONFIG_ACK',
+}
+# 마스크 비트 = 1 << (type - 1)
+MASK_BITS = {name.lower(): 1 << (t - 1) for t, name in MSG_NAMES.items() if t < MSG_CONFIG}
+MASK_ALL = 0x3F
+TRIP_NAMES = ('A', 'B', 'ODO')
+EPOCH_2000 = datetime.datetime(2000, 1, 1, tzinfo=datetime.timezone.utc)
+ZTO_STATES = ('IDLE', 'ARMED', 'RUNNING', 'DONE')
+
+
+# ----------------- 프레임 -----------------
+def frame_crc(body):
+    """type ~ payload 의 CRC-32 하위 16비트"""
+    return zlib.crc32(body) & 0xFFFF
+
+
+def encode(msg_type, seq, payload=b''):
+    body = struct.pack('<BBH', msg_type, seq & 0xFF, len(payload)) + payload
+    return SYNC + body + struct.pack('<H', frame_crc(body))
+
+
+def config_frame(rate_hz, mask, seq=0):
+    return encode(MSG_CONFIG, seq, struct.pack('<BB', rate_hz, mask))
+
+
+class Parser:
+    """바이트를 넣으면 (type, seq, payload) 프레임을 돌려줌. 망가진 바이트는 건너뛰고 sync를 다시 찾음"""
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.frames = 0
+        self.crc_errors = 0
+        self.skipped = 0         # sync를 찾느라 버린 바이트
+        self.seq_gaps = 0        # 빠진 프레임 수 (seq 차이 합)
+        self.last_seq = None
+
+    def feed(self, data):
+        self.buf += data
+        out = []
+        while True:
+            i = self.buf.find(SYNC)
+            if i < 0:
+                keep = 1 if self.buf[-1:] == SYNC[:1] else 0
+                self.skipped += len(self.buf) - keep
+                del self.buf[:len(self.buf) - keep]
+                return out
+            if i > 0:
+                self.skipped += i
+                del self.buf[:i]
+            if len(self.buf) < HDR_SIZE:
+                return out
+            _, msg_type, seq, length = HDR.unpack_from(self.buf, 0)
+            if length > MAX_LEN:
+                self.skipped += 1
+                del self.buf[:1]
+                continue
+            size = HDR_SIZE + length + CRC_SIZE
+            if len(self.buf) < size:
+                return out
+            body = bytes(self.buf[2:HDR_SIZE + length])
+            crc = struct.unpack_from('<H', self.buf, HDR_SIZE + length)[0]
+            if crc != frame_crc(body):
+                # 우연히 sync처럼 보인 바이트일 수 있으니 한 바이트만 넘기고 다시 찾음
+                self.crc_errors += 1
+                self.skipped += 1
+                del self.buf[:1]
+                continue
+            del self.buf[:size]
+            if self.last_seq is not None:
+                self.seq_gaps += (seq - self.last_seq - 1) & 0xFF
+            self.last_seq = seq
+            self.frames += 1
+            out.append((msg_type, seq, body[4:]))
+
+
+# ----------------- 메시지 -----------------
+class BadPayload(Exception):
+    pass
+
+
+def _unpack(fmt, payload):
+    s = struct.Struct(fmt)
+    if len(payload) < s.size:
+        raise BadPayload('%d bytes, need %d' % (len(payload), s.size))
+    return s.unpack_from(payload, 0)
+
+
+def decode(msg_type, payload):
+    """payload → dict (단위가 붙은 값으로)"""
+    if msg_type == MSG_FIX:
+        utc_s, ms, lat, lon, hmsl_cm, fix_type, sv_used, sv_vis, flags = _unpack('<IHiiiBBBB', payload)
+        return {'utc_s': utc_s, 'ms': ms, 'lat_deg': lat / 1e7, 'lon_deg': lon / 1e7,
+                'hmsl_m': hmsl_cm / 100.0, 'fix_type': fix_type, 'sv_used': sv_used,
+                'sv_visible': sv_vis, 'valid': bool(flags & 1), 'fix_ok': bool(flags & 2)}
+    if msg_type == MSG_MOTION:
+        spd, hdg, hdg_ok, grade, raw_spd, raw_hdg = _unpack('<HHBhHH', payload)
+        return {'speed_kmh': spd * 0.036, 'heading_deg': hdg / 10.0, 'heading_valid': bool(hdg_ok),
+                'grade_pct': grade / 10.0, 'raw_speed_kmh': raw_spd * 0.036, 'raw_heading_deg': raw_hdg / 10.0}
+    if msg_type == MSG_TRIP:
+        trips = {}
+        for i, name in enumerate(TRIP_NAMES):
+            dist, secs, top, avg = _unpack('<IIHH', payload[12 * i:])
+            trips[name] = {'dist_m': dist, 'time_s': secs, 'top_kmh': top / 10.0, 'avg_kmh': avg / 10.0}
+        return trips
+    if msg_type == MSG_PARSER:
+        keys = ('rx_bytes', 'frames_ok', 'ck_errors', 'len_errors', 'uart_errors', 'telem_dropped')
+        return dict(zip(keys, _unpack('<6I', payload)))
+    if msg_type == MSG_TASKS:
+        n = _unpack('<B', payload)[0]
+        tasks = []
+        for i in range(n):
+            runs, overruns, last_us, max_us = _unpack('<IIHH', payload[1 + 12 * i:])
+            tasks.append({'runs': runs, 'overruns': overruns, 'last_us': last_us, 'max_us': max_us})
+        cpu = _unpack('<H', payload[1 + 12 * n:])[0]
+        return {'tasks': tasks, 'cpu_pct': cpu / 10.0}
+    if msg_type == MSG_ZTO100:
+        state, t_ms, u_ms = _unpack('<BHH', payload)
+        name = ZTO_STATES[state] if state < len(ZTO_STATES) else str(state)
+        return {'state': name, 'time_s': t_ms / 1000.0, 'uncert_s': u_ms / 1000.0}
+    if msg_type in (MSG_CONFIG, MSG_CONFIG_ACK):
+        rate, mask = _unpack('<BB', payload)
+        return {'rate_hz': rate, 'mask': mask}
+    return {'raw': payload.hex()}
+
+
+def parse_mask(text):
+    """'fix,motion' / 'all' / '0x03' → 마스크"""
+    if text.lower() == 'all':
+        return MASK_ALL
+    try:
+        return int(text, 0)
+    except ValueError:
+        pass
+    mask = 0
+    for name in text.lower().split(','):
+        if name not in MASK_BITS:
+            raise argparse.ArgumentTypeError('unknown message %r (%s)' % (name, ', '.join(MASK_BITS)))
+        mask |= MASK_BITS[name]
+    return mask
+
+
+# ----------------- 연결 -----------------
+class Link:
+    """read(n) / write(b) / close() 만 있는 얇은 포장 (포트, 하위 프로세스, 파일)"""
+
+    def __init__(self, port=None, exec_cmd=None, path=None):
+        self.ser = self.proc = self.f = None
+        if port:
+            try:
+                import serial
+            except ImportError:
+                sys.exit('error: --port needs pyserial (pip install pyserial)')
+            self.ser = serial.Serial(port, 115200, timeout=0.2)   # CDC라 보율은 의미 없음
+        elif exec_cmd:
+            self.proc = subprocess.Popen(shlex.split(exec_cmd), stdin=subprocess.PIPE, stdout=subprocess.PIPE)
+        else:
+            self.f = sys.stdin.buffer if path in (None, '-') else open(path, 'rb')
+
+    def read(self, n=4096):
+        if self.ser:
+            return self.ser.read(n)
+        if self.proc:
+            return os.read(self.proc.stdout.fileno(), n)
+        return self.f.read(n)
+
+    def write(self, data):
+        if self.ser:
+            self.ser.write(data)
+        elif self.proc:
+            self.proc.stdin.write(data)
+            self.proc.stdin.flush()
+        else:
+            raise OSError('cannot send to a capture file')
+
+    def close(self):
+        if self.ser:
+            self.ser.close()
+        if self.proc:
+            self.proc.stdin.close()
+            self.proc.stdout.close()
+            self.proc.wait()
+        if self.f and self.f is not sys.stdin.buffer:
+            self.f.close()
+
+
+# ----------------- 출력 -----------------
+def format_text(msg_type, seq, fields):
+    name = MSG_NAMES.get(msg_type, '0x%02X' % msg_type)
+    if msg_type == MSG_FIX:
+        f = fields
+        t = EPOCH_2000 + datetime.timedelta(seconds=f['utc_s'], milliseconds=f['ms'])
+        return '%3d FIX    %s.%03dZ %.7f %.7f %.2fm fix%d sv %d/%d%s' % (
+            seq, t.strftime('%Y-%m-%dT%H:%M:%S'), f['ms'], f['lat_deg'], f['lon_deg'], f['hmsl_m'], f['fix_type'],
+            f['sv_used'], f['sv_visible'], '' if f['valid'] else ' (invalid)')
+    if msg_type == MSG_MOTION:
+        f = fields
+        return '%3d MOTION %.2f km/h %.1f deg%s grade %.1f%%' % (
+            seq, f['speed_kmh'], f['heading_deg'], '' if f['heading_valid'] else '?', f['grade_pct'])
+    if msg_type == MSG_TASKS:
+        runs = ' '.join('%d/%dus' % (t['runs'], t['max_us']) for t in fields['tasks'])
+        return '%3d TASKS  cpu %.1f%% %s' % (seq, fields['cpu_pct'], runs)
+    return '%3d %-6s %s' % (seq, name, json.dumps(fields, separators=(',', ':')))
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(description='Speedometer telemetry decoder')
+    ap.add_argument('capture', nargs='?', help='capture file ("-" = stdin)')
+    ap.add_argument('--port', help='serial port of the USB CDC device')
+    ap.add_argument('--exec', dest='exec_cmd', help='run a LOOPBACK stand-in and talk over its stdin/stdout')
+    ap.add_argument('--config', nargs=2, metavar=('RATE', 'MASK'),
+                    help='send CONFIG first: RATE 1-20 Hz, MASK fix,motion,trip,parser,tasks,zto100 | all | 0x3F')
+    ap.add_argument('--frames', type=int, default=0, help='stop after this many frames')
+    ap.add_argument('--seconds', type=float, default=0.0, help='stop after this many seconds')
+    ap.add_argument('--json', action='store_true', help='one JSON object per frame')
+    args = ap.parse_args(argv)
+
+    if sum(x is not None for x in (args.capture, args.port, args.exec_cmd)) > 1:
+        ap.error('give only one of capture file, --port, --exec')
+    config = None
+    if args.config:
+        try:
+            config = config_frame(int(args.config[0], 0), parse_mask(args.config[1]))
+        except (ValueError, struct.error, argparse.ArgumentTypeError) as e:
+            ap.error('--config: %s' % e)
+    link = Link(port=args.port, exec_cmd=args.exec_cmd, path=args.capture)
+    parser = Parser()
+    counts = {}
+    acked = config is None
+    t0 = time.monotonic()
+    rc = 0
+
+    try:
+        if config:
+            link.write(config)
+        while True:
+            data = link.read()
+            if not data:
+                if args.port:
+                    if args.seconds and time.monotonic() - t0 >= args.seconds:
+                        break
+                    continue
+                break
+            for msg_type, seq, payload in parser.feed(data):
+                try:
+                    fields = decode(msg_type, payload)
+                except BadPayload as e:
+                    print('warning: seq %d %s: %s' % (seq, MSG_NAMES.get(msg_type, msg_type), e), file=sys.stderr)
+                    continue
+                if msg_type == MSG_CONFIG_ACK:
+                    acked = True
+                name = MSG_NAMES.get(msg_type, '0x%02X' % msg_type)
+                counts[name] = counts.get(name, 0) + 1
+                if args.json:
+                    print(json.dumps({'seq': seq, 'type': name, **fields}, separators=(',', ':')))
+                else:
+                    print(format_text(msg_type, seq, fields))
+            if args.frames and parser.frames >= args.frames:
+                break
+            if args.seconds and time.monotonic() - t0 >= args.seconds:
+                break
+    except (KeyboardInterrupt, BrokenPipeError):
+        pass
+    finally:
+        link.close()
+
+    print('%d frames (%s), %d CRC errors, %d bytes skipped, %d frames missing (seq)' % (
+        parser.frames, ' '.join('%s %d' % kv for kv in sorted(counts.items())), parser.crc_errors,
+        parser.skipped, parser.seq_gaps), file=sys.stderr)
+    if not acked:
+        print('warning: no CONFIG_ACK', file=sys.stderr)
+        rc = 1
+    return rc
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,242 @@
+#!/usr/bin/env python3
+# track_decode.py
+#  궤적 로그 덤프(내부 플래시 Sector 7) → CSV / GPX
+#  - 포맷은 project codes/track_log.h 주석 그대로 (섹터 헤더 16 + 256바이트 블록)
+#  - 블록마다 CRC-32 확인, seq가 1씩 이어지는지 확인 → 문제는 stderr로 (출력에는 멀쩡한 블록만)
+#  - 덤프: ST-Link로 0x08060000부터 128KB (512KB 전체 덤프면 알아서 0x60000부터)
+#
+#   tools/track_decode.py track.bin                 CSV (stdout)
+#   tools/track_decode.py track.bin -f gpx -o a.gpx GPX
+#   tools/track_decode.py track.bin -f raw          플래시 단위 정수 그대로 (테스트/디버깅용)
+#   tools/track_decode.py track.bin --strict        CRC 불일치/seq 끊김이 있으면 종료 코드 1
+import argparse
+import datetime
+import struct
+import sys
+import zlib
+
+SECTOR_SIZE   = 0x20000
+SECTOR_OFFSET = 0x60000      # 전체 플래시 덤프 안에서 Sector 7 위치
+FLASH_SIZE    = 0x80000
+
+TRACK_MAGIC   = 0x314B5254   # 'TRK1'
+BLOCK_MAGIC   = 0x4254       # 'TB'
+BLOCK_VERSION = 1
+HDR_SIZE      = 16
+BLOCK_SIZE    = 256
+BLOCK_HDR     = struct.Struct('<HHIBBHI')   # magic len seq count version reserved crc
+BLOCK_COUNT   = (SECTOR_SIZE - HDR_SIZE) // BLOCK_SIZE
+PAYLOAD_MAX   = BLOCK_SIZE - BLOCK_HDR.size
+
+EPOCH_2000    = datetime.datetime(2000, 1, 1, tzinfo=datetime.timezone.utc)
+TRKSEG_GAP_S  = 120          # 점 사이가 이보다 벌어지면 GPX 새 구간 (전원/기록이 꺼져 있던 것)
+
+
+class Problem(Exception):
+    pass
+
+
+# ----------------- varint -----------------
+def get_varint(buf, pos, end):
+    v = 0
+    shift = 0
+    while True:
+        if pos >= end or shift > 28:
+            raise Problem('varint runs past the payload')
+        b = buf[pos]
+        pos += 1
+        v |= (b & 0x7F) << shift
+        if b < 0x80:
+            return v, pos
+        shift += 7
+
+
+def get_svarint(buf, pos, end):
+    v, pos = get_varint(buf, pos, end)
+    return (v >> 1) ^ -(v & 1), pos
+
+
+# ----------------- 블록 -----------------
+# 레코드: 첫 레코드는 절대값, 나머지는 앞 레코드와의 차이 (track_log.c track_encode)
+def decode_records(payload, count):
+    pts = []
+    pos = 0
+    end = len(payload)
+    t_ms = 0
+    for i in range(count):
+        if i == 0:
+            utc_s, pos = get_varint(payload, pos, end)
+            ms, pos = get_varint(payload, pos, end)
+            lat, pos = get_svarint(payload, pos, end)
+            lon, pos = get_svarint(payload, pos, end)
+            alt, pos = get_svarint(payload, pos, end)
+            spd, pos = get_varint(payload, pos, end)
+            hdg, pos = get_varint(payload, pos, end)
+            if ms > 999 or hdg > 3599:
+                raise Problem('key record out of range (ms %d heading %d)' % (ms, hdg))
+            t_ms = utc_s * 1000 + ms
+        else:
+            dt, pos = get_varint(payload, pos, end)
+            dlat, pos = get_svarint(payload, pos, end)
+            dlon, pos = get_svarint(payload, pos, end)
+            dalt, pos = get_svarint(payload, pos, end)
+            dspd, pos = get_svarint(payload, pos, end)
+            dhdg, pos = get_svarint(payload, pos, end)
+            t_ms += dt
+            lat += dlat
+            lon += dlon
+            alt += dalt
+            spd += dspd
+            hdg = (hdg + dhdg) % 3600
+        pts.append((t_ms // 1000, t_ms % 1000, lat, lon, alt, spd, hdg))
+    if pos != end:
+        raise Problem('%d bytes left after %d records' % (end - pos, count))
+    return pts
+
+
+def read_sector(data):
+    """(gen, first_seq, [(seq, points)], [문제 메시지]) — 못 읽을 섹터면 Problem"""
+    if len(data) == FLASH_SIZE:
+        data = data[SECTOR_OFFSET:SECTOR_OFFSET + SECTOR_SIZE]
+    if len(data) < HDR_SIZE:
+        raise Problem('dump is only %d bytes' % len(data))
+    if len(data) != SECTOR_SIZE:
+        print('warning: dump is %d bytes, expected %d' % (len(data), SECTOR_SIZE), file=sys.stderr)
+
+    magic, gen, gen_inv, first_seq = struct.unpack_from('<IIII', data, 0)
+    if magic == 0xFFFFFFFF and data.count(0xFF) == len(data):
+        return 0, 0, [], []
+    if magic != TRACK_MAGIC or gen_inv != (~gen & 0xFFFFFFFF):
+        raise Problem('no track log header (magic %08X gen %08X/%08X)' % (magic, gen, gen_inv))
+
+    blocks = []
+    problems = []
+    expect = first_seq
+    for i in range(BLOCK_COUNT):
+        off = HDR_SIZE + i * BLOCK_SIZE
+        if off + BLOCK_SIZE > len(data):
+            break
+        raw = data[off:off + BLOCK_SIZE]
+        if raw[0:4] == b'\xff\xff\xff\xff':
+            # 쓰인 블록은 앞에서부터 빈틈없이 → 첫 빈 블록부터 끝까지 비어 있어야 함
+            tail = data[off:HDR_SIZE + BLOCK_COUNT * BLOCK_SIZE]
+            if tail.count(0xFF) != len(tail):
+                problems.append('block %d: data after the first blank block' % i)
+            break
+
+        bmagic, blen, seq, count, version, _, crc = BLOCK_HDR.unpack_from(raw, 0)
+        where = 'block %d (seq %d)' % (i, seq)
+        if bmagic != BLOCK_MAGIC or blen > PAYLOAD_MAX:
+            problems.append('block %d: bad header (magic %04X len %d)' % (i, bmagic, blen))
+            expect += 1
+            continue
+        # 쓰는 순서가 헤더 → payload → crc 라서 crc가 비어 있으면 쓰다 만 블록
+        if crc == 0xFFFFFFFF:
+            problems.append('%s: incomplete write (no CRC)' % where)
+            expect = seq + 1
+            continue
+        calc = zlib.crc32(raw[:12] + b'\xff\xff\xff\xff' + raw[BLOCK_HDR.size:BLOCK_HDR.size + blen])
+        if calc != crc:
+            problems.append('%s: CRC %08X, stored %08X' % (where, calc, crc))
+            expect = seq + 1
+            continue
+        if version != BLOCK_VERSION:
+            problems.append('%s: unknown version %d' % (where, version))
+            expect = seq + 1
+            continue
+        if seq != expect:
+            problems.append('%s: seq gap, expected %d' % (where, expect))
+        expect = seq + 1
+
+        try:
+            pts = decode_records(raw[BLOCK_HDR.size:BLOCK_HDR.size + blen], count)
+        except Problem as e:
+            problems.append('%s: %s' % (where, e))
+            continue
+        blocks.append((seq, pts))
+    return gen, first_seq, blocks, problems
+
+
+# ----------------- 출력 -----------------
+def utc_iso(utc_s, ms):
+    t = EPOCH_2000 + datetime.timedelta(seconds=utc_s, milliseconds=ms)
+    return t.strftime('%Y-%m-%dT%H:%M:%S.') + '%03dZ' % ms
+
+
+def write_csv(out, blocks):
+    out.write('seq,time_utc,lat_deg,lon_deg,alt_m,speed_kmh,heading_deg\n')
+    for seq, pts in blocks:
+        for utc_s, ms, lat, lon, alt, spd, hdg in pts:
+            out.write('%d,%s,%.7f,%.7f,%.1f,%.2f,%.1f\n' % (
+                seq, utc_iso(utc_s, ms), lat / 1e7, lon / 1e7, alt / 10.0, spd * 0.036, hdg / 10.0))
+
+
+def write_raw(out, blocks):
+    out.write('seq,utc_s,ms,lat,lon,alt_dm,speed_cms,heading_ddeg\n')
+    for seq, pts in blocks:
+        for p in pts:
+            out.write('%d,%d,%d,%d,%d,%d,%d,%d\n' % ((seq,) + p))
+
+
+def write_gpx(out, blocks, gap_s):
+    out.write('<?xml version="1.0" encoding="UTF-8"?>\n'
+              '<gpx version="1.1" creator="track_decode.py" xmlns="http://www.topografix.com/GPX/1/1">\n'
+              '<trk><name>I SHOW SPEED track</name>\n')
+    prev = None
+    for _, pts in blocks:
+        for utc_s, ms, lat, lon, alt, spd, hdg in pts:
+            t = utc_s + ms / 1000.0
+            if prev is None or t - prev > gap_s or t < prev:
+                if prev is not None:
+                    out.write('</trkseg>\n')
+                out.write('<trkseg>\n')
+            prev = t
+            out.write('<trkpt lat="%.7f" lon="%.7f"><ele>%.1f</ele><time>%s</time>'
+                      '<extensions><speed>%.2f</speed><course>%.1f</course></extensions></trkpt>\n' % (
+                          lat / 1e7, lon / 1e7, alt / 10.0, utc_iso(utc_s, ms), spd / 100.0, hdg / 10.0))
+    if prev is not None:
+        out.write('</trkseg>\n')
+    out.write('</trk>\n</gpx>\n')
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(description='Sector 7 track log dump -> CSV / GPX')
+    ap.add_argument('dump', help='flash dump (128KB sector 7, or 512KB whole flash)')
+    ap.add_argument('-f', '--format', choices=('csv', 'gpx', 'raw'), default='csv')
+    ap.add_argument('-o', '--output', help='output file (default stdout)')
+    ap.add_argument('--gap', type=float, default=TRKSEG_GAP_S,
+                    help='GPX: start a new segment after this many seconds without points')
+    ap.add_argument('--strict', action='store_true', help='exit 1 on CRC errors or seq gaps')
+    args = ap.parse_args(argv)
+
+    with open(args.dump, 'rb') as f:
+        data = f.read()
+    try:
+        gen, first_seq, blocks, problems = read_sector(data)
+    except Problem as e:
+        print('error: %s' % e, file=sys.stderr)
+        return 2
+
+    for p in problems:
+        print('warning: %s' % p, file=sys.stderr)
+    npts = sum(len(pts) for _, pts in blocks)
+    print('gen %d, first seq %d: %d blocks, %d points, %d problems' % (
+        gen, first_seq, len(blocks), npts, len(problems)), file=sys.stderr)
+
+    out = open(args.output, 'w', newline='\n') if args.output else sys.stdout
+    try:
+        if args.format == 'gpx':
+            write_gpx(out, blocks, args.gap)
+        elif args.format == 'raw':
+            write_raw(out, blocks)
+        else:
+            write_csv(out, blocks)
+    finally:
+        if args.output:
+            out.close()
+
+    return 1 if (args.strict and problems) else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())